@@ -0,0 +1,473 @@
+/*
+ * Benchmarks for the embedded watchdog framework (POSIX)
+ * Measures the hot paths and prints one CSV record per result:
+ *   benchmark,scheduler,parameter,value,unit
+ * Compare backends with make bench SCHED=array|heap|wheel.
+ */
+
+#include "z_wdt_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#ifndef BENCH_DURATION_MS
+#define BENCH_DURATION_MS 200          // Run time of each throughput measurement
+#endif
+#define BENCH_LONG_PERIOD 600000       // Channels that never time out during a run (ms)
+#define BENCH_FEED_CHANNELS 1024
+#define BENCH_MAX_THREADS 64
+#define BENCH_PROCESS_ROUNDS 200
+#define BENCH_JITTER_CHANNELS 2000
+
+#if WATCHDOG_SCHEDULER == WATCHDOG_SCHED_ARRAY
+#define BENCH_SCHEDULER "array"
+#elif WATCHDOG_SCHEDULER == WATCHDOG_SCHED_WHEEL
+#define BENCH_SCHEDULER "wheel"
+#else
+#define BENCH_SCHEDULER "heap"
+#endif
+
+// Channels one context can hold: every shard at the handle limit, or the static table
+#ifdef WATCHDOG_STATIC_CHANNELS
+#define BENCH_CHANNEL_LIMIT WATCHDOG_MAX_CHANNELS
+#else
+#define BENCH_CHANNEL_LIMIT (WATCHDOG_TABLE_LIMIT * WATCHDOG_MAX_SHARDS)
+#endif
+
+// Per-thread state of the contended feed benchmark
+typedef struct {
+    pthread_t thread;
+    z_wdt_ctx_t *ctx;
+    int channel_id;
+    uint64_t ops;
+} bench_feeder_t;
+
+static volatile bool bench_stop;
+static pthread_barrier_t bench_barrier;
+
+static int64_t jitter_expected[BENCH_JITTER_CHANNELS];
+static int64_t jitter_samples[BENCH_JITTER_CHANNELS];
+static uint32_t jitter_fired;
+static uint32_t probe_fired;
+
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+// Nanoseconds of the monotonic clock at a tick of watchdog_get_ticks(), which counts on it
+static int64_t bench_ticks_to_ns(int64_t ticks) {
+    return ticks / WATCHDOG_TICK_HZ * 1000000000 + ticks % WATCHDOG_TICK_HZ * 1000000000 / WATCHDOG_TICK_HZ;
+}
+
+static void bench_report(const char *benchmark, const char *parameter, double value, const char *unit) {
+    printf("%s,%s,%s,%.3f,%s\n", benchmark, BENCH_SCHEDULER, parameter, value, unit);
+    fflush(stdout);
+}
+
+static void bench_noop_callback(int channel_id, void *user_data) {
+    (void)channel_id;
+    (void)user_data;
+}
+
+// Context sized for the given number of channels, spread over as few shards as fit
+static z_wdt_ctx_t *bench_create(uint32_t channels, bool external) {
+    z_wdt_config config = { .external_loop = external };
+#ifndef WATCHDOG_STATIC_CHANNELS
+    config.shards = (channels + WATCHDOG_TABLE_LIMIT - 1) / WATCHDOG_TABLE_LIMIT;
+    config.max_channels = (channels + config.shards - 1) / config.shards;
+    config.initial_channels = config.max_channels;
+#else
+    (void)channels;
+#endif
+    z_wdt_ctx_t *ctx = z_wdt_create(&config);
+    if (ctx == NULL) {
+        fprintf(stderr, "Failed to create a context for %u channels\n", channels);
+        exit(1);
+    }
+    return ctx;
+}
+
+// Add up to count long-period channels; returns how many fit
+static uint32_t bench_add_channels(z_wdt_ctx_t *ctx, int *ids, uint32_t count) {
+    uint32_t added = 0;
+    while (added < count) {
+        int id = z_wdt_ctx_add(ctx, BENCH_LONG_PERIOD, bench_noop_callback, NULL);
+        if (id < 0) {
+            break;
+        }
+        if (ids != NULL) {
+            ids[added] = id;
+        }
+        added++;
+    }
+    return added;
+}
+
+// Single-threaded feeds, one at a time and batched
+static void bench_feed(void) {
+    z_wdt_ctx_t *ctx = bench_create(BENCH_FEED_CHANNELS, true);
+    int ids[BENCH_FEED_CHANNELS];
+    uint32_t count = bench_add_channels(ctx, ids, BENCH_FEED_CHANNELS);
+    char parameter[32];
+    snprintf(parameter, sizeof(parameter), "channels=%u", count);
+
+    uint64_t ops = 0;
+    uint64_t start = bench_now_ns();
+    uint64_t elapsed;
+    do {
+        for (uint32_t i = 0; i < count; i++) {
+            z_wdt_ctx_feed(ctx, ids[i]);
+        }
+        ops += count;
+        elapsed = bench_now_ns() - start;
+    } while (elapsed < BENCH_DURATION_MS * 1000000ull);
+    bench_report("feed", parameter, (double)elapsed / (double)ops, "ns_per_op");
+
+    ops = 0;
+    start = bench_now_ns();
+    do {
+        z_wdt_ctx_feed_many(ctx, ids, count);
+        ops += count;
+        elapsed = bench_now_ns() - start;
+    } while (elapsed < BENCH_DURATION_MS * 1000000ull);
+    bench_report("feed_many", parameter, (double)elapsed / (double)ops, "ns_per_op");
+
+    z_wdt_destroy(ctx);
+}
+
+// Single-threaded feeds of adaptive channels, which sample every interval
+static void bench_feed_adaptive(void) {
+    z_wdt_ctx_t *ctx = bench_create(BENCH_FEED_CHANNELS, true);
+    int ids[BENCH_FEED_CHANNELS];
+    uint32_t count = 0;
+    while (count < BENCH_FEED_CHANNELS) {
+        int id = z_wdt_ctx_add_adaptive(ctx, BENCH_LONG_PERIOD, 1000, bench_noop_callback, NULL);
+        if (id < 0) {
+            break;
+        }
+        ids[count++] = id;
+    }
+    char parameter[32];
+    snprintf(parameter, sizeof(parameter), "channels=%u", count);
+
+    uint64_t ops = 0;
+    uint64_t start = bench_now_ns();
+    uint64_t elapsed;
+    do {
+        for (uint32_t i = 0; i < count; i++) {
+            z_wdt_ctx_feed(ctx, ids[i]);
+        }
+        ops += count;
+        elapsed = bench_now_ns() - start;
+    } while (elapsed < BENCH_DURATION_MS * 1000000ull);
+    bench_report("feed_adaptive", parameter, (double)elapsed / (double)ops, "ns_per_op");
+
+    z_wdt_destroy(ctx);
+}
+
+#ifdef Z_WDT_HAVE_STATIC_CHANNELS
+Z_WDT_DEFINE_CHANNEL(bench, BENCH_LONG_PERIOD, bench_noop_callback);
+
+// Feeds of a Z_WDT_DEFINE_CHANNEL() channel by name, then by its handle
+static void bench_feed_static(void) {
+    z_wdt_config config = { .external_loop = 1 };
+    if (z_wdt_init_ex(&config) != 0) {
+        return;
+    }
+
+    uint64_t ops = 0;
+    uint64_t start = bench_now_ns();
+    uint64_t elapsed;
+    do {
+        for (int i = 0; i < 256; i++) {
+            z_wdt_feed_static(bench);
+        }
+        ops += 256;
+        elapsed = bench_now_ns() - start;
+    } while (elapsed < BENCH_DURATION_MS * 1000000ull);
+    bench_report("feed_static", "by_name", (double)elapsed / (double)ops, "ns_per_op");
+
+    ops = 0;
+    start = bench_now_ns();
+    do {
+        for (int i = 0; i < 256; i++) {
+            z_wdt_feed(z_wdt_static_id(bench));
+        }
+        ops += 256;
+        elapsed = bench_now_ns() - start;
+    } while (elapsed < BENCH_DURATION_MS * 1000000ull);
+    bench_report("feed_static", "by_handle", (double)elapsed / (double)ops, "ns_per_op");
+
+    z_wdt_cleanup();
+}
+#endif
+
+static void bench_shm_callback(const z_wdt_shm_event *event, void *user_data) {
+    (void)event;
+    (void)user_data;
+}
+
+// Feeds of a shared-memory slot, as a supervised worker process does them
+static void bench_shm_feed(void) {
+    char name[Z_WDT_SHM_NAME_MAX];
+    snprintf(name, sizeof(name), "/z_wdt_bench_%d", (int)getpid());
+    z_wdt_shm_t *shm = z_wdt_shm_create(name, 64, bench_shm_callback, NULL);
+    if (shm == NULL) {
+        fprintf(stderr, "No shared memory, skipping shm_feed\n");
+        return;
+    }
+    int channel = z_wdt_shm_add(shm, BENCH_LONG_PERIOD, "bench");
+
+    uint64_t ops = 0;
+    uint64_t start = bench_now_ns();
+    uint64_t elapsed;
+    do {
+        for (int i = 0; i < 1024; i++) {
+            z_wdt_shm_feed(shm, channel);
+        }
+        ops += 1024;
+        elapsed = bench_now_ns() - start;
+    } while (elapsed < BENCH_DURATION_MS * 1000000ull);
+    bench_report("shm_feed", "slots=64", (double)elapsed / (double)ops, "ns_per_op");
+
+    z_wdt_shm_close(shm);
+}
+
+static void *bench_feeder(void *arg) {
+    bench_feeder_t *feeder = arg;
+    uint64_t ops = 0;
+
+    pthread_barrier_wait(&bench_barrier);
+    while (!bench_stop) {
+        for (int i = 0; i < 256; i++) {
+            z_wdt_ctx_feed(feeder->ctx, feeder->channel_id);
+        }
+        ops += 256;
+    }
+    feeder->ops = ops;
+    return NULL;
+}
+
+// Feeds from 1-64 threads, each on its own channel or all on the same one
+// (a deadline channel, or a progress channel counting per CPU)
+static void bench_feed_contended(bool shared, bool progress) {
+    static const int thread_counts[] = { 1, 2, 4, 8, 16, 32, 64 };
+    const char *name = progress ? "progress_shared" : shared ? "feed_shared" : "feed_private";
+    z_wdt_ctx_t *ctx = bench_create(BENCH_MAX_THREADS + 1, true);
+    int ids[BENCH_MAX_THREADS];
+    uint32_t count = bench_add_channels(ctx, ids, BENCH_MAX_THREADS);
+    bench_feeder_t feeders[BENCH_MAX_THREADS];
+
+    if (progress) {
+        ids[0] = z_wdt_ctx_add_progress(ctx, BENCH_LONG_PERIOD, bench_noop_callback, NULL);
+        shared = true;
+    }
+
+    for (size_t n = 0; n < sizeof(thread_counts) / sizeof(thread_counts[0]); n++) {
+        int threads = thread_counts[n];
+        bench_stop = false;
+        pthread_barrier_init(&bench_barrier, NULL, (unsigned)threads + 1);
+        for (int t = 0; t < threads; t++) {
+            feeders[t].ctx = ctx;
+            feeders[t].channel_id = ids[shared ? 0 : (uint32_t)t % count];
+            pthread_create(&feeders[t].thread, NULL, bench_feeder, &feeders[t]);
+        }
+
+        pthread_barrier_wait(&bench_barrier);
+        uint64_t start = bench_now_ns();
+        usleep(BENCH_DURATION_MS * 1000);
+        bench_stop = true;
+        uint64_t ops = 0;
+        for (int t = 0; t < threads; t++) {
+            pthread_join(feeders[t].thread, NULL);
+            ops += feeders[t].ops;
+        }
+        uint64_t elapsed = bench_now_ns() - start;
+        pthread_barrier_destroy(&bench_barrier);
+
+        char parameter[32];
+        snprintf(parameter, sizeof(parameter), "threads=%d", threads);
+        bench_report(name, parameter, (double)elapsed * threads / (double)ops, "ns_per_op");
+        bench_report(name, parameter, (double)ops * 1000.0 / (double)elapsed, "mops");
+    }
+
+    z_wdt_destroy(ctx);
+}
+
+// Add/delete pairs next to a resident population
+static void bench_churn(void) {
+    static const uint32_t residents[] = { 0, 1000, 100000 };
+
+    for (size_t n = 0; n < sizeof(residents) / sizeof(residents[0]); n++) {
+        if (residents[n] + 1 > BENCH_CHANNEL_LIMIT) {
+            break;
+        }
+        z_wdt_ctx_t *ctx = bench_create(residents[n] + 1, true);
+        uint32_t resident = bench_add_channels(ctx, NULL, residents[n]);
+
+        uint64_t ops = 0;
+        uint64_t start = bench_now_ns();
+        uint64_t elapsed;
+        do {
+            for (int i = 0; i < 256; i++) {
+                z_wdt_ctx_delete(ctx, z_wdt_ctx_add(ctx, BENCH_LONG_PERIOD, bench_noop_callback, NULL));
+            }
+            ops += 256;
+            elapsed = bench_now_ns() - start;
+        } while (elapsed < BENCH_DURATION_MS * 1000000ull);
+
+        char parameter[32];
+        snprintf(parameter, sizeof(parameter), "resident=%u", resident);
+        bench_report("churn", parameter, (double)elapsed / (double)ops, "ns_per_add_delete");
+        z_wdt_destroy(ctx);
+    }
+}
+
+static void bench_probe_callback(int channel_id, void *user_data) {
+    (void)channel_id;
+    (void)user_data;
+    probe_fired++;
+}
+
+// Cost of a processing pass that expires one probe channel among many
+static void bench_process(void) {
+    static const uint32_t counts[] = { 16, 1000, 10000, 100000, 1000000 };
+
+    for (size_t n = 0; n < sizeof(counts) / sizeof(counts[0]); n++) {
+        if (counts[n] > BENCH_CHANNEL_LIMIT) {
+            break;
+        }
+        z_wdt_ctx_t *ctx = bench_create(counts[n], true);
+        uint32_t count = bench_add_channels(ctx, NULL, counts[n] - 1);
+
+        // The wheel publishes lower bounds, so some passes find nothing due
+        uint64_t total = 0;
+        uint32_t passes = 0;
+        probe_fired = 0;
+        for (uint32_t round = 0; round < BENCH_PROCESS_ROUNDS; round++) {
+            if (z_wdt_ctx_add(ctx, 1, bench_probe_callback, NULL) < 0) {
+                break;
+            }
+            uint32_t fired = probe_fired;
+            while (probe_fired == fired) {
+                while (z_wdt_now() < z_wdt_ctx_next_deadline(ctx)) {
+                }
+                uint64_t start = bench_now_ns();
+                z_wdt_ctx_process(ctx);
+                total += bench_now_ns() - start;
+                passes++;
+            }
+        }
+
+        char parameter[32];
+        snprintf(parameter, sizeof(parameter), "channels=%u", count + 1);
+        bench_report("process", parameter, passes ? (double)total / passes : 0.0, "ns_per_pass");
+        z_wdt_destroy(ctx);
+    }
+}
+
+// One suspend/resume cycle, the wake path of a sleeping system, with many channels
+static void bench_resume(void) {
+    static const uint32_t counts[] = { 16, 10000, 1000000 };
+
+    for (size_t n = 0; n < sizeof(counts) / sizeof(counts[0]); n++) {
+        if (counts[n] > BENCH_CHANNEL_LIMIT) {
+            break;
+        }
+        z_wdt_ctx_t *ctx = bench_create(counts[n], true);
+        uint32_t count = bench_add_channels(ctx, NULL, counts[n]);
+
+        uint64_t ops = 0;
+        uint64_t start = bench_now_ns();
+        uint64_t elapsed;
+        do {
+            z_wdt_ctx_suspend(ctx);
+            z_wdt_ctx_resume(ctx);
+            ops++;
+            elapsed = bench_now_ns() - start;
+        } while (elapsed < BENCH_DURATION_MS * 1000000ull);
+
+        char parameter[32];
+        snprintf(parameter, sizeof(parameter), "channels=%u", count);
+        bench_report("resume", parameter, (double)elapsed / (double)ops, "ns_per_op");
+        z_wdt_destroy(ctx);
+    }
+}
+
+static void bench_jitter_callback(int channel_id, void *user_data) {
+    (void)channel_id;
+    uint32_t index = (uint32_t)(uintptr_t)user_data;
+    jitter_samples[index] = (int64_t)bench_now_ns() - __atomic_load_n(&jitter_expected[index], __ATOMIC_ACQUIRE);
+    __atomic_fetch_add(&jitter_fired, 1, __ATOMIC_RELEASE);
+}
+
+static int bench_compare(const void *a, const void *b) {
+    int64_t x = *(const int64_t *)a;
+    int64_t y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Lateness of timeouts on the timer thread, against the deadline tick the
+// core computed when each channel was added
+static void bench_jitter(void) {
+    uint32_t count = BENCH_JITTER_CHANNELS < BENCH_CHANNEL_LIMIT ? BENCH_JITTER_CHANNELS : BENCH_CHANNEL_LIMIT;
+    z_wdt_ctx_t *ctx = bench_create(count, false);
+
+    jitter_fired = 0;
+    uint32_t added = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t period = 20 + i * 7 % 500;
+        if (z_wdt_ctx_add(ctx, period, bench_jitter_callback, (void *)(uintptr_t)i) < 0) {
+            break;
+        }
+        // The deadline tick as the core computes it, long before the shortest period ends
+        __atomic_store_n(&jitter_expected[i], bench_ticks_to_ns(z_wdt_now() + watchdog_ms_to_ticks(period)),
+                         __ATOMIC_RELEASE);
+        added++;
+    }
+
+    uint64_t give_up = bench_now_ns() + 2000000000ull;
+    while (__atomic_load_n(&jitter_fired, __ATOMIC_ACQUIRE) < added && bench_now_ns() < give_up) {
+        usleep(10000);
+    }
+    z_wdt_destroy(ctx);
+
+    uint32_t samples = __atomic_load_n(&jitter_fired, __ATOMIC_ACQUIRE);
+    qsort(jitter_samples, samples, sizeof(jitter_samples[0]), bench_compare);
+
+    static const struct { const char *name; double quantile; } percentiles[] = {
+        { "p50", 0.50 }, { "p90", 0.90 }, { "p99", 0.99 }, { "p999", 0.999 }, { "max", 1.0 },
+    };
+    for (size_t i = 0; i < sizeof(percentiles) / sizeof(percentiles[0]) && samples > 0; i++) {
+        uint32_t rank = (uint32_t)(percentiles[i].quantile * (samples - 1) + 0.5);
+        bench_report("jitter", percentiles[i].name, (double)jitter_samples[rank] / 1000.0, "us");
+    }
+    bench_report("jitter", "missed", (double)(added - samples), "timeouts");
+}
+
+int main(void) {
+    printf("benchmark,scheduler,parameter,value,unit\n");
+
+    bench_feed();
+    bench_feed_adaptive();
+#ifdef Z_WDT_HAVE_STATIC_CHANNELS
+    bench_feed_static();
+#endif
+    bench_shm_feed();
+    bench_feed_contended(false, false);
+    bench_feed_contended(true, false);
+    bench_feed_contended(true, true);
+    bench_churn();
+    bench_process();
+    bench_resume();
+    bench_jitter();
+
+    z_wdt_cleanup();
+    return 0;
+}
@@ -0,0 +1,187 @@
+/*
+ * Virtual-time tests for the C++ interface (z_wdt.hpp)
+ * Linked against the mock platform like watchdog_sim_test.c, so timeouts
+ * are checked to the tick.
+ */
+
+#include "z_wdt.hpp"
+#include "watchdog_os_mock.h"
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <utility>
+
+using namespace std::chrono_literals;
+
+// Reload period in ticks, as the core rounds it
+static int64_t cpp_ticks(uint32_t ms) {
+    return (static_cast<int64_t>(ms) * WATCHDOG_TICK_HZ + 999) / 1000;
+}
+
+// Counts the copies of a callback's captured state that are still alive
+struct Tracked {
+    static int alive;
+
+    Tracked() { alive++; }
+    Tracked(const Tracked &) { alive++; }
+    Tracked(Tracked &&) noexcept { alive++; }
+    ~Tracked() { alive--; }
+};
+
+int Tracked::alive = 0;
+
+// Test that a lambda with captured state fires on the exact tick and that feeds defer it
+void test_cpp_timeout_and_feed() {
+    printf("\n=== Testing Channel Timeout and Feed ===\n");
+
+    assert(z_wdt_init() == 0);
+    int fired = 0;
+    int fired_id = -1;
+    int64_t fired_at = 0;
+    z_wdt::Channel channel(100ms, [&](int channel_id) {
+        fired++;
+        fired_id = channel_id;
+        fired_at = z_wdt_now();
+    });
+    assert(channel && channel.id() >= 0);
+
+    // Inline feeds keep it alive; the timeout follows the last one
+    for (int i = 0; i < 10; i++) {
+        watchdog_mock_advance(cpp_ticks(100) - 1);
+        assert(channel.feed() == 0);
+    }
+    assert(fired == 0);
+
+    int64_t fed_at = z_wdt_now();
+    watchdog_mock_advance(cpp_ticks(100));
+    assert(fired == 1 && fired_id == channel.id() && fired_at == fed_at + cpp_ticks(100));
+    assert(channel.feed() == -1);
+
+    // A callable without arguments, and a period rounded up to whole milliseconds
+    int plain = 0;
+    z_wdt::Channel rounded(1500us, [&plain] { plain++; });
+    assert(rounded);
+    watchdog_mock_advance(cpp_ticks(2) - 1);
+    assert(plain == 0);
+    watchdog_mock_advance(1);
+    assert(plain == 1);
+
+    z_wdt::Channel invalid(0ms, [] {});
+    assert(!invalid && invalid.id() == -1 && invalid.feed() == -1);
+
+    rounded.reset();
+    channel.reset();
+    z_wdt_cleanup();
+    printf("✓ Lambda fired on its exact tick, feeds deferred it, periods round up\n");
+}
+
+// Test that destroying or resetting a Channel deletes it and frees its callback once
+void test_cpp_lifetime() {
+    printf("\n=== Testing Channel Lifetime ===\n");
+
+    assert(z_wdt_init() == 0);
+    int fired = 0;
+    int id;
+    {
+        Tracked state;
+        z_wdt::Channel channel(50ms, [&fired, state](int) { fired++; });
+        id = channel.id();
+        assert(Tracked::alive == 2);
+    }
+    assert(Tracked::alive == 0);
+    assert(z_wdt_feed(id) == -1);
+    watchdog_mock_advance(cpp_ticks(100));
+    assert(fired == 0);
+
+    // After a timeout the callback holder goes with the Channel, not before
+    {
+        z_wdt::Channel channel(50ms, [&fired, state = Tracked()](int) { fired++; });
+        watchdog_mock_advance(cpp_ticks(50));
+        assert(fired == 1 && Tracked::alive == 1);
+    }
+    assert(Tracked::alive == 0);
+
+    z_wdt_cleanup();
+    printf("✓ Destruction deleted the channel, captured state freed exactly once\n");
+}
+
+// Test that moves transfer ownership and leave the source empty
+void test_cpp_move() {
+    printf("\n=== Testing Channel Moves ===\n");
+
+    assert(z_wdt_init() == 0);
+    int fired = 0;
+    z_wdt::Channel first(100ms, [&fired] { fired++; });
+    int id = first.id();
+
+    z_wdt::Channel second(std::move(first));
+    assert(!first && first.feed() == -1);
+    assert(second && second.id() == id);
+
+    z_wdt::Channel third(200ms, [&fired] { fired += 10; });
+    int replaced = third.id();
+    third = std::move(second);
+    assert(third.id() == id && z_wdt_feed(replaced) == -1);
+
+    watchdog_mock_advance(cpp_ticks(100) - 1);
+    assert(third.feed() == 0);
+    watchdog_mock_advance(cpp_ticks(100) - 1);
+    assert(fired == 0);
+    watchdog_mock_advance(1);
+    assert(fired == 1);
+
+    third.reset();
+    z_wdt_cleanup();
+    printf("✓ Moves kept the channel, replaced channels were deleted\n");
+}
+
+// Test that the inline feed honours channel suspension, on a created context
+void test_cpp_context() {
+    printf("\n=== Testing Channels on a Created Context ===\n");
+
+    z_wdt_config config = {};
+    config.external_loop = 1;
+    z_wdt_ctx_t *ctx = z_wdt_create(&config);
+    assert(ctx != nullptr);
+
+    int fired = 0;
+    z_wdt::Channel channel(100ms, [&fired] { fired++; }, ctx);
+    assert(channel);
+
+    // A suspended channel ignores feeds; after the resume they count again
+    assert(z_wdt_ctx_channel_suspend(ctx, channel.id()) == 0);
+    assert(channel.feed() == 0);
+    watchdog_mock_set_ticks(z_wdt_now() + cpp_ticks(500));
+    z_wdt_ctx_process(ctx);
+    assert(fired == 0);
+    assert(z_wdt_ctx_channel_resume(ctx, channel.id()) == 0);
+
+    int64_t fed_at = z_wdt_now() + cpp_ticks(50);
+    watchdog_mock_set_ticks(fed_at);
+    assert(channel.feed() == 0);
+    assert(z_wdt_ctx_next_deadline(ctx) <= fed_at + cpp_ticks(100));
+    watchdog_mock_set_ticks(fed_at + cpp_ticks(100) - 1);
+    z_wdt_ctx_process(ctx);
+    assert(fired == 0);
+    watchdog_mock_set_ticks(fed_at + cpp_ticks(100));
+    z_wdt_ctx_process(ctx);
+    assert(fired == 1);
+
+    channel.reset();
+    z_wdt_destroy(ctx);
+    printf("✓ Inline feeds honoured suspension on a created context\n");
+}
+
+int main() {
+    printf("Embedded Watchdog Framework C++ Interface Test Suite\n");
+    printf("====================================================\n");
+
+    test_cpp_timeout_and_feed();
+    test_cpp_lifetime();
+    test_cpp_move();
+    test_cpp_context();
+
+    printf("\n=== Test Results ===\n");
+    printf("✓ All tests passed!\n");
+    return 0;
+}
@@ -18,48 +18,293 @@
 #else
     #include <unistd.h>
     #include <sys/time.h>
+    #include <time.h>
     #include <pthread.h>
+    #include <sched.h>
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <signal.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#ifdef __linux__
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <sys/timerfd.h>
+    #include <linux/futex.h>
+    #include <linux/watchdog.h>
 #endif
+#endif
+
+/*
+ * Tick source (select with -DWATCHDOG_CLOCK=...). Ticks run at
+ * WATCHDOG_TICK_HZ; timeouts are accurate to the source's resolution.
+ */
+#define WATCHDOG_CLOCK_MONOTONIC 0     // CLOCK_MONOTONIC / QueryPerformanceCounter
+#define WATCHDOG_CLOCK_COARSE    1     // CLOCK_MONOTONIC_COARSE / GetTickCount64, kernel tick resolution
+#define WATCHDOG_CLOCK_TSC       2     // rdtsc / cntvct_el0, calibrated in watchdog_os_init()
+#define WATCHDOG_CLOCK_CACHED    3     // Tick word the timer thread refreshes; feeds do one load
 
-// Threading variables
+#ifndef WATCHDOG_CLOCK
+#define WATCHDOG_CLOCK WATCHDOG_CLOCK_MONOTONIC
+#endif
+
+// Real-time priority of a context's critical thread without critical_priority
+#ifndef WATCHDOG_CRITICAL_PRIORITY
+#define WATCHDOG_CRITICAL_PRIORITY 80
+#endif
+
+// Lock the process's memory while a critical thread runs, so its expiry
+// pass never waits on a page fault (0 leaves paging alone)
+#ifndef WATCHDOG_CRITICAL_MLOCK
+#define WATCHDOG_CRITICAL_MLOCK 1
+#endif
+
+#ifndef WATCHDOG_CLOCK_CACHE_PERIOD
+#define WATCHDOG_CLOCK_CACHE_PERIOD (WATCHDOG_TICK_HZ >= 1000 ? WATCHDOG_TICK_HZ / 1000 : 1)  // Refresh interval in ticks (1 ms)
+#endif
+
+#if WATCHDOG_CLOCK == WATCHDOG_CLOCK_TSC && !defined(__x86_64__) && !defined(__i386__) && !defined(__aarch64__)
+#error "WATCHDOG_CLOCK_TSC needs an x86 or AArch64 cycle counter"
+#endif
+#if WATCHDOG_CLOCK == WATCHDOG_CLOCK_COARSE && !defined(_WIN32) && !defined(CLOCK_MONOTONIC_COARSE)
+#define CLOCK_MONOTONIC_COARSE CLOCK_MONOTONIC
+#endif
+
+// Timer object: one thread per context, sleeping until its armed deadline,
+// plus one for the critical shard of contexts that have one. An external
+// timer has no thread and arms a timerfd for the application's loop.
+struct watchdog_timer {
+    z_wdt_ctx_t *ctx;                  // Context the thread processes
+    bool external;                     // No thread; the application calls z_wdt_ctx_process()
+    bool critical;                     // Runs z_wdt_ctx_process_critical() instead
+    int fd;                            // timerfd of an external timer (-1 if none)
 #ifdef _WIN32
-static HANDLE timer_thread;
-static bool timer_thread_running = false;
-static CRITICAL_SECTION watchdog_mutex;
+    HANDLE thread;
+    CRITICAL_SECTION lock;
+    CONDITION_VARIABLE cond;
+#else
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+#endif
+    int64_t deadline;                  // Absolute deadline (protected by lock)
+    bool running;
+};
+
+// Extra wait so a lagging coarse clock has passed the deadline on wakeup
+static int64_t timer_slack_ns = 0;
+
+#if WATCHDOG_CLOCK == WATCHDOG_CLOCK_TSC
+static bool tsc_calibrated = false;
+static uint64_t tsc_base;              // Counter value at calibration
+static int64_t tsc_base_ticks;         // Ticks at calibration
+static double tsc_ticks_per_count;
+#elif WATCHDOG_CLOCK == WATCHDOG_CLOCK_CACHED
+static int64_t cached_ticks;           // Refreshed by the timer threads, read relaxed
+static uint32_t cached_refreshers;     // Timer threads keeping cached_ticks current
+#endif
+
+// Hardware watchdog device (Linux watchdog driver API)
+#ifndef WATCHDOG_HW_DEVICE
+#define WATCHDOG_HW_DEVICE "/dev/watchdog"
+#endif
+#ifdef __linux__
+static int hw_fd = -1;
+#endif
+
+// Critical threads keeping the process's memory locked (atomic)
+static uint32_t critical_lockers = 0;
+
+// Log thread draining the core's record ring
+#ifdef _WIN32
+static HANDLE log_thread;
+static CRITICAL_SECTION log_lock;
+static CONDITION_VARIABLE log_cond;
+#else
+static pthread_t log_thread;
+static pthread_mutex_t log_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t log_cond = PTHREAD_COND_INITIALIZER;
+#endif
+static bool log_thread_running = false;
+static bool log_signalled = false;
+
+// Callback dispatch pool: a bounded job ring served by worker threads
+#define DISPATCH_QUEUE_SIZE 64
+
+struct dispatch_job {
+    watchdog_callback_t callback;
+    int channel_id;
+    void *user_data;
+};
+
+struct watchdog_dispatch_pool {
+    struct dispatch_job queue[DISPATCH_QUEUE_SIZE];
+    uint32_t head;                     // Next job to run
+    uint32_t count;                    // Queued jobs
+    uint32_t worker_count;
+    bool running;
+#ifdef _WIN32
+    HANDLE *workers;
+    CRITICAL_SECTION lock;
+    CONDITION_VARIABLE cond;
+#else
+    pthread_t *workers;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+#endif
+};
+
+void watchdog_dispatch_destroy(void *handle);
+static void timer_lock_acquire(struct watchdog_timer *timer);
+static void timer_lock_release(struct watchdog_timer *timer);
+static void timer_signal(struct watchdog_timer *timer);
+static void timer_fd_arm(struct watchdog_timer *timer, int64_t deadline);
+static void timer_release_refresher(void);
+static void timer_release_critical(void);
+
+// Read the selected system clock in ticks (the cached source reads CLOCK_MONOTONIC)
+static int64_t clock_read(void) {
+#ifdef _WIN32
+#if WATCHDOG_CLOCK == WATCHDOG_CLOCK_COARSE
+    return (int64_t)GetTickCount64() * WATCHDOG_TICK_HZ / 1000;
+#else
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return counter.QuadPart / frequency.QuadPart * WATCHDOG_TICK_HZ +
+           counter.QuadPart % frequency.QuadPart * WATCHDOG_TICK_HZ / frequency.QuadPart;
+#endif
+#else
+    struct timespec ts;
+#if WATCHDOG_CLOCK == WATCHDOG_CLOCK_COARSE
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+    return (int64_t)ts.tv_sec * WATCHDOG_TICK_HZ + (int64_t)ts.tv_nsec * WATCHDOG_TICK_HZ / 1000000000;
+#endif
+}
+
+#if WATCHDOG_CLOCK == WATCHDOG_CLOCK_TSC
+static uint64_t tsc_read(void) {
+#if defined(__aarch64__)
+    uint64_t count;
+    __asm__ __volatile__("isb; mrs %0, cntvct_el0" : "=r"(count));
+    return count;
+#else
+    return __builtin_ia32_rdtsc();
+#endif
+}
+
+// Map the cycle counter onto the clock; AArch64 reports its frequency
+static void tsc_calibrate(void) {
+#if defined(__aarch64__)
+    uint64_t frequency;
+    __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(frequency));
+    tsc_base_ticks = clock_read();
+    tsc_base = tsc_read();
+    tsc_ticks_per_count = (double)WATCHDOG_TICK_HZ / (double)frequency;
 #else
-static pthread_t timer_thread;
-static bool timer_thread_running = false;
-static pthread_mutex_t watchdog_mutex = PTHREAD_MUTEX_INITIALIZER;
+    struct timespec start, end, pause = { 0, 10000000 };
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    uint64_t start_count = tsc_read();
+    nanosleep(&pause, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    uint64_t end_count = tsc_read();
+    
+    double elapsed_ns = (double)(end.tv_sec - start.tv_sec) * 1e9 + (double)(end.tv_nsec - start.tv_nsec);
+    tsc_ticks_per_count = elapsed_ns * WATCHDOG_TICK_HZ / 1e9 / (double)(end_count - start_count);
+    tsc_base = end_count;
+    tsc_base_ticks = (int64_t)end.tv_sec * WATCHDOG_TICK_HZ + (int64_t)end.tv_nsec * WATCHDOG_TICK_HZ / 1000000000;
+#endif
+    tsc_calibrated = true;
+}
 #endif
 
 // Platform abstraction implementation
 int64_t watchdog_get_ticks(void) {
+#if WATCHDOG_CLOCK == WATCHDOG_CLOCK_TSC
+    if (!tsc_calibrated) {
+        return clock_read();
+    }
+    return tsc_base_ticks + (int64_t)((double)(tsc_read() - tsc_base) * tsc_ticks_per_count);
+#elif WATCHDOG_CLOCK == WATCHDOG_CLOCK_CACHED
+    int64_t ticks = __atomic_load_n(&cached_ticks, __ATOMIC_RELAXED);
+    return ticks != 0 ? ticks : clock_read();
+#else
+    return clock_read();
+#endif
+}
+
+// Nanosecond clock for instrumentation, independent of the tick source
+uint64_t watchdog_get_ns(void) {
 #ifdef _WIN32
-    return GetTickCount64();
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)(counter.QuadPart / frequency.QuadPart * 1000000000 +
+                      counter.QuadPart % frequency.QuadPart * 1000000000 / frequency.QuadPart);
 #else
     struct timespec ts;
     clock_gettime(CLOCK_MONOTONIC, &ts);
-    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000; // Convert to milliseconds
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
 #endif
 }
 
-void watchdog_timer_start(int64_t timeout_ticks) {
-    // Timer is handled by the timer thread
-    (void)timeout_ticks;
+// Arm a context's timer thread for an absolute deadline. Only a deadline
+// earlier than the currently armed one needs to wake the thread; a later
+// one is picked up when the thread re-checks after its current wait.
+void watchdog_timer_start(void *handle, int64_t timeout_ticks) {
+    struct watchdog_timer *timer = handle;
+    
+    timer_lock_acquire(timer);
+    bool earlier = timeout_ticks < timer->deadline;
+    timer->deadline = timeout_ticks;
+    if (timer->external) {
+        timer_fd_arm(timer, timeout_ticks);
+    } else if (earlier) {
+        timer_signal(timer);
+    }
+    timer_lock_release(timer);
+}
+
+void watchdog_timer_stop(void *handle) {
+    struct watchdog_timer *timer = handle;
+    
+    timer_lock_acquire(timer);
+    timer->deadline = INT64_MAX;
+    if (timer->external) {
+        timer_fd_arm(timer, INT64_MAX);
+    }
+    timer_lock_release(timer);
 }
 
-void watchdog_timer_stop(void) {
-    // Timer is handled by the timer thread
+// Descriptor that becomes readable at an external timer's deadline
+int watchdog_timer_fd(void *handle) {
+    struct watchdog_timer *timer = handle;
+    return timer->fd;
 }
 
 void watchdog_log(const char *level, const char *format, ...) {
     va_list args;
     va_start(args, format);
     
+    // Callbacks log from other threads, so use the reentrant localtime
     time_t now = time(NULL);
-    struct tm *tm_info = localtime(&now);
+    struct tm tm_info;
+#ifdef _WIN32
+    localtime_s(&tm_info, &now);
+#else
+    localtime_r(&now, &tm_info);
+#endif
     char timestamp[64];
-    strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", tm_info);
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", &tm_info);
     
     printf("[%s] [%s] ", timestamp, level);
     vprintf(format, args);
@@ -68,57 +313,460 @@ void watchdog_log(const char *level, const char *format, ...) {
     va_end(args);
 }
 
-// Timer thread function
+// Wake the log thread to drain queued records
+void watchdog_log_wake(void) {
 #ifdef _WIN32
-static DWORD WINAPI timer_thread_func(LPVOID arg) {
+    EnterCriticalSection(&log_lock);
+    log_signalled = true;
+    WakeConditionVariable(&log_cond);
+    LeaveCriticalSection(&log_lock);
+#else
+    pthread_mutex_lock(&log_lock);
+    log_signalled = true;
+    pthread_cond_signal(&log_cond);
+    pthread_mutex_unlock(&log_lock);
+#endif
+}
+
+// Log thread function: drain whenever woken, and once more on exit
+static void log_thread_loop(void) {
+#ifdef _WIN32
+    EnterCriticalSection(&log_lock);
+    while (log_thread_running) {
+        while (!log_signalled && log_thread_running) {
+            SleepConditionVariableCS(&log_cond, &log_lock, INFINITE);
+        }
+        log_signalled = false;
+        LeaveCriticalSection(&log_lock);
+        z_wdt_log_drain();
+        EnterCriticalSection(&log_lock);
+    }
+    LeaveCriticalSection(&log_lock);
+#else
+    pthread_mutex_lock(&log_lock);
+    while (log_thread_running) {
+        while (!log_signalled && log_thread_running) {
+            pthread_cond_wait(&log_cond, &log_lock);
+        }
+        log_signalled = false;
+        pthread_mutex_unlock(&log_lock);
+        z_wdt_log_drain();
+        pthread_mutex_lock(&log_lock);
+    }
+    pthread_mutex_unlock(&log_lock);
+#endif
+    
+    z_wdt_log_drain();
+}
+
+#ifdef _WIN32
+static DWORD WINAPI log_thread_func(LPVOID arg) {
+    (void)arg;
+    log_thread_loop();
+    return 0;
+}
+#else
+static void* log_thread_func(void *arg) {
     (void)arg;
+    log_thread_loop();
+    return NULL;
+}
+#endif
+
+// Timer lock helpers
+static void timer_lock_acquire(struct watchdog_timer *timer) {
+#ifdef _WIN32
+    EnterCriticalSection(&timer->lock);
+#else
+    pthread_mutex_lock(&timer->lock);
+#endif
+}
+
+static void timer_lock_release(struct watchdog_timer *timer) {
+#ifdef _WIN32
+    LeaveCriticalSection(&timer->lock);
+#else
+    pthread_mutex_unlock(&timer->lock);
+#endif
+}
+
+static void timer_signal(struct watchdog_timer *timer) {
+#ifdef _WIN32
+    WakeConditionVariable(&timer->cond);
+#else
+    pthread_cond_signal(&timer->cond);
+#endif
+}
+
+// Block on the timer condition until the armed deadline or a signal (lock held).
+// The wait is relative to the tick source, so any source maps onto the
+// condition variable's clock.
+static void timer_wait(struct watchdog_timer *timer, int64_t deadline) {
+#if WATCHDOG_CLOCK == WATCHDOG_CLOCK_CACHED
+    // Wake at least once per refresh period to keep the tick word current
+    int64_t refresh = watchdog_get_ticks() + WATCHDOG_CLOCK_CACHE_PERIOD;
+    if (refresh < deadline) {
+        deadline = refresh;
+    }
+#endif
     
-    while (timer_thread_running) {
-        EnterCriticalSection(&watchdog_mutex);
-        z_wdt_process();
-        LeaveCriticalSection(&watchdog_mutex);
+#ifdef _WIN32
+    DWORD timeout_ms = INFINITE;
+    if (deadline != INT64_MAX) {
+        int64_t remaining = (deadline - watchdog_get_ticks()) * 1000;
+        remaining = (remaining + WATCHDOG_TICK_HZ - 1) / WATCHDOG_TICK_HZ + timer_slack_ns / 1000000;
+        timeout_ms = remaining <= 0 ? 0 :
+                     remaining >= (int64_t)INFINITE ? INFINITE - 1 : (DWORD)remaining;
+    }
+    SleepConditionVariableCS(&timer->cond, &timer->lock, timeout_ms);
+#else
+    if (deadline == INT64_MAX) {
+        pthread_cond_wait(&timer->cond, &timer->lock);
+    } else {
+        int64_t remaining = deadline - watchdog_get_ticks();
+        if (remaining < 0) {
+            remaining = 0;
+        }
         
-        // Sleep for 100ms
-        Sleep(100);
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        int64_t nsec = ts.tv_nsec + timer_slack_ns +
+                       remaining % WATCHDOG_TICK_HZ * 1000000000 / WATCHDOG_TICK_HZ;
+        ts.tv_sec += (time_t)(remaining / WATCHDOG_TICK_HZ + nsec / 1000000000);
+        ts.tv_nsec = (long)(nsec % 1000000000);
+        pthread_cond_timedwait(&timer->cond, &timer->lock, &ts);
+    }
+#endif
+}
+
+// Set an external timer's timerfd to expire at the deadline (relative to the
+// tick source, like timer_wait()). Re-arming also clears a pending expiry,
+// so the descriptor stops being readable once z_wdt_ctx_process() re-arms.
+static void timer_fd_arm(struct watchdog_timer *timer, int64_t deadline) {
+#ifdef __linux__
+    if (timer->fd < 0) {
+        return;
+    }
+    
+    struct itimerspec spec = { { 0, 0 }, { 0, 0 } };
+    if (deadline != INT64_MAX) {
+        int64_t remaining = deadline - watchdog_get_ticks();
+        int64_t nsec = 1;              // Already due: expire at once (0 would disarm)
+        if (remaining > 0) {
+            nsec = remaining / WATCHDOG_TICK_HZ * 1000000000 +
+                   remaining % WATCHDOG_TICK_HZ * 1000000000 / WATCHDOG_TICK_HZ + timer_slack_ns;
+        }
+        spec.it_value.tv_sec = (time_t)(nsec / 1000000000);
+        spec.it_value.tv_nsec = (long)(nsec % 1000000000);
     }
+    timerfd_settime(timer->fd, 0, &spec, NULL);
+#else
+    (void)timer;
+    (void)deadline;
+#endif
+}
+
+// Timer thread function: sleep until the earliest deadline, then process
+static void timer_thread_loop(struct watchdog_timer *timer) {
+    timer_lock_acquire(timer);
     
+    while (timer->running) {
+#if WATCHDOG_CLOCK == WATCHDOG_CLOCK_CACHED
+        __atomic_store_n(&cached_ticks, clock_read(), __ATOMIC_RELAXED);
+#endif
+        int64_t deadline = timer->deadline;
+        
+        if (deadline != INT64_MAX && deadline <= watchdog_get_ticks()) {
+            // Consume the deadline; z_wdt_ctx_process() re-arms the next one
+            timer->deadline = INT64_MAX;
+            timer_lock_release(timer);
+            
+            if (timer->critical) {
+                z_wdt_ctx_process_critical(timer->ctx);
+            } else {
+                z_wdt_ctx_process(timer->ctx);
+            }
+            
+            timer_lock_acquire(timer);
+            continue;
+        }
+        
+        timer_wait(timer, deadline);
+    }
+    
+    timer_lock_release(timer);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI timer_thread_func(LPVOID arg) {
+    timer_thread_loop(arg);
     return 0;
 }
 #else
 static void* timer_thread_func(void *arg) {
-    (void)arg;
+    timer_thread_loop(arg);
+    return NULL;
+}
+#endif
+
+// Set up an external timer: just the lock and, on Linux, a timerfd
+static void *timer_create_external(struct watchdog_timer *timer) {
+    timer->external = true;
+    timer->fd = -1;
+#ifdef _WIN32
+    InitializeCriticalSection(&timer->lock);
+#else
+    pthread_mutex_init(&timer->lock, NULL);
+#ifdef __linux__
+    timer->fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timer->fd < 0) {
+        watchdog_log("ERROR", "Failed to create timerfd");
+        pthread_mutex_destroy(&timer->lock);
+        free(timer);
+        return NULL;
+    }
+#endif
+#endif
+    return timer;
+}
+
+#ifndef _WIN32
+// Thread attributes for a timer: SCHED_FIFO at a positive priority, and
+// the CPUs of a non-zero mask (Linux only)
+static void timer_thread_attr(pthread_attr_t *attr, int priority, uint64_t cpus) {
+    pthread_attr_init(attr);
+    if (priority > 0) {
+        struct sched_param param = { .sched_priority = priority };
+        pthread_attr_setinheritsched(attr, PTHREAD_EXPLICIT_SCHED);
+        pthread_attr_setschedpolicy(attr, SCHED_FIFO);
+        pthread_attr_setschedparam(attr, &param);
+    }
+#ifdef __linux__
+    if (cpus != 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; cpu++) {
+            if (cpus & ((uint64_t)1 << cpu)) {
+                CPU_SET(cpu, &set);
+            }
+        }
+        pthread_attr_setaffinity_np(attr, sizeof(set), &set);
+    }
+#else
+    (void)cpus;
+#endif
+}
+#endif
+
+// Start a timer thread (see watchdog_timer_create()), pinned to cpus if
+// non-zero
+static void *timer_create_thread(z_wdt_ctx_t *ctx, int priority, uint64_t cpus, bool critical) {
+    struct watchdog_timer *timer = calloc(1, sizeof(*timer));
+    if (timer == NULL) {
+        return NULL;
+    }
     
-    while (timer_thread_running) {
-        pthread_mutex_lock(&watchdog_mutex);
-        z_wdt_process();
-        pthread_mutex_unlock(&watchdog_mutex);
-        
-        // Sleep for 100ms
-        usleep(100000);
+    timer->ctx = ctx;
+    timer->deadline = INT64_MAX;
+    timer->running = true;
+    timer->critical = critical;
+    timer->fd = -1;
+    
+#if WATCHDOG_CLOCK == WATCHDOG_CLOCK_CACHED
+    // Seed the tick word before feeds start reading it
+    if (__atomic_fetch_add(&cached_refreshers, 1, __ATOMIC_RELAXED) == 0) {
+        __atomic_store_n(&cached_ticks, clock_read(), __ATOMIC_RELAXED);
     }
+#endif
     
-    return NULL;
+#ifdef _WIN32
+    InitializeCriticalSection(&timer->lock);
+    InitializeConditionVariable(&timer->cond);
+    timer->thread = CreateThread(NULL, 0, timer_thread_func, timer, 0, NULL);
+    if (timer->thread == NULL) {
+        watchdog_log("ERROR", "Failed to create timer thread");
+        DeleteCriticalSection(&timer->lock);
+        timer_release_refresher();
+        free(timer);
+        return NULL;
+    }
+    if (priority > 0) {
+        SetThreadPriority(timer->thread, THREAD_PRIORITY_TIME_CRITICAL);
+    }
+    if (cpus != 0 && SetThreadAffinityMask(timer->thread, (DWORD_PTR)cpus) == 0) {
+        watchdog_log("WARN", "Cannot pin timer thread to CPU mask 0x%llx", (unsigned long long)cpus);
+    }
+#else
+    pthread_mutex_init(&timer->lock, NULL);
+    pthread_condattr_t cond_attr;
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&timer->cond, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
+    
+    pthread_attr_t attr;
+    timer_thread_attr(&attr, priority, cpus);
+    int result = pthread_create(&timer->thread, &attr, timer_thread_func, timer);
+    pthread_attr_destroy(&attr);
+    if (result != 0 && priority > 0) {
+        watchdog_log("WARN", "No real-time priority %d for timer thread, using the default", priority);
+        timer_thread_attr(&attr, 0, cpus);
+        result = pthread_create(&timer->thread, &attr, timer_thread_func, timer);
+        pthread_attr_destroy(&attr);
+    }
+    if (result != 0 && cpus != 0) {
+        watchdog_log("WARN", "Cannot pin timer thread to CPU mask 0x%llx", (unsigned long long)cpus);
+        result = pthread_create(&timer->thread, NULL, timer_thread_func, timer);
+    }
+    if (result != 0) {
+        watchdog_log("ERROR", "Failed to create timer thread");
+        pthread_cond_destroy(&timer->cond);
+        pthread_mutex_destroy(&timer->lock);
+        timer_release_refresher();
+        free(timer);
+        return NULL;
+    }
+#endif
+    
+    return timer;
 }
+
+// Start a timer thread for a context. A positive priority asks for a
+// real-time thread (SCHED_FIFO priority / THREAD_PRIORITY_TIME_CRITICAL);
+// without the privilege for it the thread runs at the default priority.
+// An external timer starts no thread (see timer_create_external()).
+void *watchdog_timer_create(z_wdt_ctx_t *ctx, int priority, bool external) {
+    if (!external) {
+        return timer_create_thread(ctx, priority, 0, false);
+    }
+    
+    struct watchdog_timer *timer = calloc(1, sizeof(*timer));
+    if (timer == NULL) {
+        return NULL;
+    }
+    timer->ctx = ctx;
+    timer->deadline = INT64_MAX;
+    timer->running = true;
+    return timer_create_external(timer);
+}
+
+// Start the thread expiring a context's critical shard: real-time at
+// priority (WATCHDOG_CRITICAL_PRIORITY if 0), pinned to the cpus mask if
+// non-zero, with the process's memory locked while it runs. Each of these
+// falls back with a warning when the process lacks the privilege, so the
+// thread always starts; bounded latency needs all three.
+void *watchdog_timer_create_critical(z_wdt_ctx_t *ctx, int priority, uint64_t cpus) {
+#if WATCHDOG_CRITICAL_MLOCK && !defined(_WIN32)
+    if (__atomic_fetch_add(&critical_lockers, 1, __ATOMIC_ACQ_REL) == 0 && mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        watchdog_log("WARN", "Cannot lock memory for the critical timer thread (errno %d)", errno);
+    }
+#endif
+    
+    struct watchdog_timer *timer =
+        timer_create_thread(ctx, priority > 0 ? priority : WATCHDOG_CRITICAL_PRIORITY, cpus, true);
+    if (timer == NULL) {
+        timer_release_critical();
+    }
+    return timer;
+}
+
+// Unlock memory after the last critical thread
+static void timer_release_critical(void) {
+#if WATCHDOG_CRITICAL_MLOCK && !defined(_WIN32)
+    if (__atomic_sub_fetch(&critical_lockers, 1, __ATOMIC_ACQ_REL) == 0) {
+        munlockall();
+    }
+#endif
+}
+
+// Drop a timer thread from the cached tick word's refreshers
+static void timer_release_refresher(void) {
+#if WATCHDOG_CLOCK == WATCHDOG_CLOCK_CACHED
+    // With no thread left to refresh it, read the clock directly
+    if (__atomic_sub_fetch(&cached_refreshers, 1, __ATOMIC_RELAXED) == 0) {
+        __atomic_store_n(&cached_ticks, 0, __ATOMIC_RELAXED);
+    }
+#endif
+}
+
+// Stop a context's timer thread and wait for it to exit
+void watchdog_timer_destroy(void *handle) {
+    struct watchdog_timer *timer = handle;
+    if (timer == NULL) {
+        return;
+    }
+    
+    if (timer->external) {
+#ifdef _WIN32
+        DeleteCriticalSection(&timer->lock);
+#else
+        if (timer->fd >= 0) {
+            close(timer->fd);
+        }
+        pthread_mutex_destroy(&timer->lock);
+#endif
+        free(timer);
+        return;
+    }
+    
+    timer_lock_acquire(timer);
+    timer->running = false;
+    timer_signal(timer);
+    timer_lock_release(timer);
+#ifdef _WIN32
+    WaitForSingleObject(timer->thread, INFINITE);
+    CloseHandle(timer->thread);
+    DeleteCriticalSection(&timer->lock);
+#else
+    pthread_join(timer->thread, NULL);
+    pthread_cond_destroy(&timer->cond);
+    pthread_mutex_destroy(&timer->lock);
 #endif
+    timer_release_refresher();
+    if (timer->critical) {
+        timer_release_critical();
+    }
+    free(timer);
+}
 
-// OS-specific initialization
+// OS-specific initialization: the tick source, shared by all contexts
 int watchdog_os_init(void) {
-    // Initialize mutex
+#if WATCHDOG_CLOCK == WATCHDOG_CLOCK_TSC
+    tsc_calibrate();
+#elif WATCHDOG_CLOCK == WATCHDOG_CLOCK_COARSE
 #ifdef _WIN32
-    InitializeCriticalSection(&watchdog_mutex);
+    timer_slack_ns = 16000000;         // GetTickCount64 advances every ~15.6 ms
+#else
+    struct timespec resolution;
+    clock_getres(CLOCK_MONOTONIC_COARSE, &resolution);
+    timer_slack_ns = (int64_t)resolution.tv_sec * 1000000000 + resolution.tv_nsec;
+#endif
 #endif
     
-    // Start timer thread
-    timer_thread_running = true;
+    return 0;
+}
+
+// OS-specific cleanup, after the last context is gone
+void watchdog_os_cleanup(void) {
+}
+
+// Start the log thread (only while a context runs its own timer thread)
+int watchdog_log_start(void) {
+    log_signalled = false;
+    log_thread_running = true;
 #ifdef _WIN32
-    timer_thread = CreateThread(NULL, 0, timer_thread_func, NULL, 0, NULL);
-    if (timer_thread == NULL) {
-        watchdog_log("ERROR", "Failed to create timer thread");
+    InitializeCriticalSection(&log_lock);
+    InitializeConditionVariable(&log_cond);
+    log_thread = CreateThread(NULL, 0, log_thread_func, NULL, 0, NULL);
+    if (log_thread == NULL) {
+        log_thread_running = false;
+        watchdog_log("ERROR", "Failed to create log thread");
         return -1;
     }
 #else
-    if (pthread_create(&timer_thread, NULL, timer_thread_func, NULL) != 0) {
-        watchdog_log("ERROR", "Failed to create timer thread");
+    if (pthread_create(&log_thread, NULL, log_thread_func, NULL) != 0) {
+        log_thread_running = false;
+        watchdog_log("ERROR", "Failed to create log thread");
         return -1;
     }
 #endif
@@ -126,33 +774,498 @@ int watchdog_os_init(void) {
     return 0;
 }
 
-// OS-specific cleanup
-void watchdog_os_cleanup(void) {
-    if (timer_thread_running) {
-        timer_thread_running = false;
+// Stop the log thread after it drained the ring
+void watchdog_log_stop(void) {
+    if (log_thread_running) {
+#ifdef _WIN32
+        EnterCriticalSection(&log_lock);
+        log_thread_running = false;
+        WakeConditionVariable(&log_cond);
+        LeaveCriticalSection(&log_lock);
+        WaitForSingleObject(log_thread, INFINITE);
+        CloseHandle(log_thread);
+        DeleteCriticalSection(&log_lock);
+#else
+        pthread_mutex_lock(&log_lock);
+        log_thread_running = false;
+        pthread_cond_signal(&log_cond);
+        pthread_mutex_unlock(&log_lock);
+        pthread_join(log_thread, NULL);
+#endif
+    }
+}
+
+// Open the hardware watchdog, which starts it, and set its timeout. The
+// driver works in whole seconds; the timeout it took is reported back.
+int watchdog_hw_open(uint32_t *timeout_ms) {
+#ifdef __linux__
+    hw_fd = open(WATCHDOG_HW_DEVICE, O_WRONLY | O_CLOEXEC);
+    if (hw_fd < 0) {
+        watchdog_log("ERROR", "Cannot open %s", WATCHDOG_HW_DEVICE);
+        return -1;
+    }
+    
+    int seconds = (int)((*timeout_ms + 999) / 1000);
+    if (ioctl(hw_fd, WDIOC_SETTIMEOUT, &seconds) != 0 && ioctl(hw_fd, WDIOC_GETTIMEOUT, &seconds) != 0) {
+        watchdog_log("ERROR", "%s is not a watchdog device", WATCHDOG_HW_DEVICE);
+        close(hw_fd);
+        hw_fd = -1;
+        return -1;
+    }
+    *timeout_ms = (uint32_t)seconds * 1000;
+    return 0;
+#else
+    (void)timeout_ms;
+    watchdog_log("ERROR", "No hardware watchdog support on this platform");
+    return -1;
+#endif
+}
+
+void watchdog_hw_pet(void) {
+#ifdef __linux__
+    if (hw_fd >= 0) {
+        ioctl(hw_fd, WDIOC_KEEPALIVE, 0);
+    }
+#endif
+}
+
+// Close with the magic character so drivers without nowayout disarm
+void watchdog_hw_close(void) {
+#ifdef __linux__
+    if (hw_fd >= 0) {
+        if (write(hw_fd, "V", 1) != 1) {
+            watchdog_log("WARN", "Hardware watchdog stays armed after close");
+        }
+        close(hw_fd);
+        hw_fd = -1;
+    }
+#endif
+}
+
+// Map a named shared-memory region. Creating replaces a region left behind
+// by a supervisor that crashed; attaching reports the region's size.
+void *watchdog_shm_map(const char *name, size_t *size, bool create) {
+#ifdef _WIN32
+    HANDLE mapping = create ? CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                                 (DWORD)((uint64_t)*size >> 32), (DWORD)*size, name)
+                            : OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name);
+    if (mapping == NULL) {
+        return NULL;
+    }
+    
+    // The view keeps the mapping alive, so the handle can go right away
+    void *region = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, create ? *size : 0);
+    CloseHandle(mapping);
+    if (region != NULL && !create) {
+        MEMORY_BASIC_INFORMATION info;
+        VirtualQuery(region, &info, sizeof(info));
+        *size = info.RegionSize;
+    }
+    return region;
+#else
+    if (create) {
+        shm_unlink(name);
+    }
+    int fd = shm_open(name, create ? O_RDWR | O_CREAT | O_EXCL : O_RDWR, 0600);
+    if (fd < 0) {
+        return NULL;
+    }
+    
+    struct stat st;
+    bool sized = create ? ftruncate(fd, (off_t)*size) == 0 : fstat(fd, &st) == 0;
+    if (sized && !create) {
+        *size = (size_t)st.st_size;
+    }
+    void *region = sized && *size > 0 ? mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (region == MAP_FAILED) {
+        if (create) {
+            shm_unlink(name);
+        }
+        return NULL;
+    }
+    return region;
+#endif
+}
+
+void watchdog_shm_unmap(void *region, size_t size) {
+#ifdef _WIN32
+    (void)size;
+    UnmapViewOfFile(region);
+#else
+    munmap(region, size);
+#endif
+}
+
+// Remove a region's name; mappings stay valid. Win32 mappings go away with the last view.
+void watchdog_shm_unlink(const char *name) {
+#ifdef _WIN32
+    (void)name;
+#else
+    shm_unlink(name);
+#endif
+}
+
+// Sleep until *word differs from value, a wake, or the timeout. Linux uses
+// a shared (not process-private) futex; elsewhere the word is polled.
+void watchdog_shm_wait(uint32_t *word, uint32_t value, uint64_t timeout_ns) {
+#ifdef __linux__
+    struct timespec ts = { (time_t)(timeout_ns / 1000000000), (long)(timeout_ns % 1000000000) };
+    syscall(SYS_futex, word, FUTEX_WAIT, value, &ts, NULL, 0);
+#else
+    uint64_t start = watchdog_get_ns();
+    while (__atomic_load_n(word, __ATOMIC_ACQUIRE) == value && watchdog_get_ns() - start < timeout_ns) {
+        usleep(1000);
+    }
+#endif
+}
+
+void watchdog_shm_wake(uint32_t *word) {
+#ifdef __linux__
+    syscall(SYS_futex, word, FUTEX_WAKE, INT32_MAX, NULL, NULL, 0);
+#else
+    (void)word;
+#endif
+}
+
+int32_t watchdog_process_id(void) {
+#ifdef _WIN32
+    return (int32_t)GetCurrentProcessId();
+#else
+    return (int32_t)getpid();
+#endif
+}
+
+// Whether a process exists. A child that exited but was not reaped yet
+// still counts as alive on POSIX.
+bool watchdog_process_alive(int32_t pid) {
+#ifdef _WIN32
+    HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, (DWORD)pid);
+    if (process == NULL) {
+        return GetLastError() == ERROR_ACCESS_DENIED;
+    }
+    bool alive = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+    CloseHandle(process);
+    return alive;
+#else
+    return kill((pid_t)pid, 0) == 0 || errno == EPERM;
+#endif
+}
+
+// Hard reset of a hosted system: end the process abnormally, leaving a
+// core dump, for its supervisor (init, systemd, a container runtime) to
+// restart it
+void watchdog_system_reset(void) {
+    abort();
+}
+
+// Thread ID for the flight recorder: the kernel's TID on Linux, as shown
+// in /proc and by debuggers, cached per thread since it takes a syscall
+uint32_t watchdog_thread_id(void) {
+#ifdef _WIN32
+    return (uint32_t)GetCurrentThreadId();
+#elif defined(__linux__)
+    static __thread uint32_t tid;
+    if (tid == 0) {
+        tid = (uint32_t)syscall(SYS_gettid);
+    }
+    return tid;
+#else
+    uint64_t id = (uint64_t)(uintptr_t)pthread_self() * 0x9E3779B97F4A7C15ull;
+    return (uint32_t)(id >> 32);
+#endif
+}
+
+// Map a flight recorder file shared, so its pages outlive the process:
+// created (or reused) at *size for a context, or read-only as it is found
+void *watchdog_recorder_map(const char *path, size_t *size, bool create) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, create ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, create ? OPEN_ALWAYS : OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return NULL;
+    }
+
+    LARGE_INTEGER length;
+    if (!create && GetFileSizeEx(file, &length)) {
+        *size = (size_t)length.QuadPart;
+    }
+    HANDLE mapping = *size > 0 ? CreateFileMappingA(file, NULL, create ? PAGE_READWRITE : PAGE_READONLY,
+                                                    (DWORD)((uint64_t)*size >> 32), (DWORD)*size, NULL) : NULL;
+    CloseHandle(file);
+    if (mapping == NULL) {
+        return NULL;
+    }
+    void *region = MapViewOfFile(mapping, create ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, *size);
+    CloseHandle(mapping);
+    return region;
+#else
+    int fd = open(path, create ? O_RDWR | O_CREAT : O_RDONLY, 0600);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    struct stat st;
+    bool sized = create ? ftruncate(fd, (off_t)*size) == 0 : fstat(fd, &st) == 0;
+    if (sized && !create) {
+        *size = (size_t)st.st_size;
+    }
+    void *region = sized && *size > 0 ?
+                   mmap(NULL, *size, create ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+    return region == MAP_FAILED ? NULL : region;
+#endif
+}
+
+void watchdog_recorder_unmap(void *region, size_t size) {
+    watchdog_shm_unmap(region, size);
+}
+
+// Write the mapped pages through to the file before returning, so they
+// survive a reset as well as a crash
+void watchdog_recorder_sync(void *region, size_t size) {
+#ifdef _WIN32
+    FlushViewOfFile(region, size);
+#else
+    msync(region, size, MS_SYNC);
+#endif
+}
+
+// OS-specific mutex operations (one mutex per shard plus the timer's).
+// They inherit priority where supported, so a preempted thread holding a
+// shard lock can't hold up a real-time timer thread waiting for it.
+void *watchdog_mutex_create(void) {
+#ifdef _WIN32
+    CRITICAL_SECTION *mutex = malloc(sizeof(*mutex));
+    if (mutex != NULL) {
+        InitializeCriticalSection(mutex);
+    }
+#else
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+#if defined(_POSIX_THREAD_PRIO_INHERIT) && _POSIX_THREAD_PRIO_INHERIT > 0
+    pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT);
+#endif
+    pthread_mutex_t *mutex = malloc(sizeof(*mutex));
+    if (mutex != NULL && pthread_mutex_init(mutex, &attr) != 0) {
+        free(mutex);
+        mutex = NULL;
+    }
+    pthread_mutexattr_destroy(&attr);
+#endif
+    return mutex;
+}
+
+void watchdog_mutex_destroy(void *mutex) {
+    if (mutex == NULL) {
+        return;
+    }
+#ifdef _WIN32
+    DeleteCriticalSection((CRITICAL_SECTION *)mutex);
+#else
+    pthread_mutex_destroy((pthread_mutex_t *)mutex);
+#endif
+    free(mutex);
+}
+
+void watchdog_mutex_lock(void *mutex) {
+#ifdef _WIN32
+    EnterCriticalSection((CRITICAL_SECTION *)mutex);
+#else
+    pthread_mutex_lock((pthread_mutex_t *)mutex);
+#endif
+}
+
+void watchdog_mutex_unlock(void *mutex) {
+#ifdef _WIN32
+    LeaveCriticalSection((CRITICAL_SECTION *)mutex);
+#else
+    pthread_mutex_unlock((pthread_mutex_t *)mutex);
+#endif
+}
+
+// Number identifying the calling thread or its CPU, for shard placement
+uint32_t watchdog_shard_hint(z_wdt_shard_policy policy) {
+    uint64_t id;
+    
+#ifdef _WIN32
+    if (policy == Z_WDT_SHARD_BY_CPU) {
+        return (uint32_t)GetCurrentProcessorNumber();
+    }
+    id = GetCurrentThreadId();
+#else
+#ifdef __linux__
+    if (policy == Z_WDT_SHARD_BY_CPU) {
+        int cpu = sched_getcpu();
+        if (cpu >= 0) {
+            return (uint32_t)cpu;
+        }
+    }
+#else
+    (void)policy;
+#endif
+    id = (uint64_t)(uintptr_t)pthread_self();
+#endif
+    
+    // Thread IDs are aligned addresses or counters; mix them before the modulo
+    id *= 0x9E3779B97F4A7C15ull;
+    return (uint32_t)(id >> 32);
+}
+
+// Dispatch pool lock helpers
+static void dispatch_lock_acquire(struct watchdog_dispatch_pool *pool) {
+#ifdef _WIN32
+    EnterCriticalSection(&pool->lock);
+#else
+    pthread_mutex_lock(&pool->lock);
+#endif
+}
+
+static void dispatch_lock_release(struct watchdog_dispatch_pool *pool) {
+#ifdef _WIN32
+    LeaveCriticalSection(&pool->lock);
+#else
+    pthread_mutex_unlock(&pool->lock);
+#endif
+}
+
+// Worker loop: run queued callbacks until stopped and the queue is drained
+static void dispatch_worker_loop(struct watchdog_dispatch_pool *pool) {
+    dispatch_lock_acquire(pool);
+    
+    for (;;) {
+        while (pool->count == 0 && pool->running) {
 #ifdef _WIN32
-        WaitForSingleObject(timer_thread, INFINITE);
-        CloseHandle(timer_thread);
-        DeleteCriticalSection(&watchdog_mutex);
+            SleepConditionVariableCS(&pool->cond, &pool->lock, INFINITE);
 #else
-        pthread_join(timer_thread, NULL);
+            pthread_cond_wait(&pool->cond, &pool->lock);
 #endif
+        }
+        if (pool->count == 0) {
+            break;
+        }
+        
+        struct dispatch_job job = pool->queue[pool->head];
+        pool->head = (pool->head + 1) % DISPATCH_QUEUE_SIZE;
+        pool->count--;
+        dispatch_lock_release(pool);
+        
+        job.callback(job.channel_id, job.user_data);
+        
+        dispatch_lock_acquire(pool);
     }
+    
+    dispatch_lock_release(pool);
 }
 
-// OS-specific mutex operations
-void watchdog_mutex_lock(void) {
 #ifdef _WIN32
-    EnterCriticalSection(&watchdog_mutex);
+static DWORD WINAPI dispatch_worker_func(LPVOID arg) {
+    dispatch_worker_loop(arg);
+    return 0;
+}
 #else
-    pthread_mutex_lock(&watchdog_mutex);
+static void* dispatch_worker_func(void *arg) {
+    dispatch_worker_loop(arg);
+    return NULL;
+}
+#endif
+
+// Start a callback worker pool
+void *watchdog_dispatch_create(uint32_t workers) {
+    struct watchdog_dispatch_pool *pool = calloc(1, sizeof(*pool));
+    if (pool == NULL) {
+        return NULL;
+    }
+    
+    pool->workers = calloc(workers, sizeof(*pool->workers));
+    if (pool->workers == NULL) {
+        free(pool);
+        return NULL;
+    }
+    
+#ifdef _WIN32
+    InitializeCriticalSection(&pool->lock);
+    InitializeConditionVariable(&pool->cond);
+#else
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->cond, NULL);
 #endif
+    
+    pool->running = true;
+    for (pool->worker_count = 0; pool->worker_count < workers; pool->worker_count++) {
+#ifdef _WIN32
+        pool->workers[pool->worker_count] = CreateThread(NULL, 0, dispatch_worker_func, pool, 0, NULL);
+        if (pool->workers[pool->worker_count] == NULL) {
+            watchdog_dispatch_destroy(pool);
+            return NULL;
+        }
+#else
+        if (pthread_create(&pool->workers[pool->worker_count], NULL, dispatch_worker_func, pool) != 0) {
+            watchdog_dispatch_destroy(pool);
+            return NULL;
+        }
+#endif
+    }
+    
+    return pool;
+}
+
+// Queue a callback for the pool; runs it on the caller if the queue is full
+void watchdog_dispatch_submit(void *handle, watchdog_callback_t callback, int channel_id, void *user_data) {
+    struct watchdog_dispatch_pool *pool = handle;
+    
+    dispatch_lock_acquire(pool);
+    
+    if (pool->count == DISPATCH_QUEUE_SIZE) {
+        dispatch_lock_release(pool);
+        watchdog_log("WARN", "Dispatch queue full, running callback for channel %d inline", channel_id);
+        callback(channel_id, user_data);
+        return;
+    }
+    
+    struct dispatch_job *job = &pool->queue[(pool->head + pool->count) % DISPATCH_QUEUE_SIZE];
+    job->callback = callback;
+    job->channel_id = channel_id;
+    job->user_data = user_data;
+    pool->count++;
+    
+#ifdef _WIN32
+    WakeConditionVariable(&pool->cond);
+#else
+    pthread_cond_signal(&pool->cond);
+#endif
+    dispatch_lock_release(pool);
 }
 
-void watchdog_mutex_unlock(void) {
+// Stop a pool once every queued callback has run
+void watchdog_dispatch_destroy(void *handle) {
+    struct watchdog_dispatch_pool *pool = handle;
+    
+    dispatch_lock_acquire(pool);
+    pool->running = false;
+#ifdef _WIN32
+    WakeAllConditionVariable(&pool->cond);
+#else
+    pthread_cond_broadcast(&pool->cond);
+#endif
+    dispatch_lock_release(pool);
+    
+    for (uint32_t i = 0; i < pool->worker_count; i++) {
+#ifdef _WIN32
+        WaitForSingleObject(pool->workers[i], INFINITE);
+        CloseHandle(pool->workers[i]);
+#else
+        pthread_join(pool->workers[i], NULL);
+#endif
+    }
+    
 #ifdef _WIN32
-    LeaveCriticalSection(&watchdog_mutex);
+    DeleteCriticalSection(&pool->lock);
 #else
-    pthread_mutex_unlock(&watchdog_mutex);
+    pthread_cond_destroy(&pool->cond);
+    pthread_mutex_destroy(&pool->lock);
 #endif
+    free(pool->workers);
+    free(pool);
 }
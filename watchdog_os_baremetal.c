@@ -0,0 +1,388 @@
+/*
+ * Watchdog OS Abstraction Layer - Bare Metal
+ * Reference port for MCUs without an RTOS. One low-power one-shot
+ * comparator (LPTIM, RTC alarm, or SysTick when deep sleep isn't needed)
+ * is programmed for the earliest deadline of all contexts; its interrupt
+ * calls watchdog_timer_service(), which runs z_wdt_ctx_process(). Between
+ * deadlines nothing runs, so the core can stay in WFI / stop mode.
+ *
+ * Build with WATCHDOG_STATIC_CHANNELS: nothing here allocates memory.
+ * Mutexes mask interrupts, so the API may be called from thread mode and
+ * from interrupts at or below the comparator's priority. Timeout callbacks
+ * run in the comparator interrupt unless it defers the service call.
+ */
+
+#include "z_wdt_internal.h"
+#include <stdio.h>
+#include <stdarg.h>
+
+/*
+ * Board hooks (implement for the target's timer and console).
+ * board_timer_now() is a free-running count at WATCHDOG_TICK_HZ, extended
+ * to 64 bits. board_timer_compare() arms a one-shot interrupt at an
+ * absolute count and must fire at once if that count has already passed.
+ */
+extern uint64_t board_timer_now(void);
+extern void board_timer_compare(uint64_t count);
+extern void board_timer_cancel(void);
+extern void board_log_write(const char *text);
+
+#if defined(__ARM_ARCH) && !defined(__ARM_ARCH_ISA_A64)
+// Cortex-M: mask interrupts through PRIMASK, restoring the previous state
+static inline uint32_t irq_save(void) {
+    uint32_t primask;
+    __asm__ __volatile__("mrs %0, primask\n\tcpsid i" : "=r"(primask) : : "memory");
+    return primask;
+}
+
+static inline void irq_restore(uint32_t primask) {
+    __asm__ __volatile__("msr primask, %0" : : "r"(primask) : "memory");
+}
+#else
+// Other cores provide the masking themselves
+extern uint32_t board_irq_save(void);
+extern void board_irq_restore(uint32_t state);
+#define irq_save() board_irq_save()
+#define irq_restore(state) board_irq_restore(state)
+#endif
+
+#define BAREMETAL_MAX_MUTEXES (WATCHDOG_MAX_CONTEXTS * (WATCHDOG_MAX_SHARDS + 1))
+#define BAREMETAL_LOG_LINE 160
+
+// Timer object: a deadline slot sharing the single hardware comparator
+struct watchdog_timer {
+    z_wdt_ctx_t *ctx;
+    int64_t deadline;                  // Absolute deadline (interrupts masked)
+    bool used;
+    bool external;                     // Left to the application's loop
+    bool critical;                     // Runs z_wdt_ctx_process_critical(), ahead of the others
+};
+
+// Slots: one per context, plus one per context with a critical class
+#define BAREMETAL_MAX_TIMERS (WATCHDOG_MAX_CONTEXTS * 2)
+
+// Mutex object: interrupt mask state saved by the holder
+struct watchdog_mutex {
+    uint32_t saved;
+    bool used;
+};
+
+static struct watchdog_timer g_timers[BAREMETAL_MAX_TIMERS];
+static struct watchdog_mutex g_mutexes[BAREMETAL_MAX_MUTEXES];
+
+int64_t watchdog_get_ticks(void) {
+    return (int64_t)board_timer_now();
+}
+
+// Instrumentation clock at the comparator's resolution
+uint64_t watchdog_get_ns(void) {
+    uint64_t count = board_timer_now();
+    return count / WATCHDOG_TICK_HZ * 1000000000 + count % WATCHDOG_TICK_HZ * 1000000000 / WATCHDOG_TICK_HZ;
+}
+
+// Program the comparator for the earliest armed deadline (interrupts masked)
+static void comparator_program(void) {
+    int64_t next_timeout = INT64_MAX;
+    for (uint32_t i = 0; i < BAREMETAL_MAX_TIMERS; i++) {
+        const struct watchdog_timer *timer = &g_timers[i];
+        if (timer->used && !timer->external && timer->deadline < next_timeout) {
+            next_timeout = timer->deadline;
+        }
+    }
+    
+    if (next_timeout == INT64_MAX) {
+        board_timer_cancel();
+    } else {
+        board_timer_compare((uint64_t)next_timeout);
+    }
+}
+
+// Run every context whose deadline passed, critical shards first. Call
+// from the comparator interrupt, or from a lower-priority handler it pends
+// to keep callbacks out of the timer interrupt.
+void watchdog_timer_service(void) {
+    for (uint32_t pass = 0; pass < 2; pass++) {
+        for (uint32_t i = 0; i < BAREMETAL_MAX_TIMERS; i++) {
+            struct watchdog_timer *timer = &g_timers[i];
+            
+            uint32_t primask = irq_save();
+            bool due = timer->used && !timer->external && timer->critical == (pass == 0) &&
+                       timer->deadline <= watchdog_get_ticks();
+            if (due) {
+                // Consume the deadline; processing re-arms the next one
+                timer->deadline = INT64_MAX;
+            }
+            irq_restore(primask);
+            
+            if (due && timer->critical) {
+                z_wdt_ctx_process_critical(timer->ctx);
+            } else if (due) {
+                z_wdt_ctx_process(timer->ctx);
+            }
+        }
+    }
+    
+    uint32_t primask = irq_save();
+    comparator_program();
+    irq_restore(primask);
+}
+
+void watchdog_timer_start(void *handle, int64_t timeout_ticks) {
+    struct watchdog_timer *timer = handle;
+    
+    uint32_t primask = irq_save();
+    timer->deadline = timeout_ticks;
+    if (!timer->external) {
+        comparator_program();
+    }
+    irq_restore(primask);
+}
+
+void watchdog_timer_stop(void *handle) {
+    watchdog_timer_start(handle, INT64_MAX);
+}
+
+// Take a deadline slot for a context; there are no threads, so the
+// priority is the comparator interrupt's and is set by the board
+void *watchdog_timer_create(z_wdt_ctx_t *ctx, int priority, bool external) {
+    (void)priority;
+    
+    uint32_t primask = irq_save();
+    struct watchdog_timer *timer = NULL;
+    for (uint32_t i = 0; i < BAREMETAL_MAX_TIMERS && timer == NULL; i++) {
+        if (!g_timers[i].used) {
+            timer = &g_timers[i];
+            timer->ctx = ctx;
+            timer->deadline = INT64_MAX;
+            timer->external = external;
+            timer->critical = false;
+            timer->used = true;
+        }
+    }
+    irq_restore(primask);
+    
+    return timer;
+}
+
+// A deadline slot for a critical shard, which watchdog_timer_service()
+// runs before any other context's; single core, nothing to pin or lock
+void *watchdog_timer_create_critical(z_wdt_ctx_t *ctx, int priority, uint64_t cpus) {
+    (void)cpus;
+    
+    struct watchdog_timer *timer = watchdog_timer_create(ctx, priority, false);
+    if (timer != NULL) {
+        timer->critical = true;
+    }
+    return timer;
+}
+
+void watchdog_timer_destroy(void *handle) {
+    struct watchdog_timer *timer = handle;
+    if (timer == NULL) {
+        return;
+    }
+    
+    uint32_t primask = irq_save();
+    timer->used = false;
+    comparator_program();
+    irq_restore(primask);
+}
+
+// No descriptors; an external loop polls z_wdt_ctx_next_deadline()
+int watchdog_timer_fd(void *timer) {
+    (void)timer;
+    return -1;
+}
+
+void watchdog_log(const char *level, const char *format, ...) {
+    char line[BAREMETAL_LOG_LINE];
+    int len = snprintf(line, sizeof(line), "[%s] ", level);
+    
+    va_list args;
+    va_start(args, format);
+    vsnprintf(line + len, sizeof(line) - (size_t)len, format, args);
+    va_end(args);
+    
+    board_log_write(line);
+}
+
+// No log thread: drain on the caller
+void watchdog_log_wake(void) {
+    z_wdt_log_drain();
+}
+
+int watchdog_log_start(void) {
+    return 0;
+}
+
+void watchdog_log_stop(void) {
+}
+
+int watchdog_os_init(void) {
+    return 0;
+}
+
+void watchdog_os_cleanup(void) {
+    uint32_t primask = irq_save();
+    board_timer_cancel();
+    irq_restore(primask);
+}
+
+// Mutexes mask interrupts; each holder keeps the state it replaced, so
+// nested locks (shard, then timer) unwind in order
+void *watchdog_mutex_create(void) {
+    uint32_t primask = irq_save();
+    struct watchdog_mutex *mutex = NULL;
+    for (uint32_t i = 0; i < BAREMETAL_MAX_MUTEXES && mutex == NULL; i++) {
+        if (!g_mutexes[i].used) {
+            mutex = &g_mutexes[i];
+            mutex->used = true;
+        }
+    }
+    irq_restore(primask);
+    
+    return mutex;
+}
+
+void watchdog_mutex_destroy(void *mutex) {
+    if (mutex == NULL) {
+        return;
+    }
+    ((struct watchdog_mutex *)mutex)->used = false;
+}
+
+void watchdog_mutex_lock(void *mutex) {
+    uint32_t primask = irq_save();
+    ((struct watchdog_mutex *)mutex)->saved = primask;
+}
+
+void watchdog_mutex_unlock(void *mutex) {
+    irq_restore(((struct watchdog_mutex *)mutex)->saved);
+}
+
+// Single core, single thread of execution
+uint32_t watchdog_shard_hint(z_wdt_shard_policy policy) {
+    (void)policy;
+    return 0;
+}
+
+// No worker threads: configurations with dispatch_workers fail to start
+void *watchdog_dispatch_create(uint32_t workers) {
+    (void)workers;
+    return NULL;
+}
+
+void watchdog_dispatch_submit(void *pool, watchdog_callback_t callback, int channel_id, void *user_data) {
+    (void)pool;
+    callback(channel_id, user_data);
+}
+
+void watchdog_dispatch_destroy(void *pool) {
+    (void)pool;
+}
+
+// Hardware watchdog through board hooks (define WATCHDOG_HW_BOARD), e.g. an
+// STM32 IWDG: start it with the prescaler/reload closest to *timeout_ms,
+// report the real timeout, and reload it (KR = 0xAAAA) on each kick.
+// board_hw_watchdog_stop() may do nothing on devices that can't be stopped.
+#ifdef WATCHDOG_HW_BOARD
+extern int board_hw_watchdog_start(uint32_t *timeout_ms);
+extern void board_hw_watchdog_kick(void);
+extern void board_hw_watchdog_stop(void);
+#endif
+
+int watchdog_hw_open(uint32_t *timeout_ms) {
+#ifdef WATCHDOG_HW_BOARD
+    return board_hw_watchdog_start(timeout_ms);
+#else
+    (void)timeout_ms;
+    return -1;
+#endif
+}
+
+void watchdog_hw_pet(void) {
+#ifdef WATCHDOG_HW_BOARD
+    board_hw_watchdog_kick();
+#endif
+}
+
+void watchdog_hw_close(void) {
+#ifdef WATCHDOG_HW_BOARD
+    board_hw_watchdog_stop();
+#endif
+}
+
+// Single address space: no shared-memory supervision (z_wdt_shm_create() fails)
+void *watchdog_shm_map(const char *name, size_t *size, bool create) {
+    (void)name;
+    (void)size;
+    (void)create;
+    return NULL;
+}
+
+void watchdog_shm_unmap(void *region, size_t size) {
+    (void)region;
+    (void)size;
+}
+
+void watchdog_shm_unlink(const char *name) {
+    (void)name;
+}
+
+void watchdog_shm_wait(uint32_t *word, uint32_t value, uint64_t timeout_ns) {
+    (void)word;
+    (void)value;
+    (void)timeout_ns;
+}
+
+void watchdog_shm_wake(uint32_t *word) {
+    (void)word;
+}
+
+int32_t watchdog_process_id(void) {
+    return 0;
+}
+
+bool watchdog_process_alive(int32_t pid) {
+    (void)pid;
+    return true;
+}
+
+// Hard reset: mask interrupts and spin until the hardware watchdog, no
+// longer kicked, resets the MCU. Boards that should reset at once define
+// WATCHDOG_RESET_BOARD, e.g. for NVIC_SystemReset().
+#ifdef WATCHDOG_RESET_BOARD
+extern void board_system_reset(void);
+#endif
+
+void watchdog_system_reset(void) {
+#ifdef WATCHDOG_RESET_BOARD
+    board_system_reset();
+#endif
+    (void)irq_save();
+    for (;;) {
+    }
+}
+
+// One thread of execution, reported as 0 to the flight recorder
+uint32_t watchdog_thread_id(void) {
+    return 0;
+}
+
+// No file system: recorders live in memory (a recorder_path fails)
+void *watchdog_recorder_map(const char *path, size_t *size, bool create) {
+    (void)path;
+    (void)size;
+    (void)create;
+    return NULL;
+}
+
+void watchdog_recorder_unmap(void *region, size_t size) {
+    (void)region;
+    (void)size;
+}
+
+void watchdog_recorder_sync(void *region, size_t size) {
+    (void)region;
+    (void)size;
+}
@@ -0,0 +1,535 @@
+/*
+ * Watchdog OS Abstraction Layer - FreeRTOS
+ * Reference port: one task per context blocks on its task notification
+ * with a timeout reaching to the armed deadline, so with tickless idle
+ * (configUSE_TICKLESS_IDLE) the MCU sleeps until the next timeout.
+ * Arming an earlier deadline notifies the task; a later one is picked up
+ * after the current wait, as in watchdog_os.c.
+ *
+ * The API must be called from tasks, not interrupts (the locks are
+ * FreeRTOS mutexes).
+ */
+
+#include "z_wdt.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdarg.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "queue.h"
+
+#ifndef WATCHDOG_TASK_STACK
+#define WATCHDOG_TASK_STACK (configMINIMAL_STACK_SIZE * 4)
+#endif
+#ifndef WATCHDOG_TASK_PRIORITY
+#define WATCHDOG_TASK_PRIORITY (tskIDLE_PRIORITY + 2)   // Timer task without timer_priority
+#endif
+#ifndef WATCHDOG_CRITICAL_TASK_PRIORITY
+#define WATCHDOG_CRITICAL_TASK_PRIORITY (configMAX_PRIORITIES - 1)  // Critical task without critical_priority
+#endif
+
+// Longest wait, so the 64-bit tick extension sees every wrap of the tick count
+#define TIMER_MAX_WAIT ((TickType_t)(portMAX_DELAY / 4))
+
+// Timer object: one task per context, sleeping until its armed deadline
+struct watchdog_timer {
+    z_wdt_ctx_t *ctx;                  // Context the task processes
+    TaskHandle_t task;
+    SemaphoreHandle_t exited;          // Given by the task just before it deletes itself
+    int64_t deadline;                  // Absolute deadline (critical section)
+    bool running;
+    bool external;                     // No task; the application calls z_wdt_ctx_process()
+    bool critical;                     // Runs z_wdt_ctx_process_critical() instead
+};
+
+// 64-bit extension of xTaskGetTickCount()
+static TickType_t tick_last;
+static uint64_t tick_high;
+
+// Log task draining the core's record ring
+static TaskHandle_t log_task;
+static SemaphoreHandle_t log_exited;
+static volatile bool log_task_running = false;
+
+// Callback dispatch pool: a job queue served by worker tasks
+#define DISPATCH_QUEUE_SIZE 64
+
+struct dispatch_job {
+    watchdog_callback_t callback;      // NULL asks the worker to exit
+    int channel_id;
+    void *user_data;
+};
+
+struct watchdog_dispatch_pool {
+    QueueHandle_t queue;
+    SemaphoreHandle_t exited;          // Counts workers that stopped
+    uint32_t worker_count;
+};
+
+void watchdog_log(const char *level, const char *format, ...);
+void watchdog_dispatch_destroy(void *handle);
+
+// Kernel tick count extended to 64 bits
+static uint64_t tick_count(void) {
+    taskENTER_CRITICAL();
+    TickType_t now = xTaskGetTickCount();
+    if (now < tick_last) {
+        tick_high += (uint64_t)portMAX_DELAY + 1;
+    }
+    tick_last = now;
+    uint64_t ticks = tick_high + now;
+    taskEXIT_CRITICAL();
+    
+    return ticks;
+}
+
+// Platform abstraction implementation
+int64_t watchdog_get_ticks(void) {
+    return (int64_t)(tick_count() * WATCHDOG_TICK_HZ / configTICK_RATE_HZ);
+}
+
+// Instrumentation clock; kernel tick resolution, so short intervals read 0
+uint64_t watchdog_get_ns(void) {
+    uint64_t ticks = tick_count();
+    return ticks / configTICK_RATE_HZ * 1000000000 + ticks % configTICK_RATE_HZ * 1000000000 / configTICK_RATE_HZ;
+}
+
+// Kernel ticks until a deadline, rounded up so the task never wakes early
+static TickType_t timer_wait_ticks(int64_t deadline) {
+    if (deadline == INT64_MAX) {
+        return TIMER_MAX_WAIT;
+    }
+    
+    int64_t remaining = deadline - watchdog_get_ticks();
+    if (remaining <= 0) {
+        return 0;
+    }
+    uint64_t wait = ((uint64_t)remaining * configTICK_RATE_HZ + WATCHDOG_TICK_HZ - 1) / WATCHDOG_TICK_HZ;
+    return wait < TIMER_MAX_WAIT ? (TickType_t)wait : TIMER_MAX_WAIT;
+}
+
+// Arm a context's timer task for an absolute deadline; only an earlier
+// deadline needs to wake it
+void watchdog_timer_start(void *handle, int64_t timeout_ticks) {
+    struct watchdog_timer *timer = handle;
+    
+    taskENTER_CRITICAL();
+    bool earlier = timeout_ticks < timer->deadline;
+    timer->deadline = timeout_ticks;
+    taskEXIT_CRITICAL();
+    
+    if (earlier && !timer->external) {
+        xTaskNotifyGive(timer->task);
+    }
+}
+
+void watchdog_timer_stop(void *handle) {
+    struct watchdog_timer *timer = handle;
+    
+    taskENTER_CRITICAL();
+    timer->deadline = INT64_MAX;
+    taskEXIT_CRITICAL();
+}
+
+// Timer task: sleep until the earliest deadline, then process. A
+// notification sent before the wait is latched, so none is missed.
+static void timer_task_func(void *arg) {
+    struct watchdog_timer *timer = arg;
+    
+    for (;;) {
+        taskENTER_CRITICAL();
+        bool running = timer->running;
+        int64_t deadline = timer->deadline;
+        bool due = deadline != INT64_MAX && deadline <= watchdog_get_ticks();
+        if (due) {
+            // Consume the deadline; z_wdt_ctx_process() re-arms the next one
+            timer->deadline = INT64_MAX;
+        }
+        taskEXIT_CRITICAL();
+        
+        if (!running) {
+            break;
+        }
+        if (due && timer->critical) {
+            z_wdt_ctx_process_critical(timer->ctx);
+            continue;
+        }
+        if (due) {
+            z_wdt_ctx_process(timer->ctx);
+            continue;
+        }
+        
+        ulTaskNotifyTake(pdTRUE, timer_wait_ticks(deadline));
+    }
+    
+    xSemaphoreGive(timer->exited);
+    vTaskDelete(NULL);
+}
+
+// Start a timer task at the given priority (capped below configMAX_PRIORITIES)
+static void *timer_create_task(z_wdt_ctx_t *ctx, UBaseType_t priority, bool critical) {
+    struct watchdog_timer *timer = pvPortMalloc(sizeof(*timer));
+    if (timer == NULL) {
+        return NULL;
+    }
+    
+    timer->ctx = ctx;
+    timer->task = NULL;
+    timer->exited = NULL;
+    timer->deadline = INT64_MAX;
+    timer->running = true;
+    timer->external = false;
+    timer->critical = critical;
+    
+    timer->exited = xSemaphoreCreateBinary();
+    if (timer->exited == NULL ||
+        xTaskCreate(timer_task_func, critical ? "wdt-crit" : "wdt", WATCHDOG_TASK_STACK, timer,
+                    priority < configMAX_PRIORITIES ? priority : configMAX_PRIORITIES - 1,
+                    &timer->task) != pdPASS) {
+        watchdog_log("ERROR", "Failed to create timer task");
+        if (timer->exited != NULL) {
+            vSemaphoreDelete(timer->exited);
+        }
+        vPortFree(timer);
+        return NULL;
+    }
+    
+    return timer;
+}
+
+// Start a timer task for a context. A positive priority is used as the
+// task priority (capped below configMAX_PRIORITIES).
+void *watchdog_timer_create(z_wdt_ctx_t *ctx, int priority, bool external) {
+    if (!external) {
+        return timer_create_task(ctx, priority > 0 ? (UBaseType_t)priority : WATCHDOG_TASK_PRIORITY, false);
+    }
+    
+    struct watchdog_timer *timer = pvPortMalloc(sizeof(*timer));
+    if (timer != NULL) {
+        timer->ctx = ctx;
+        timer->task = NULL;
+        timer->exited = NULL;
+        timer->deadline = INT64_MAX;
+        timer->running = true;
+        timer->external = true;
+        timer->critical = false;
+    }
+    return timer;
+}
+
+// Start the task expiring a context's critical shard, by default at the
+// highest priority. On SMP kernels with core affinity it is pinned to the
+// cpus mask; memory is never paged, so there is nothing to lock.
+void *watchdog_timer_create_critical(z_wdt_ctx_t *ctx, int priority, uint64_t cpus) {
+    struct watchdog_timer *timer =
+        timer_create_task(ctx, priority > 0 ? (UBaseType_t)priority : WATCHDOG_CRITICAL_TASK_PRIORITY, true);
+#if defined(configUSE_CORE_AFFINITY) && configUSE_CORE_AFFINITY && configNUMBER_OF_CORES > 1
+    if (timer != NULL && cpus != 0) {
+        vTaskCoreAffinitySet(timer->task, (UBaseType_t)cpus);
+    }
+#else
+    (void)cpus;
+#endif
+    return timer;
+}
+
+// Stop a context's timer task and wait for it to exit
+void watchdog_timer_destroy(void *handle) {
+    struct watchdog_timer *timer = handle;
+    if (timer == NULL) {
+        return;
+    }
+    
+    if (!timer->external) {
+        taskENTER_CRITICAL();
+        timer->running = false;
+        taskEXIT_CRITICAL();
+        xTaskNotifyGive(timer->task);
+        xSemaphoreTake(timer->exited, portMAX_DELAY);
+        vSemaphoreDelete(timer->exited);
+    }
+    vPortFree(timer);
+}
+
+// No descriptors; an external loop waits for z_wdt_ctx_next_deadline()
+int watchdog_timer_fd(void *timer) {
+    (void)timer;
+    return -1;
+}
+
+void watchdog_log(const char *level, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    
+    printf("[%lu] [%s] ", (unsigned long)xTaskGetTickCount(), level);
+    vprintf(format, args);
+    printf("\n");
+    
+    va_end(args);
+}
+
+// Wake the log task to drain queued records
+void watchdog_log_wake(void) {
+    xTaskNotifyGive(log_task);
+}
+
+// Log task: drain whenever notified, and once more on exit
+static void log_task_func(void *arg) {
+    (void)arg;
+    
+    while (log_task_running) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        z_wdt_log_drain();
+    }
+    z_wdt_log_drain();
+    
+    xSemaphoreGive(log_exited);
+    vTaskDelete(NULL);
+}
+
+int watchdog_log_start(void) {
+    log_exited = xSemaphoreCreateBinary();
+    if (log_exited == NULL) {
+        return -1;
+    }
+    
+    log_task_running = true;
+    if (xTaskCreate(log_task_func, "wdt_log", WATCHDOG_TASK_STACK, NULL, tskIDLE_PRIORITY + 1, &log_task) != pdPASS) {
+        log_task_running = false;
+        vSemaphoreDelete(log_exited);
+        watchdog_log("ERROR", "Failed to create log task");
+        return -1;
+    }
+    return 0;
+}
+
+void watchdog_log_stop(void) {
+    if (log_task_running) {
+        log_task_running = false;
+        xTaskNotifyGive(log_task);
+        xSemaphoreTake(log_exited, portMAX_DELAY);
+        vSemaphoreDelete(log_exited);
+    }
+}
+
+int watchdog_os_init(void) {
+    return 0;
+}
+
+void watchdog_os_cleanup(void) {
+}
+
+// Mutex operations (one mutex per shard plus the timer's)
+void *watchdog_mutex_create(void) {
+    return xSemaphoreCreateMutex();
+}
+
+void watchdog_mutex_destroy(void *mutex) {
+    if (mutex != NULL) {
+        vSemaphoreDelete((SemaphoreHandle_t)mutex);
+    }
+}
+
+void watchdog_mutex_lock(void *mutex) {
+    xSemaphoreTake((SemaphoreHandle_t)mutex, portMAX_DELAY);
+}
+
+void watchdog_mutex_unlock(void *mutex) {
+    xSemaphoreGive((SemaphoreHandle_t)mutex);
+}
+
+// Number identifying the calling task or its core, for shard placement
+uint32_t watchdog_shard_hint(z_wdt_shard_policy policy) {
+#if defined(configNUMBER_OF_CORES) && configNUMBER_OF_CORES > 1
+    if (policy == Z_WDT_SHARD_BY_CPU) {
+        return (uint32_t)portGET_CORE_ID();
+    }
+#else
+    (void)policy;
+#endif
+    
+    // Task handles are aligned addresses; mix them before the modulo
+    uint64_t id = (uint64_t)(uintptr_t)xTaskGetCurrentTaskHandle();
+    id *= 0x9E3779B97F4A7C15ull;
+    return (uint32_t)(id >> 32);
+}
+
+// Worker task: run queued callbacks until handed the stop job
+static void dispatch_worker_func(void *arg) {
+    struct watchdog_dispatch_pool *pool = arg;
+    struct dispatch_job job;
+    
+    while (xQueueReceive(pool->queue, &job, portMAX_DELAY) == pdPASS && job.callback != NULL) {
+        job.callback(job.channel_id, job.user_data);
+    }
+    
+    xSemaphoreGive(pool->exited);
+    vTaskDelete(NULL);
+}
+
+// Start a callback worker pool
+void *watchdog_dispatch_create(uint32_t workers) {
+    struct watchdog_dispatch_pool *pool = pvPortMalloc(sizeof(*pool));
+    if (pool == NULL) {
+        return NULL;
+    }
+    
+    pool->worker_count = 0;
+    pool->queue = xQueueCreate(DISPATCH_QUEUE_SIZE, sizeof(struct dispatch_job));
+    pool->exited = xSemaphoreCreateCounting(workers, 0);
+    if (pool->queue == NULL || pool->exited == NULL) {
+        watchdog_dispatch_destroy(pool);
+        return NULL;
+    }
+    
+    for (; pool->worker_count < workers; pool->worker_count++) {
+        if (xTaskCreate(dispatch_worker_func, "wdt_cb", WATCHDOG_TASK_STACK, pool,
+                        WATCHDOG_TASK_PRIORITY, NULL) != pdPASS) {
+            watchdog_dispatch_destroy(pool);
+            return NULL;
+        }
+    }
+    
+    return pool;
+}
+
+// Queue a callback for the pool; runs it on the caller if the queue is full
+void watchdog_dispatch_submit(void *handle, watchdog_callback_t callback, int channel_id, void *user_data) {
+    struct watchdog_dispatch_pool *pool = handle;
+    struct dispatch_job job = { callback, channel_id, user_data };
+    
+    if (xQueueSend(pool->queue, &job, 0) != pdPASS) {
+        watchdog_log("WARN", "Dispatch queue full, running callback for channel %d inline", channel_id);
+        callback(channel_id, user_data);
+    }
+}
+
+// Stop a pool once every queued callback has run
+void watchdog_dispatch_destroy(void *handle) {
+    struct watchdog_dispatch_pool *pool = handle;
+    struct dispatch_job stop = { NULL, -1, NULL };
+    
+    // Stop jobs queue behind the pending callbacks
+    for (uint32_t i = 0; i < pool->worker_count; i++) {
+        xQueueSend(pool->queue, &stop, portMAX_DELAY);
+    }
+    for (uint32_t i = 0; i < pool->worker_count; i++) {
+        xSemaphoreTake(pool->exited, portMAX_DELAY);
+    }
+    
+    if (pool->exited != NULL) {
+        vSemaphoreDelete(pool->exited);
+    }
+    if (pool->queue != NULL) {
+        vQueueDelete(pool->queue);
+    }
+    vPortFree(pool);
+}
+
+// Hardware watchdog through board hooks (define WATCHDOG_HW_BOARD), e.g. an
+// STM32 IWDG: start it with the prescaler/reload closest to *timeout_ms,
+// report the real timeout, and reload it (KR = 0xAAAA) on each kick.
+// board_hw_watchdog_stop() may do nothing on devices that can't be stopped.
+#ifdef WATCHDOG_HW_BOARD
+extern int board_hw_watchdog_start(uint32_t *timeout_ms);
+extern void board_hw_watchdog_kick(void);
+extern void board_hw_watchdog_stop(void);
+#endif
+
+int watchdog_hw_open(uint32_t *timeout_ms) {
+#ifdef WATCHDOG_HW_BOARD
+    return board_hw_watchdog_start(timeout_ms);
+#else
+    (void)timeout_ms;
+    return -1;
+#endif
+}
+
+void watchdog_hw_pet(void) {
+#ifdef WATCHDOG_HW_BOARD
+    board_hw_watchdog_kick();
+#endif
+}
+
+void watchdog_hw_close(void) {
+#ifdef WATCHDOG_HW_BOARD
+    board_hw_watchdog_stop();
+#endif
+}
+
+// Single address space: no shared-memory supervision (z_wdt_shm_create() fails)
+void *watchdog_shm_map(const char *name, size_t *size, bool create) {
+    (void)name;
+    (void)size;
+    (void)create;
+    return NULL;
+}
+
+void watchdog_shm_unmap(void *region, size_t size) {
+    (void)region;
+    (void)size;
+}
+
+void watchdog_shm_unlink(const char *name) {
+    (void)name;
+}
+
+void watchdog_shm_wait(uint32_t *word, uint32_t value, uint64_t timeout_ns) {
+    (void)word;
+    (void)value;
+    (void)timeout_ns;
+}
+
+void watchdog_shm_wake(uint32_t *word) {
+    (void)word;
+}
+
+int32_t watchdog_process_id(void) {
+    return 0;
+}
+
+bool watchdog_process_alive(int32_t pid) {
+    (void)pid;
+    return true;
+}
+
+// Hard reset: mask interrupts and spin, so the scheduler stops and the
+// hardware watchdog, no longer petted, resets the MCU. Boards that should
+// reset at once define WATCHDOG_RESET_BOARD, e.g. for NVIC_SystemReset().
+#ifdef WATCHDOG_RESET_BOARD
+extern void board_system_reset(void);
+#endif
+
+void watchdog_system_reset(void) {
+#ifdef WATCHDOG_RESET_BOARD
+    board_system_reset();
+#endif
+    taskDISABLE_INTERRUPTS();
+    for (;;) {
+    }
+}
+
+// Task handle of the caller, for the flight recorder (low bits of its address)
+uint32_t watchdog_thread_id(void) {
+    return (uint32_t)(uintptr_t)xTaskGetCurrentTaskHandle();
+}
+
+// No file system: recorders live in memory (a recorder_path fails)
+void *watchdog_recorder_map(const char *path, size_t *size, bool create) {
+    (void)path;
+    (void)size;
+    (void)create;
+    return NULL;
+}
+
+void watchdog_recorder_unmap(void *region, size_t size) {
+    (void)region;
+    (void)size;
+}
+
+void watchdog_recorder_sync(void *region, size_t size) {
+    (void)region;
+    (void)size;
+}
@@ -0,0 +1,412 @@
+/*
+ * Watchdog OS Abstraction Layer - Mock
+ * Test platform with a virtual clock and no threads. Time only moves in
+ * watchdog_mock_set_ticks() / watchdog_mock_advance(), and the latter
+ * runs each context's z_wdt_ctx_process() exactly at its armed deadline,
+ * so timeout scenarios are deterministic and take no wall-clock time.
+ *
+ * Everything runs on the calling thread: mutexes only check that they are
+ * never taken twice (which would deadlock a real platform), dispatch pools
+ * run callbacks inline and the log sink drops messages unless the
+ * WATCHDOG_MOCK_LOG environment variable is set. Shared-memory regions are
+ * heap blocks found by name, the process ID is whatever the test sets, and
+ * the supervisor's wait advances the clock to its timeout.
+ */
+
+#include "z_wdt_internal.h"
+#include "watchdog_os_mock.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+
+#define MOCK_MAX_TIMERS 64
+#define MOCK_MAX_REGIONS 4
+#define MOCK_MAX_EXITED 16
+#define MOCK_MAX_FILES 4
+
+// Timer object: the context's armed deadline
+struct watchdog_timer {
+    z_wdt_ctx_t *ctx;
+    int64_t deadline;
+    bool used;
+    bool external;                     // Left to the test, like an external loop
+    bool critical;                     // Runs z_wdt_ctx_process_critical()
+};
+
+// Mutex object: held flag checking for self-deadlock
+struct watchdog_mutex {
+    bool held;
+};
+
+static struct watchdog_timer g_timers[MOCK_MAX_TIMERS];
+static int64_t g_ticks = 1000000;      // Virtual clock, away from zero
+static int g_dispatch_pool;            // Non-NULL handle for inline dispatch
+static bool g_log_enabled;
+
+// Named shared-memory region
+struct mock_region {
+    char name[Z_WDT_SHM_NAME_MAX];
+    void *memory;
+    size_t size;
+};
+
+static struct mock_region g_regions[MOCK_MAX_REGIONS];
+static struct mock_region g_files[MOCK_MAX_FILES];  // Flight recorder files, kept like a disk
+static uint32_t g_thread = 1;
+static int32_t g_pid = 1;
+static int32_t g_exited[MOCK_MAX_EXITED];
+static uint32_t g_exited_count;
+
+static bool g_hw_active;
+static uint32_t g_hw_timeout;
+static uint32_t g_hw_pets;
+static int64_t g_hw_last_pet;         // Tick of the last pet, or of the open
+static int64_t g_hw_longest_gap;      // Longest stretch without a pet, in ticks
+static uint32_t g_resets;              // watchdog_system_reset() calls, which return here
+
+int64_t watchdog_get_ticks(void) {
+    return g_ticks;
+}
+
+uint64_t watchdog_get_ns(void) {
+    return (uint64_t)g_ticks / WATCHDOG_TICK_HZ * 1000000000 +
+           (uint64_t)g_ticks % WATCHDOG_TICK_HZ * 1000000000 / WATCHDOG_TICK_HZ;
+}
+
+void watchdog_mock_set_ticks(int64_t ticks) {
+    g_ticks = ticks;
+}
+
+// Earliest due timer at or before the limit (NULL if none)
+static struct watchdog_timer *mock_due_timer(int64_t limit) {
+    struct watchdog_timer *due = NULL;
+    for (uint32_t i = 0; i < MOCK_MAX_TIMERS; i++) {
+        struct watchdog_timer *timer = &g_timers[i];
+        if (timer->used && !timer->external && timer->deadline <= limit &&
+            (due == NULL || timer->deadline < due->deadline)) {
+            due = timer;
+        }
+    }
+    return due;
+}
+
+void watchdog_mock_advance(int64_t ticks) {
+    int64_t target = g_ticks + ticks;
+
+    for (struct watchdog_timer *timer; (timer = mock_due_timer(target)) != NULL;) {
+        if (timer->deadline > g_ticks) {
+            g_ticks = timer->deadline;
+        }
+        // Consume the deadline; z_wdt_ctx_process() re-arms the next one
+        timer->deadline = INT64_MAX;
+        if (timer->critical) {
+            z_wdt_ctx_process_critical(timer->ctx);
+        } else {
+            z_wdt_ctx_process(timer->ctx);
+        }
+    }
+    g_ticks = target;
+}
+
+int64_t watchdog_mock_next_timer(void) {
+    struct watchdog_timer *timer = mock_due_timer(INT64_MAX - 1);
+    return timer != NULL ? timer->deadline : INT64_MAX;
+}
+
+void watchdog_timer_start(void *handle, int64_t timeout_ticks) {
+    ((struct watchdog_timer *)handle)->deadline = timeout_ticks;
+}
+
+void watchdog_timer_stop(void *handle) {
+    ((struct watchdog_timer *)handle)->deadline = INT64_MAX;
+}
+
+void *watchdog_timer_create(z_wdt_ctx_t *ctx, int priority, bool external) {
+    (void)priority;
+
+    for (uint32_t i = 0; i < MOCK_MAX_TIMERS; i++) {
+        struct watchdog_timer *timer = &g_timers[i];
+        if (!timer->used) {
+            timer->ctx = ctx;
+            timer->deadline = INT64_MAX;
+            timer->external = external;
+            timer->critical = false;
+            timer->used = true;
+            return timer;
+        }
+    }
+    return NULL;
+}
+
+// A timer like any other; the clock is virtual, so there is nothing to pin or lock
+void *watchdog_timer_create_critical(z_wdt_ctx_t *ctx, int priority, uint64_t cpus) {
+    (void)cpus;
+
+    struct watchdog_timer *timer = watchdog_timer_create(ctx, priority, false);
+    if (timer != NULL) {
+        timer->critical = true;
+    }
+    return timer;
+}
+
+void watchdog_timer_destroy(void *handle) {
+    struct watchdog_timer *timer = handle;
+    if (timer != NULL) {
+        timer->used = false;
+    }
+}
+
+// No descriptors; external contexts are driven through z_wdt_ctx_next_deadline()
+int watchdog_timer_fd(void *timer) {
+    (void)timer;
+    return -1;
+}
+
+void watchdog_log(const char *level, const char *format, ...) {
+    if (!g_log_enabled) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, format);
+    printf("[%lld] [%s] ", (long long)g_ticks, level);
+    vprintf(format, args);
+    printf("\n");
+    va_end(args);
+}
+
+// No log thread: drain on the caller
+void watchdog_log_wake(void) {
+    z_wdt_log_drain();
+}
+
+int watchdog_log_start(void) {
+    return 0;
+}
+
+void watchdog_log_stop(void) {
+}
+
+int watchdog_os_init(void) {
+    g_log_enabled = getenv("WATCHDOG_MOCK_LOG") != NULL;
+    return 0;
+}
+
+void watchdog_os_cleanup(void) {
+}
+
+void *watchdog_mutex_create(void) {
+    return calloc(1, sizeof(struct watchdog_mutex));
+}
+
+void watchdog_mutex_destroy(void *mutex) {
+    free(mutex);
+}
+
+void watchdog_mutex_lock(void *handle) {
+    struct watchdog_mutex *mutex = handle;
+    if (mutex->held) {
+        fprintf(stderr, "watchdog_os_mock: mutex %p locked twice\n", handle);
+        abort();
+    }
+    mutex->held = true;
+}
+
+void watchdog_mutex_unlock(void *handle) {
+    struct watchdog_mutex *mutex = handle;
+    if (!mutex->held) {
+        fprintf(stderr, "watchdog_os_mock: mutex %p unlocked while free\n", handle);
+        abort();
+    }
+    mutex->held = false;
+}
+
+// Rotate through the shards so multi-shard placement gets exercised
+uint32_t watchdog_shard_hint(z_wdt_shard_policy policy) {
+    static uint32_t hint;
+    (void)policy;
+    return hint++;
+}
+
+void *watchdog_dispatch_create(uint32_t workers) {
+    (void)workers;
+    return &g_dispatch_pool;
+}
+
+void watchdog_dispatch_submit(void *pool, watchdog_callback_t callback, int channel_id, void *user_data) {
+    (void)pool;
+    callback(channel_id, user_data);
+}
+
+void watchdog_dispatch_destroy(void *pool) {
+    (void)pool;
+}
+
+int watchdog_hw_open(uint32_t *timeout_ms) {
+    g_hw_active = true;
+    g_hw_timeout = *timeout_ms;
+    g_hw_pets = 0;
+    g_hw_last_pet = g_ticks;
+    g_hw_longest_gap = 0;
+    return 0;
+}
+
+void watchdog_hw_pet(void) {
+    g_hw_pets++;
+    if (g_ticks - g_hw_last_pet > g_hw_longest_gap) {
+        g_hw_longest_gap = g_ticks - g_hw_last_pet;
+    }
+    g_hw_last_pet = g_ticks;
+}
+
+void watchdog_hw_close(void) {
+    g_hw_active = false;
+}
+
+bool watchdog_mock_hw_active(void) {
+    return g_hw_active;
+}
+
+uint32_t watchdog_mock_hw_timeout(void) {
+    return g_hw_timeout;
+}
+
+uint32_t watchdog_mock_hw_pets(void) {
+    return g_hw_pets;
+}
+
+int64_t watchdog_mock_hw_longest_gap(void) {
+    return g_hw_longest_gap;
+}
+
+// Count the reset instead of ending the test run
+void watchdog_system_reset(void) {
+    g_resets++;
+}
+
+uint32_t watchdog_mock_resets(void) {
+    return g_resets;
+}
+
+void *watchdog_shm_map(const char *name, size_t *size, bool create) {
+    struct mock_region *free_region = NULL;
+
+    for (uint32_t i = 0; i < MOCK_MAX_REGIONS; i++) {
+        struct mock_region *region = &g_regions[i];
+        if (region->memory == NULL) {
+            free_region = free_region ? free_region : region;
+        } else if (strcmp(region->name, name) == 0) {
+            if (create) {
+                return NULL;
+            }
+            *size = region->size;
+            return region->memory;
+        }
+    }
+    if (!create || free_region == NULL || (free_region->memory = calloc(1, *size)) == NULL) {
+        return NULL;
+    }
+    strncpy(free_region->name, name, sizeof(free_region->name) - 1);
+    free_region->size = *size;
+    return free_region->memory;
+}
+
+// Regions live until unlinked, so unmapping is a no-op
+void watchdog_shm_unmap(void *region, size_t size) {
+    (void)region;
+    (void)size;
+}
+
+void watchdog_shm_unlink(const char *name) {
+    for (uint32_t i = 0; i < MOCK_MAX_REGIONS; i++) {
+        struct mock_region *region = &g_regions[i];
+        if (region->memory != NULL && strcmp(region->name, name) == 0) {
+            free(region->memory);
+            memset(region, 0, sizeof(*region));
+        }
+    }
+}
+
+// Sleep in virtual time: the clock moves to the timeout unless woken already
+void watchdog_shm_wait(uint32_t *word, uint32_t value, uint64_t timeout_ns) {
+    if (*word == value) {
+        uint64_t ticks = (timeout_ns * WATCHDOG_TICK_HZ + 999999999) / 1000000000;
+        watchdog_mock_advance((int64_t)ticks);
+    }
+}
+
+void watchdog_shm_wake(uint32_t *word) {
+    (void)word;
+}
+
+void watchdog_mock_set_pid(int32_t pid) {
+    g_pid = pid;
+}
+
+void watchdog_mock_exit(int32_t pid) {
+    if (g_exited_count < MOCK_MAX_EXITED) {
+        g_exited[g_exited_count++] = pid;
+    }
+}
+
+int32_t watchdog_process_id(void) {
+    return g_pid;
+}
+
+bool watchdog_process_alive(int32_t pid) {
+    for (uint32_t i = 0; i < g_exited_count; i++) {
+        if (g_exited[i] == pid) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void watchdog_mock_set_thread(uint32_t thread) {
+    g_thread = thread;
+}
+
+uint32_t watchdog_thread_id(void) {
+    return g_thread;
+}
+
+// Recorder files live in memory for the whole test run, so a context's
+// file can be opened after the context is gone
+void *watchdog_recorder_map(const char *path, size_t *size, bool create) {
+    struct mock_region *free_file = NULL;
+
+    for (uint32_t i = 0; i < MOCK_MAX_FILES; i++) {
+        struct mock_region *file = &g_files[i];
+        if (file->memory == NULL) {
+            free_file = free_file ? free_file : file;
+        } else if (strcmp(file->name, path) == 0) {
+            if (create && file->size != *size) {
+                void *memory = realloc(file->memory, *size);
+                if (memory == NULL) {
+                    return NULL;
+                }
+                file->memory = memory;
+                file->size = *size;
+            }
+            *size = file->size;
+            return file->memory;
+        }
+    }
+    if (!create || free_file == NULL || (free_file->memory = calloc(1, *size)) == NULL) {
+        return NULL;
+    }
+    strncpy(free_file->name, path, sizeof(free_file->name) - 1);
+    free_file->size = *size;
+    return free_file->memory;
+}
+
+void watchdog_recorder_unmap(void *region, size_t size) {
+    (void)region;
+    (void)size;
+}
+
+void watchdog_recorder_sync(void *region, size_t size) {
+    (void)region;
+    (void)size;
+}
@@ -0,0 +1,50 @@
+/*
+ * Watchdog OS Abstraction Layer - Mock
+ * Virtual clock controls for tests linked against watchdog_os_mock.c
+ */
+
+#ifndef WATCHDOG_OS_MOCK_H
+#define WATCHDOG_OS_MOCK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Move the virtual clock to an absolute tick without running any timer */
+void watchdog_mock_set_ticks(int64_t ticks);
+
+/*
+ * Advance the virtual clock by ticks. Every timer deadline reached on the
+ * way runs its context's z_wdt_ctx_process() with the clock set to that
+ * deadline, earliest first, as a timer thread waking on time would.
+ */
+void watchdog_mock_advance(int64_t ticks);
+
+/* Earliest armed deadline of the threaded contexts (INT64_MAX if none) */
+int64_t watchdog_mock_next_timer(void);
+
+/* Process ID seen by the shared-memory calls, and processes that have exited */
+void watchdog_mock_set_pid(int32_t pid);
+void watchdog_mock_exit(int32_t pid);
+
+/* Thread ID the flight recorder sees (1 by default) */
+void watchdog_mock_set_thread(uint32_t thread);
+
+/* Mock hardware watchdog: whether it is open, its timeout, the pets so far
+   and the longest time in ticks it went without one since the open */
+bool watchdog_mock_hw_active(void);
+uint32_t watchdog_mock_hw_timeout(void);
+uint32_t watchdog_mock_hw_pets(void);
+int64_t watchdog_mock_hw_longest_gap(void);
+
+/* System resets requested so far (watchdog_system_reset() returns in the mock) */
+uint32_t watchdog_mock_resets(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WATCHDOG_OS_MOCK_H
@@ -0,0 +1,1354 @@
+/*
+ * Virtual-time tests for embedded watchdog framework
+ * Linked against the mock platform (watchdog_os_mock.c): no threads and no
+ * sleeps, so every timeout is checked to the tick and the whole suite runs
+ * in well under a second. Ends with randomized add/feed/delete/suspend
+ * sequences checked against a reference model.
+ */
+
+#include "z_wdt_internal.h"
+#include "watchdog_os_mock.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <assert.h>
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
+
+#ifndef SIM_FUZZ_STEPS
+#define SIM_FUZZ_STEPS 200000          // Random operations per fuzz configuration
+#endif
+#ifdef WATCHDOG_STATIC_CHANNELS
+// A static table ignores max_channels; the slack test adds eight channels
+#if WATCHDOG_MAX_CHANNELS < 8
+#error "The simulation tests need MAX_CHANNELS=8 or more with STATIC_CHANNELS=1"
+#endif
+#define SIM_FUZZ_CHANNELS WATCHDOG_MAX_CHANNELS
+#define SIM_SCALE_CHANNELS WATCHDOG_MAX_CHANNELS
+#else
+#define SIM_FUZZ_CHANNELS 256
+#define SIM_SCALE_CHANNELS 20000
+#endif
+#define SIM_CHANNELS 16                // Table for the tests that add a few channels at a time
+
+// Timeouts seen by record_callback
+static int recorded_count = 0;
+static int recorded_channel = -1;
+static int64_t recorded_at = 0;
+
+static void record_callback(int channel_id, void *user_data) {
+    (void)user_data;
+    recorded_count++;
+    recorded_channel = channel_id;
+    recorded_at = z_wdt_now();
+}
+
+static void reset_recorded(void) {
+    recorded_count = 0;
+    recorded_channel = -1;
+    recorded_at = 0;
+}
+
+// Default context sized for the test rather than WATCHDOG_MAX_CHANNELS,
+// so a build with a small table (make MAX_CHANNELS=4) still runs it
+static int sim_init(void) {
+    z_wdt_config config = { .max_channels = SIM_CHANNELS };
+    return z_wdt_init_ex(&config);
+}
+
+// Reload period in ticks, as the core rounds it
+static int64_t sim_ticks(uint32_t ms) {
+    return ((int64_t)ms * WATCHDOG_TICK_HZ + 999) / 1000;
+}
+
+// Test that a timeout fires exactly one period after the add, for many periods
+void test_sim_timeout_exact(void) {
+    printf("\n=== Testing Exact Timeouts ===\n");
+
+    for (uint32_t period = 1; period <= 300; period++) {
+        assert(sim_init() == 0);
+        reset_recorded();
+        int64_t start = z_wdt_now();
+        int channel = z_wdt_add(period, record_callback, NULL);
+        assert(channel >= 0);
+
+        watchdog_mock_advance(sim_ticks(period) - 1);
+        assert(recorded_count == 0);
+        watchdog_mock_advance(1);
+        assert(recorded_count == 1 && recorded_channel == channel);
+        assert(recorded_at == start + sim_ticks(period));
+        assert(z_wdt_feed(channel) == -1);
+        z_wdt_cleanup();
+    }
+    printf("✓ 300 periods timed out on their exact tick\n");
+}
+
+// Test that feeding keeps a channel alive and the timeout follows the last feed
+void test_sim_feed(void) {
+    printf("\n=== Testing Feeds ===\n");
+
+    assert(sim_init() == 0);
+    reset_recorded();
+    int channel = z_wdt_add(100, record_callback, NULL);
+    assert(channel >= 0);
+
+    for (int i = 0; i < 1000; i++) {
+        watchdog_mock_advance(sim_ticks(100) - 1);
+        assert(z_wdt_feed(channel) == 0);
+    }
+    assert(recorded_count == 0);
+    int64_t last_feed = z_wdt_now();
+    watchdog_mock_advance(sim_ticks(1000));
+    assert(recorded_count == 1 && recorded_at == last_feed + sim_ticks(100));
+    printf("✓ 1000 feeds one tick before the deadline, then a timeout one period after the last\n");
+
+    z_wdt_cleanup();
+}
+
+// Test that a feeder holding a stale handle can't move the deadline of the
+// slot's next owner: it resolves a channel, stalls while the channel is
+// deleted and the slot re-added, then completes its feed
+void test_sim_stale_feed(void) {
+    printf("\n=== Testing Stale Feeds on a Reused Slot ===\n");
+
+    assert(sim_init() == 0);
+    reset_recorded();
+    struct watchdog_context *ctx = z_wdt_default();
+    int stale = z_wdt_add(60000, record_callback, NULL);
+    assert(stale >= 0);
+
+    // What a feeder has resolved before it stalls
+    struct watchdog_shard *shard = &ctx->shards[watchdog_handle_shard(stale)];
+    int index = (int)((uint32_t)stale & WATCHDOG_INDEX_MASK);
+    struct watchdog_channel *channel = watchdog_table_lookup(&shard->table, (uint32_t)index);
+    uint32_t generation = WATCHDOG_LOAD_ACQUIRE(&channel->generation);
+
+    // Delete it and cycle the free list until a short-period channel gets the slot
+    assert(z_wdt_delete(stale) == 0);
+    int reused = -1;
+    for (int i = 0; i < 4 * WATCHDOG_MAX_CHANNELS && reused < 0; i++) {
+        int id = z_wdt_add(100, record_callback, NULL);
+        assert(id >= 0);
+        if (watchdog_handle_shard(id) == watchdog_handle_shard(stale) &&
+            (int)((uint32_t)id & WATCHDOG_INDEX_MASK) == index) {
+            reused = id;
+        } else {
+            assert(z_wdt_delete(id) == 0);
+        }
+    }
+    assert(reused >= 0 && reused != stale);
+    int64_t added_at = z_wdt_now();
+
+    // The stalled feed completes halfway through the new owner's period
+    watchdog_mock_advance(sim_ticks(50));
+    assert(watchdog_feed_deadline(ctx, shard, channel, index, generation, z_wdt_now(), false) == -1);
+    assert(z_wdt_feed(stale) == -1);
+    assert(WATCHDOG_LOAD(WATCHDOG_TIMEOUT(shard, index)) == added_at + sim_ticks(100));
+
+    watchdog_mock_advance(sim_ticks(50) - 1);
+    assert(recorded_count == 0);
+    watchdog_mock_advance(1);
+    assert(recorded_count == 1 && recorded_channel == reused && recorded_at == added_at + sim_ticks(100));
+    printf("✓ Stale feed failed and left the reused slot's deadline alone\n");
+
+    z_wdt_cleanup();
+}
+
+// Test that a suspended watchdog never fires and resume restarts every period
+void test_sim_suspend_resume(void) {
+    printf("\n=== Testing Suspend/Resume ===\n");
+
+    assert(sim_init() == 0);
+    reset_recorded();
+    int channel = z_wdt_add(100, record_callback, NULL);
+    assert(channel >= 0);
+
+    watchdog_mock_advance(sim_ticks(50));
+    z_wdt_suspend();
+    assert(watchdog_mock_next_timer() == INT64_MAX);
+    watchdog_mock_advance(sim_ticks(10000));
+    assert(recorded_count == 0);
+
+    int64_t resumed = z_wdt_now();
+    z_wdt_resume();
+    watchdog_mock_advance(sim_ticks(100) - 1);
+    assert(recorded_count == 0);
+    watchdog_mock_advance(1);
+    assert(recorded_count == 1 && recorded_at == resumed + sim_ticks(100));
+    printf("✓ Nothing fired while suspended, timeout one period after resume\n");
+
+    z_wdt_cleanup();
+}
+
+// Resume-time checks: when each channel fired, against when it should have
+static int64_t resume_expected[SIM_SCALE_CHANNELS];
+static int resume_fired = 0;
+static int resume_wrong = 0;
+
+static void resume_callback(int channel_id, void *user_data) {
+    (void)channel_id;
+    resume_fired++;
+    if (z_wdt_now() != resume_expected[(intptr_t)user_data]) {
+        resume_wrong++;
+    }
+}
+
+// Test that global resume counts as a feed of every channel without
+// touching them: fed-after-resume channels keep their deadline, the rest
+// time out one period after the resume, past or future deadline alike
+void test_sim_resume_epoch(void) {
+    printf("\n=== Testing Resume Epoch ===\n");
+
+    static const int64_t windows[] = { 10000, 20 };
+    z_wdt_config config = { .max_channels = SIM_SCALE_CHANNELS };
+    for (size_t w = 0; w < sizeof(windows) / sizeof(windows[0]); w++) {
+        assert(z_wdt_init_ex(&config) == 0);
+        resume_fired = 0;
+        resume_wrong = 0;
+        int ids[SIM_SCALE_CHANNELS];
+        for (int i = 0; i < SIM_SCALE_CHANNELS; i++) {
+            ids[i] = z_wdt_add(100 + (uint32_t)i % 50, resume_callback, (void *)(intptr_t)i);
+            assert(ids[i] >= 0);
+        }
+        watchdog_mock_advance(sim_ticks(30));
+        for (int i = 0; i < SIM_SCALE_CHANNELS; i += 2) {
+            assert(z_wdt_feed(ids[i]) == 0);
+        }
+        watchdog_mock_advance(sim_ticks(10));
+        z_wdt_suspend();
+        watchdog_mock_advance(sim_ticks(windows[w]));
+
+        int64_t resumed = z_wdt_now();
+        z_wdt_resume();
+        for (int i = 0; i < SIM_SCALE_CHANNELS; i++) {
+            resume_expected[i] = resumed + sim_ticks(100 + (uint32_t)i % 50);
+        }
+        watchdog_mock_advance(sim_ticks(20));
+        for (int i = 0; i < SIM_SCALE_CHANNELS; i += 3) {
+            assert(z_wdt_feed(ids[i]) == 0);
+            resume_expected[i] = z_wdt_now() + sim_ticks(100 + (uint32_t)i % 50);
+        }
+        watchdog_mock_advance(sim_ticks(1000));
+        assert(resume_fired == SIM_SCALE_CHANNELS && resume_wrong == 0);
+        z_wdt_cleanup();
+    }
+    printf("✓ %d channels timed out one period after resume or their later feed\n", SIM_SCALE_CHANNELS);
+}
+
+// Test suspending single channels and groups while the rest keep running
+void test_sim_channel_suspend(void) {
+    printf("\n=== Testing Channel Suspend/Resume ===\n");
+
+    assert(sim_init() == 0);
+    reset_recorded();
+    int paused = z_wdt_add(100, record_callback, NULL);
+    int running = z_wdt_add(100, record_callback, NULL);
+    assert(paused >= 0 && running >= 0);
+
+    watchdog_mock_advance(sim_ticks(50));
+    assert(z_wdt_channel_suspend(paused) == 0);
+    assert(z_wdt_channel_suspend(paused) == 0);
+    assert(z_wdt_feed(paused) == 0);
+    watchdog_mock_advance(sim_ticks(1000));
+    assert(recorded_count == 1 && recorded_channel == running);
+
+    // A global suspend window doesn't wake a suspended channel either
+    z_wdt_suspend();
+    watchdog_mock_advance(sim_ticks(1000));
+    z_wdt_resume();
+    watchdog_mock_advance(sim_ticks(1000));
+    assert(recorded_count == 1);
+
+    int64_t resumed = z_wdt_now();
+    assert(z_wdt_channel_resume(paused) == 0);
+    assert(z_wdt_channel_resume(paused) == 0);
+    watchdog_mock_advance(sim_ticks(100) - 1);
+    assert(recorded_count == 1);
+    watchdog_mock_advance(1);
+    assert(recorded_count == 2 && recorded_channel == paused && recorded_at == resumed + sim_ticks(100));
+    assert(z_wdt_channel_suspend(paused) == -1);
+    assert(z_wdt_channel_resume(-1) == -1);
+    printf("✓ Suspended channel skipped its timeout and got a full period on resume\n");
+
+    // A suspended group parks its members, even one resumed on its own
+    reset_recorded();
+    int group = z_wdt_group_create(record_callback, NULL);
+    int fast = z_wdt_group_add(group, 100, NULL, NULL);
+    int slow = z_wdt_group_add(group, 200, NULL, NULL);
+    assert(group >= 0 && fast >= 0 && slow >= 0);
+    watchdog_mock_advance(sim_ticks(50));
+    assert(z_wdt_channel_suspend(group) == 0);
+    assert(z_wdt_channel_suspend(fast) == 0);
+    assert(z_wdt_channel_resume(fast) == 0);
+    int late = z_wdt_group_add(group, 50, NULL, NULL);
+    assert(late >= 0);
+    watchdog_mock_advance(sim_ticks(1000));
+    assert(recorded_count == 0);
+
+    resumed = z_wdt_now();
+    assert(z_wdt_channel_resume(group) == 0);
+    watchdog_mock_advance(sim_ticks(50) - 1);
+    assert(recorded_count == 0);
+    watchdog_mock_advance(1);
+    assert(recorded_count == 1 && recorded_channel == group && recorded_at == resumed + sim_ticks(50));
+    assert(z_wdt_feed(slow) == -1);
+
+    // A suspended member drops out of its group's deadline until resumed
+    reset_recorded();
+    group = z_wdt_group_create(record_callback, NULL);
+    fast = z_wdt_group_add(group, 100, NULL, NULL);
+    slow = z_wdt_group_add(group, 300, NULL, NULL);
+    assert(z_wdt_channel_suspend(fast) == 0);
+    watchdog_mock_advance(sim_ticks(200));
+    assert(z_wdt_feed(slow) == 0);
+    watchdog_mock_advance(sim_ticks(300) - 1);
+    assert(recorded_count == 0);
+    assert(z_wdt_channel_resume(fast) == 0);
+    watchdog_mock_advance(1);
+    assert(recorded_count == 1 && recorded_channel == group);
+    printf("✓ Group suspend parks all members; member suspend leaves the group running\n");
+
+    z_wdt_cleanup();
+}
+
+// Test that slack keeps timeouts inside their window and shares wakeups
+void test_sim_slack(void) {
+    printf("\n=== Testing Slack ===\n");
+
+    assert(sim_init() == 0);
+    for (int offset = 0; offset < 200; offset++) {
+        reset_recorded();
+        int64_t start = z_wdt_now();
+        assert(z_wdt_add_ex(100, 30, record_callback, NULL) >= 0);
+        watchdog_mock_advance(sim_ticks(200));
+        assert(recorded_count == 1);
+        assert(recorded_at >= start + sim_ticks(100) && recorded_at <= start + sim_ticks(100) + sim_ticks(30));
+        watchdog_mock_advance(1 + offset % 7);
+    }
+    printf("✓ 200 timeouts inside [period, period + slack]\n");
+
+    // Eight overlapping windows wider than 32 ticks span at most two boundaries
+    reset_recorded();
+    int wakeups = 0;
+    int seen = 0;
+    for (uint32_t i = 0; i < 8; i++) {
+        assert(z_wdt_add_ex(100 + i, 40, record_callback, NULL) >= 0);
+    }
+    while (recorded_count < 8) {
+        int64_t next = watchdog_mock_next_timer();
+        assert(next != INT64_MAX);
+        watchdog_mock_advance(next - z_wdt_now());
+        if (recorded_count != seen) {
+            wakeups++;
+            seen = recorded_count;
+        }
+    }
+    assert(wakeups <= 2);
+    printf("✓ 8 timeouts coalesced into %d wakeup(s)\n", wakeups);
+
+    z_wdt_cleanup();
+}
+
+// Test the hardware watchdog pet schedule and the trip on a timeout
+void test_sim_hardware_watchdog(void) {
+    printf("\n=== Testing Hardware Watchdog ===\n");
+
+    assert(sim_init() == 0);
+    reset_recorded();
+    assert(z_wdt_hw_enable(2000) == 0);
+    assert(watchdog_mock_hw_active() && watchdog_mock_hw_timeout() == 2000);
+
+    // One pet on enable, then one every half timeout
+    watchdog_mock_advance(sim_ticks(10000));
+    assert(watchdog_mock_hw_pets() == 11);
+    printf("✓ Petted on enable and every half timeout\n");
+
+    int channel = z_wdt_add(500, record_callback, NULL);
+    assert(channel >= 0);
+    watchdog_mock_advance(sim_ticks(500));
+    assert(recorded_count == 1);
+    uint32_t pets = watchdog_mock_hw_pets();
+    watchdog_mock_advance(sim_ticks(10000));
+    assert(watchdog_mock_hw_pets() == pets);
+    printf("✓ Petting stopped after a channel timed out\n");
+
+    z_wdt_hw_disable();
+    assert(!watchdog_mock_hw_active());
+    z_wdt_cleanup();
+
+    // The pet channel takes no slack, whatever the context's default
+    z_wdt_config slack_config = { .default_slack = 600 };
+    assert(z_wdt_init_ex(&slack_config) == 0);
+    assert(z_wdt_hw_enable(1000) == 0);
+    watchdog_mock_advance(sim_ticks(10000));
+    assert(watchdog_mock_hw_pets() == 21);
+    assert(watchdog_mock_hw_longest_gap() == sim_ticks(500));
+    printf("✓ Petted every half timeout with a default slack of 600ms\n");
+
+    z_wdt_hw_disable();
+    z_wdt_cleanup();
+
+    // Wakeups rounded up to half the timeout or more could trip the device
+    z_wdt_config coarse_config = { .timer_resolution = 500 };
+    assert(z_wdt_init_ex(&coarse_config) == 0);
+    assert(z_wdt_hw_enable(1000) == -1);
+    assert(!watchdog_mock_hw_active());
+    z_wdt_cleanup();
+
+    coarse_config.timer_resolution = 300;
+    assert(z_wdt_init_ex(&coarse_config) == 0);
+    assert(z_wdt_hw_enable(1000) == 0);
+    watchdog_mock_advance(sim_ticks(10000));
+    assert(watchdog_mock_hw_longest_gap() < sim_ticks(1000));
+    printf("✓ Rejected a timer_resolution of half the timeout, pets in time below it\n");
+
+    z_wdt_hw_disable();
+    z_wdt_cleanup();
+}
+
+// Test driving an external loop context from its published deadline
+void test_sim_external_loop(void) {
+    printf("\n=== Testing External Loop ===\n");
+
+    z_wdt_config config = { .external_loop = 1 };
+    z_wdt_ctx_t *ctx = z_wdt_create(&config);
+    assert(ctx != NULL);
+    reset_recorded();
+    int64_t start = z_wdt_now();
+    assert(z_wdt_ctx_add(ctx, 250, record_callback, NULL) >= 0);
+
+    // The mock leaves external contexts alone
+    watchdog_mock_advance(sim_ticks(1000));
+    assert(recorded_count == 0);
+    while (recorded_count == 0) {
+        int64_t deadline = z_wdt_ctx_next_deadline(ctx);
+        assert(deadline != INT64_MAX);
+        if (deadline > z_wdt_now()) {
+            watchdog_mock_set_ticks(deadline);
+        }
+        z_wdt_ctx_process(ctx);
+    }
+    assert(recorded_at == start + sim_ticks(1000));
+    assert(z_wdt_ctx_next_deadline(ctx) == INT64_MAX);
+    printf("✓ Loop processed the overdue timeout\n");
+
+    z_wdt_destroy(ctx);
+}
+
+// Test that critical channels have a timer of their own, exact to the
+// tick, while best-effort channels keep the context's resolution
+void test_sim_critical_class(void) {
+    printf("\n=== Testing Critical Class ===\n");
+
+    z_wdt_config config = { .shards = 2, .critical_channels = 3, .timer_resolution = 50 };
+#if WATCHDOG_MAX_SHARDS > 2
+    z_wdt_ctx_t *ctx = z_wdt_create(&config);
+    assert(ctx != NULL);
+    reset_recorded();
+    int64_t start = z_wdt_now();
+    int normal = z_wdt_ctx_add(ctx, 120, record_callback, NULL);
+    int critical = z_wdt_ctx_add_class(ctx, 120, Z_WDT_CLASS_CRITICAL, record_callback, NULL);
+    assert(normal >= 0 && critical >= 0);
+    assert(watchdog_handle_shard(critical) == 2 && watchdog_handle_shard(normal) < 2);
+
+    watchdog_mock_advance(sim_ticks(120) - 1);
+    assert(recorded_count == 0);
+    watchdog_mock_advance(1);
+    assert(recorded_count == 1 && recorded_channel == critical && recorded_at == start + sim_ticks(120));
+    int64_t resolution = sim_ticks(50);
+    watchdog_mock_advance(resolution);
+    assert(recorded_count == 2 && recorded_channel == normal);
+    assert(recorded_at == (start + sim_ticks(120) + resolution - 1) / resolution * resolution);
+    printf("✓ Critical channel timed out on its tick, the best-effort one at the resolution\n");
+
+    // The critical shard has its own table, fed and suspended like the rest
+    reset_recorded();
+    int channels[3];
+    for (int i = 0; i < 3; i++) {
+        channels[i] = z_wdt_ctx_add_class(ctx, 100, Z_WDT_CLASS_CRITICAL, record_callback, NULL);
+        assert(channels[i] >= 0);
+    }
+    assert(z_wdt_ctx_add_class(ctx, 100, Z_WDT_CLASS_CRITICAL, record_callback, NULL) == -1);
+    assert(z_wdt_ctx_delete(ctx, channels[2]) == 0);
+    watchdog_mock_advance(sim_ticks(60));
+    assert(z_wdt_ctx_feed(ctx, channels[0]) == 0);
+    z_wdt_ctx_suspend(ctx);
+    assert(watchdog_mock_next_timer() == INT64_MAX);
+    watchdog_mock_advance(sim_ticks(1000));
+    assert(recorded_count == 0);
+    int64_t resumed = z_wdt_now();
+    z_wdt_ctx_resume(ctx);
+    watchdog_mock_advance(sim_ticks(100));
+    assert(recorded_count == 2 && recorded_at == resumed + sim_ticks(100));
+    printf("✓ Critical table filled up, fed, suspended and resumed\n");
+    z_wdt_destroy(ctx);
+
+    // The class needs its thread and has to be configured
+    config.external_loop = 1;
+    assert(z_wdt_create(&config) == NULL);
+    ctx = z_wdt_create(NULL);
+    assert(ctx != NULL);
+    assert(z_wdt_ctx_add_class(ctx, 100, Z_WDT_CLASS_CRITICAL, record_callback, NULL) == -1);
+    assert(z_wdt_ctx_add_class(ctx, 100, (z_wdt_class)7, record_callback, NULL) == -1);
+    assert(z_wdt_ctx_add_class(ctx, 100, Z_WDT_CLASS_BEST_EFFORT, record_callback, NULL) >= 0);
+    z_wdt_destroy(ctx);
+    printf("✓ Critical class refused without a thread or a configured table\n");
+#else
+    assert(z_wdt_create(&config) == NULL);
+    printf("✓ No shard left for the critical class in this build\n");
+#endif
+}
+
+// Test that adaptive timeouts tighten to the feed rate, within their bounds
+void test_sim_adaptive(void) {
+    printf("\n=== Testing Adaptive Timeouts ===\n");
+
+    assert(sim_init() == 0);
+    reset_recorded();
+    assert(z_wdt_add_adaptive(1000, 0, record_callback, NULL) == -1);
+    assert(z_wdt_add_adaptive(1000, 1001, record_callback, NULL) == -1);
+
+    // A steady 5ms feeder: the timeout drops to the 20ms floor
+    int channel = z_wdt_add_adaptive(1000, 20, record_callback, NULL);
+    assert(channel >= 0);
+    for (int i = 0; i < 100; i++) {
+        watchdog_mock_advance(sim_ticks(5));
+        assert(z_wdt_feed(channel) == 0);
+    }
+    int64_t last_feed = z_wdt_now();
+    watchdog_mock_advance(sim_ticks(1000));
+    assert(recorded_count == 1 && recorded_at == last_feed + sim_ticks(20));
+    printf("✓ Stalled 5ms feeder detected after 20ms instead of 1000ms\n");
+
+    // Too few intervals to judge: the full period applies
+    reset_recorded();
+    channel = z_wdt_add_adaptive(1000, 20, record_callback, NULL);
+    for (int i = 0; i < WATCHDOG_ADAPTIVE_WARMUP - 1; i++) {
+        watchdog_mock_advance(sim_ticks(5));
+        assert(z_wdt_feed(channel) == 0);
+    }
+    last_feed = z_wdt_now();
+    watchdog_mock_advance(sim_ticks(2000));
+    assert(recorded_count == 1 && recorded_at == last_feed + sim_ticks(1000));
+
+    // A bursty feeder keeps a timeout above its longest usual gap
+    reset_recorded();
+    channel = z_wdt_add_adaptive(1000, 20, record_callback, NULL);
+    for (int i = 0; i < 100; i++) {
+        watchdog_mock_advance(sim_ticks(i % 2 == 0 ? 5 : 100));
+        assert(z_wdt_feed(channel) == 0);
+    }
+    assert(recorded_count == 0);
+    last_feed = z_wdt_now();
+    watchdog_mock_advance(sim_ticks(2000));
+    assert(recorded_count == 1);
+    assert(recorded_at > last_feed + sim_ticks(100) && recorded_at < last_feed + sim_ticks(1000));
+    printf("✓ Full period during warm-up, bursty feeder timed out after %lldms\n",
+           (long long)((recorded_at - last_feed) * 1000 / WATCHDOG_TICK_HZ));
+
+    // Suspended time is no feed interval; the learned rate survives resume
+    reset_recorded();
+    channel = z_wdt_add_adaptive(1000, 20, record_callback, NULL);
+    for (int i = 0; i < 100; i++) {
+        watchdog_mock_advance(sim_ticks(5));
+        assert(z_wdt_feed(channel) == 0);
+    }
+    z_wdt_suspend();
+    watchdog_mock_advance(sim_ticks(10000));
+    int64_t resumed = z_wdt_now();
+    z_wdt_resume();
+    for (int i = 0; i < 10; i++) {
+        watchdog_mock_advance(sim_ticks(5));
+        assert(z_wdt_feed(channel) == 0);
+    }
+    last_feed = z_wdt_now();
+    assert(last_feed == resumed + sim_ticks(50));
+    watchdog_mock_advance(sim_ticks(1000));
+    assert(recorded_count == 1 && recorded_at == last_feed + sim_ticks(20));
+    printf("✓ Rate learned before suspend still applied after resume\n");
+
+    z_wdt_cleanup();
+}
+
+// Test that progress channels time out one check after their counters stop
+void test_sim_progress(void) {
+    printf("\n=== Testing Progress Channels ===\n");
+
+    z_wdt_config config = { .max_channels = WATCHDOG_PROGRESS_CHANNELS + 1 };
+    assert(z_wdt_init_ex(&config) == 0);
+    reset_recorded();
+    int64_t start = z_wdt_now();
+    int channel = z_wdt_add_progress(100, record_callback, NULL);
+    assert(channel >= 0);
+
+    // The mock spreads feeds over the CPU rows; any feed in a period counts
+    for (int i = 0; i < 50; i++) {
+        watchdog_mock_advance(sim_ticks(30));
+        for (int n = 0; n < 5; n++) {
+            assert(z_wdt_feed(channel) == 0);
+        }
+    }
+    assert(recorded_count == 0);
+#if WATCHDOG_STATS
+    z_wdt_channel_stats channel_stats;
+    assert(z_wdt_channel_stats_get(channel, &channel_stats) == 0 && channel_stats.feeds == 250);
+#endif
+
+    // Last feed at 1500ms: the check at 1600ms still sees it, the next one doesn't
+    watchdog_mock_advance(sim_ticks(1000));
+    assert(recorded_count == 1 && recorded_channel == channel);
+    assert(recorded_at == start + 17 * sim_ticks(100));
+    assert(z_wdt_feed(channel) == -1);
+    printf("✓ Counted feeds from every CPU row, timed out at the first check without any\n");
+
+    // Counter columns are a fixed pool that deletes give back
+    int channels[WATCHDOG_PROGRESS_CHANNELS];
+    for (int i = 0; i < WATCHDOG_PROGRESS_CHANNELS; i++) {
+        channels[i] = z_wdt_add_progress(100, record_callback, NULL);
+        assert(channels[i] >= 0);
+    }
+    assert(z_wdt_add_progress(100, record_callback, NULL) == -1);
+    assert(z_wdt_delete(channels[0]) == 0);
+    channels[0] = z_wdt_add_progress(100, record_callback, NULL);
+    assert(channels[0] >= 0);
+    for (int i = 0; i < WATCHDOG_PROGRESS_CHANNELS; i++) {
+        assert(z_wdt_delete(channels[i]) == 0);
+    }
+    printf("✓ %d progress channels, then the pool was full\n", WATCHDOG_PROGRESS_CHANNELS);
+
+    // Resume restarts the period
+    reset_recorded();
+    channel = z_wdt_add_progress(100, record_callback, NULL);
+    assert(channel >= 0);
+    z_wdt_suspend();
+    watchdog_mock_advance(sim_ticks(1000));
+    int64_t resumed = z_wdt_now();
+    z_wdt_resume();
+    watchdog_mock_advance(sim_ticks(1000));
+    assert(recorded_count == 1 && recorded_at == resumed + sim_ticks(100));
+
+    z_wdt_cleanup();
+}
+
+// Member timeouts seen by member_callback
+static int member_count = 0;
+static int member_channel = -1;
+
+static void member_callback(int channel_id, void *user_data) {
+    (void)user_data;
+    member_count++;
+    member_channel = channel_id;
+}
+
+// Test that a group times out on the first missed member deadline, to the tick
+void test_sim_channel_groups(void) {
+    printf("\n=== Testing Channel Groups ===\n");
+
+    assert(sim_init() == 0);
+    reset_recorded();
+    member_count = 0;
+    assert(z_wdt_group_create(NULL, NULL) == -1);
+    int group = z_wdt_group_create(record_callback, NULL);
+    assert(group >= 0);
+    assert(watchdog_mock_next_timer() == INT64_MAX);
+    int fast = z_wdt_group_add(group, 100, NULL, NULL);
+    int slow = z_wdt_group_add(group, 300, member_callback, NULL);
+    int quiet = z_wdt_group_add(group, 200, NULL, NULL);
+    assert(fast >= 0 && slow >= 0 && quiet >= 0);
+    assert(z_wdt_feed(group) == -1);
+    assert(z_wdt_group_add(fast, 100, NULL, NULL) == -1);
+
+    // Members fed in time keep the group healthy
+    for (int i = 0; i < 100; i++) {
+        watchdog_mock_advance(sim_ticks(100) - 1);
+        assert(z_wdt_feed(fast) == 0 && z_wdt_feed(slow) == 0 && z_wdt_feed(quiet) == 0);
+    }
+    assert(recorded_count == 0);
+
+    // A deleted member no longer counts, the others still do
+    assert(z_wdt_delete(fast) == 0);
+    int64_t last_feed = z_wdt_now();
+    watchdog_mock_advance(sim_ticks(200) - 1);
+    assert(recorded_count == 0);
+    watchdog_mock_advance(1);
+    assert(recorded_count == 1 && recorded_channel == group);
+    assert(recorded_at == last_feed + sim_ticks(200));
+    assert(member_count == 0);
+    assert(z_wdt_feed(slow) == -1 && z_wdt_feed(quiet) == -1);
+    assert(watchdog_mock_next_timer() == INT64_MAX);
+    printf("✓ Group timed out on the first missed member deadline and retired its members\n");
+
+    // A member with its own callback reports along with the group
+    reset_recorded();
+    group = z_wdt_group_create(record_callback, NULL);
+    slow = z_wdt_group_add(group, 300, member_callback, NULL);
+    assert(group >= 0 && slow >= 0);
+    watchdog_mock_advance(sim_ticks(300));
+    assert(recorded_count == 1 && recorded_channel == group);
+    assert(member_count == 1 && member_channel == slow);
+
+    // Deleting a group deletes its members
+    reset_recorded();
+    group = z_wdt_group_create(record_callback, NULL);
+    fast = z_wdt_group_add(group, 100, NULL, NULL);
+    assert(group >= 0 && fast >= 0);
+    assert(z_wdt_delete(group) == 0);
+    assert(z_wdt_feed(fast) == -1 && z_wdt_delete(fast) == -1);
+    watchdog_mock_advance(sim_ticks(1000));
+    assert(recorded_count == 0);
+    printf("✓ Member callbacks ran with the group's, deleting a group took its members\n");
+
+    // Resume restarts every member; the group fires one period after it
+    group = z_wdt_group_create(record_callback, NULL);
+    fast = z_wdt_group_add(group, 100, NULL, NULL);
+    assert(group >= 0 && fast >= 0);
+    z_wdt_suspend();
+    watchdog_mock_advance(sim_ticks(1000));
+    int64_t resumed = z_wdt_now();
+    z_wdt_resume();
+    watchdog_mock_advance(sim_ticks(100) - 1);
+    assert(recorded_count == 0);
+    watchdog_mock_advance(1);
+    assert(recorded_count == 1 && recorded_at == resumed + sim_ticks(100));
+    printf("✓ Group timed out one member period after resume\n");
+    z_wdt_cleanup();
+
+#ifndef WATCHDOG_STATIC_CHANNELS
+    // 10k workers in 200 pools, one worker stalls: only its pool times out
+    z_wdt_config config = { .max_channels = 16384 };
+    assert(z_wdt_init_ex(&config) == 0);
+    reset_recorded();
+    static int pools[200];
+    static int workers[200][50];
+    for (int p = 0; p < 200; p++) {
+        pools[p] = z_wdt_group_create(record_callback, NULL);
+        assert(pools[p] >= 0);
+        for (int w = 0; w < 50; w++) {
+            workers[p][w] = z_wdt_group_add(pools[p], 100, NULL, NULL);
+            assert(workers[p][w] >= 0);
+        }
+    }
+    for (int i = 0; i < 20; i++) {
+        watchdog_mock_advance(sim_ticks(50));
+        for (int p = 0; p < 200; p++) {
+            for (int w = 0; w < 50; w++) {
+                // The stalled pool's workers retire with it
+                if (i < 10 || p != 123 || w != 7) {
+                    assert(z_wdt_feed(workers[p][w]) == (p == 123 && i > 10 ? -1 : 0));
+                }
+            }
+        }
+    }
+    assert(recorded_count == 1 && recorded_channel == pools[123]);
+    printf("✓ One stalled worker out of 10000 timed out only its pool\n");
+    z_wdt_cleanup();
+#endif
+}
+
+// Events seen by shm_record_callback
+static z_wdt_shm_event shm_events[8];
+static int shm_event_count = 0;
+static int64_t shm_event_at = 0;
+
+static void shm_record_callback(const z_wdt_shm_event *event, void *user_data) {
+    (void)user_data;
+    if (shm_event_count < 8) {
+        shm_events[shm_event_count] = *event;
+    }
+    shm_event_count++;
+    shm_event_at = z_wdt_now();
+}
+
+// Run the supervisor loop for a span of virtual time
+static void sim_supervise(z_wdt_shm_t *supervisor, uint32_t ms) {
+    int64_t end = z_wdt_now() + sim_ticks(ms);
+    while (z_wdt_now() < end) {
+        z_wdt_shm_process(supervisor);
+        z_wdt_shm_wait(supervisor);
+    }
+}
+
+// Test the shared-memory supervisor: timeouts, exited owners and slot reuse
+void test_sim_shared_memory(void) {
+    printf("\n=== Testing Shared-Memory Supervision ===\n");
+
+    shm_event_count = 0;
+    watchdog_mock_set_pid(10);
+    z_wdt_shm_t *supervisor = z_wdt_shm_create("/sim-supervisor", 4, shm_record_callback, NULL);
+    assert(supervisor != NULL);
+    assert(z_wdt_shm_create("/sim-supervisor", 4, shm_record_callback, NULL) == NULL);
+    assert(z_wdt_shm_attach("/sim-missing") == NULL);
+
+    // Two worker processes on the same region
+    z_wdt_shm_t *worker = z_wdt_shm_attach("/sim-supervisor");
+    assert(worker != NULL);
+    assert(z_wdt_shm_process(worker) == -1);
+    watchdog_mock_set_pid(20);
+    int fed = z_wdt_shm_add(worker, 100, "fed");
+    int hung = z_wdt_shm_add(worker, 250, "hung");
+    watchdog_mock_set_pid(30);
+    int crashed = z_wdt_shm_add(worker, 60000, "crashed");
+    int spare = z_wdt_shm_add(worker, 1000, NULL);
+    assert(fed >= 0 && hung >= 0 && crashed >= 0 && spare >= 0);
+    assert(z_wdt_shm_add(worker, 1000, "full") == -1);
+    assert(z_wdt_shm_delete(worker, spare) == 0);
+    assert(z_wdt_shm_feed(worker, spare) == -1);
+    printf("✓ Slots claimed, region full at 4, deleted slot refused\n");
+
+    // The hung slot times out on its deadline; the fed one never does
+    int64_t start = z_wdt_now();
+    for (int i = 0; i < 20; i++) {
+        sim_supervise(supervisor, 50);
+        assert(z_wdt_shm_feed(worker, fed) == 0);
+    }
+    assert(shm_event_count == 1 && shm_events[0].channel_id == hung);
+    assert(shm_events[0].reason == Z_WDT_SHM_TIMEOUT && shm_events[0].pid == 20);
+    assert(shm_events[0].reload_period == 250 && strcmp(shm_events[0].label, "hung") == 0);
+    assert(shm_event_at >= start + sim_ticks(250) && shm_event_at <= start + sim_ticks(251));
+    assert(z_wdt_shm_feed(worker, hung) == -1);
+    printf("✓ Hung slot timed out on its deadline, fed slot kept alive\n");
+
+    // An exited owner is reported within the liveness interval, long before
+    // its 60 s period runs out
+    watchdog_mock_exit(30);
+    int64_t exited = z_wdt_now();
+    for (int i = 0; i < 4; i++) {
+        sim_supervise(supervisor, 50);
+        assert(z_wdt_shm_feed(worker, fed) == 0);
+    }
+    assert(shm_event_count == 2 && shm_events[1].channel_id == crashed);
+    assert(shm_events[1].reason == Z_WDT_SHM_EXITED && shm_events[1].pid == 30);
+    assert(shm_event_at <= exited + sim_ticks(WATCHDOG_SHM_LIVENESS_MS + 1));
+    printf("✓ Exited owner reported after %lld ticks\n", (long long)(shm_event_at - exited));
+
+    // Retired slots are claimed again under new handles
+    watchdog_mock_set_pid(20);
+    int reused = z_wdt_shm_add(worker, 100, "reused");
+    assert(reused >= 0 && reused != hung && reused != crashed);
+    assert(z_wdt_shm_delete(worker, fed) == 0 && z_wdt_shm_delete(worker, reused) == 0);
+    sim_supervise(supervisor, 1000);
+    assert(shm_event_count == 2);
+    printf("✓ Retired slot reused, deleted slots stay quiet\n");
+
+    // A worker still holding a retired slot's generation cannot feed the
+    // process that claimed the slot after it
+    watchdog_mock_set_pid(40);
+    int first = z_wdt_shm_add(worker, 100, "first");
+    assert(first >= 0);
+    uint32_t index = (uint32_t)first & WATCHDOG_INDEX_MASK;
+    int second = -1;
+    while (second < 0 || ((uint32_t)second & WATCHDOG_INDEX_MASK) != index) {
+        assert(z_wdt_shm_delete(worker, second < 0 ? first : second) == 0);
+        watchdog_mock_set_pid(50);
+        second = z_wdt_shm_add(worker, 100, "second");
+        assert(second >= 0);
+    }
+    int64_t claimed = z_wdt_now();
+    // The first owner's generation: its handle's tag is the generation's upper bits
+    uint32_t stale = (((uint32_t)first >> WATCHDOG_SLOT_BITS) & WATCHDOG_TAG_MASK) << 1 | 1;
+    assert(watchdog_shm_feed_slot(worker, index, stale, INT64_MAX - 1) == -1);
+    sim_supervise(supervisor, 150);
+    assert(shm_event_count == 3 && shm_events[2].channel_id == second && shm_events[2].pid == 50);
+    assert(shm_event_at <= claimed + sim_ticks(101));
+    printf("✓ Stale generation refused, the slot's new owner timed out on its deadline\n");
+
+    z_wdt_shm_close(worker);
+    z_wdt_shm_close(supervisor);
+    assert(z_wdt_shm_attach("/sim-supervisor") == NULL);
+}
+
+// Test the flight recorder: events in order with their ticks and threads,
+// the table snapshot a timeout takes, and reading the file back afterwards
+void test_sim_flight_recorder(void) {
+    printf("\n=== Testing Flight Recorder ===\n");
+
+    z_wdt_config config = { .recorder_path = "/sim-recorder" };
+    z_wdt_ctx_t *ctx = z_wdt_create(&config);
+    assert(ctx != NULL);
+    z_wdt_recorder_t *recorder = z_wdt_ctx_recorder(ctx);
+    assert(recorder != NULL);
+
+    // One tick apart, so the rings merge back in a fixed order
+    reset_recorded();
+    int64_t start = z_wdt_now();
+    watchdog_mock_set_thread(7);
+    int fed = z_wdt_ctx_add(ctx, 100, record_callback, NULL);
+    watchdog_mock_advance(1);
+    int hung = z_wdt_ctx_add(ctx, 250, record_callback, NULL);
+    watchdog_mock_advance(1);
+    int gone = z_wdt_ctx_add(ctx, 100, record_callback, NULL);
+    watchdog_mock_advance(1);
+    assert(fed >= 0 && hung >= 0 && gone >= 0);
+    assert(z_wdt_ctx_delete(ctx, gone) == 0);
+    watchdog_mock_set_thread(8);
+    for (int i = 0; i < 3; i++) {
+        watchdog_mock_advance(sim_ticks(90));
+        assert(z_wdt_ctx_feed(ctx, fed) == 0);
+    }
+    assert(recorded_count == 1 && recorded_channel == hung);
+
+    const struct {
+        z_wdt_event_type type;
+        int channel_id;
+        int64_t ticks;
+        uint32_t thread;
+    } expected[] = {
+        { Z_WDT_EVENT_ADD, fed, start, 7 },
+        { Z_WDT_EVENT_ADD, hung, start + 1, 7 },
+        { Z_WDT_EVENT_ADD, gone, start + 2, 7 },
+        { Z_WDT_EVENT_DELETE, gone, start + 3, 7 },
+        { Z_WDT_EVENT_FEED, fed, start + 3 + sim_ticks(90), 8 },
+        { Z_WDT_EVENT_FEED, fed, start + 3 + sim_ticks(180), 8 },
+        { Z_WDT_EVENT_TIMEOUT, hung, start + 1 + sim_ticks(250), 8 },
+        { Z_WDT_EVENT_FEED, fed, start + 3 + sim_ticks(270), 8 },
+    };
+    z_wdt_event events[16];
+    assert(z_wdt_recorder_events(recorder, events, 16) == 8);
+    for (int i = 0; i < 8; i++) {
+        assert(events[i].type == expected[i].type && events[i].channel_id == expected[i].channel_id);
+        assert(events[i].ticks == expected[i].ticks && events[i].thread == expected[i].thread);
+    }
+    assert(z_wdt_recorder_events(recorder, events, 2) == 2);
+    assert(events[0].type == Z_WDT_EVENT_TIMEOUT && events[1].type == Z_WDT_EVENT_FEED);
+    printf("✓ Adds, delete, feeds and timeout recorded in order with tick and thread\n");
+
+    // The timeout copied the table: only the fed channel was left
+    z_wdt_channel_snapshot channels[4];
+    int64_t taken = 0;
+    assert(z_wdt_recorder_channels(recorder, channels, 4, &taken) == 1);
+    assert(taken == start + 1 + sim_ticks(250));
+    assert(channels[0].channel_id == fed && channels[0].reload_period == 100);
+    assert(channels[0].deadline == start + 3 + sim_ticks(180) + sim_ticks(100));
+    assert(z_wdt_ctx_snapshot(ctx) == 1);
+    assert(z_wdt_recorder_channels(recorder, channels, 4, &taken) == 1 && taken == z_wdt_now());
+    printf("✓ Timeout snapshot holds the surviving channel and its deadline\n");
+
+    // Past the ring size only the newest events are kept, still merged by tick
+    for (uint32_t i = 0; i < 2 * WATCHDOG_RECORDER_SIZE * WATCHDOG_RECORDER_CPUS; i++) {
+        watchdog_mock_advance(1);
+        assert(z_wdt_ctx_feed(ctx, fed) == 0);
+    }
+    static z_wdt_event wrapped[WATCHDOG_RECORDER_SIZE];
+    assert(z_wdt_recorder_events(recorder, wrapped, WATCHDOG_RECORDER_SIZE) == (int)WATCHDOG_RECORDER_SIZE);
+    for (uint32_t i = 1; i < WATCHDOG_RECORDER_SIZE; i++) {
+        assert(wrapped[i].type == Z_WDT_EVENT_FEED && wrapped[i].ticks == wrapped[i - 1].ticks + 1);
+    }
+    assert(wrapped[WATCHDOG_RECORDER_SIZE - 1].ticks == z_wdt_now());
+    printf("✓ Wrapped rings return the latest %u events\n", WATCHDOG_RECORDER_SIZE);
+
+    // The file outlives the context and reads back the same
+    z_wdt_destroy(ctx);
+    z_wdt_recorder_t *file = z_wdt_recorder_open("/sim-recorder");
+    assert(file != NULL);
+    z_wdt_event reread[4];
+    assert(z_wdt_recorder_events(file, reread, 4) == 4);
+    assert(memcmp(reread, &wrapped[WATCHDOG_RECORDER_SIZE - 4], sizeof(reread)) == 0);
+    assert(z_wdt_recorder_channels(file, channels, 4, &taken) == 1 && channels[0].channel_id == fed);
+    z_wdt_recorder_close(file);
+    assert(z_wdt_recorder_open("/sim-missing") == NULL);
+    printf("✓ Recorder file read back after the context was destroyed\n");
+
+    // Memory-only recorder, and none unless configured
+    z_wdt_config memory = { .flight_recorder = 1 };
+    ctx = z_wdt_create(&memory);
+    assert(ctx != NULL && z_wdt_ctx_recorder(ctx) != NULL);
+    z_wdt_destroy(ctx);
+    ctx = z_wdt_create(NULL);
+    assert(ctx != NULL && z_wdt_ctx_recorder(ctx) == NULL && z_wdt_ctx_snapshot(ctx) == -1);
+    z_wdt_destroy(ctx);
+    printf("✓ Memory-only recorder created, unconfigured context has none\n");
+    watchdog_mock_set_thread(1);
+}
+
+// Escalation stages seen by the stage actions, in order
+static int stage_log[16];
+static int64_t stage_at[16];
+static int stage_count;
+
+static void log_stage(int stage) {
+    if (stage_count < 16) {
+        stage_at[stage_count] = z_wdt_now();
+        stage_log[stage_count++] = stage;
+    }
+}
+
+static void stage_warn(int channel_id, void *user_data) {
+    (void)channel_id;
+    (void)user_data;
+    log_stage(WATCHDOG_STAGE_WARN);
+}
+
+static void stage_dump(int channel_id, void *user_data) {
+    (void)channel_id;
+    (void)user_data;
+    log_stage(WATCHDOG_STAGE_DUMP);
+}
+
+static void stage_restart(int channel_id, void *user_data) {
+    (void)channel_id;
+    (void)user_data;
+    log_stage(WATCHDOG_STAGE_RESTART);
+}
+
+static void stage_reset(int channel_id, void *user_data) {
+    (void)channel_id;
+    (void)user_data;
+    log_stage(WATCHDOG_STAGE_RESET);
+}
+
+// Test that escalating channels run each stage on its tick, start over
+// when fed, catch up all at once, and reset the system by default
+void test_sim_escalation(void) {
+    printf("\n=== Testing Escalation ===\n");
+
+    static const z_wdt_escalation escalation = { stage_warn, stage_dump, stage_restart, stage_reset };
+    int64_t period = sim_ticks(100);
+    assert(sim_init() == 0);
+    stage_count = 0;
+    int64_t start = z_wdt_now();
+    int channel = z_wdt_add_escalating(100, &escalation, NULL);
+    assert(channel >= 0);
+
+    // The warning and the dump, then a feed brings the channel back
+    watchdog_mock_advance(period / 2 - 1);
+    assert(stage_count == 0);
+    watchdog_mock_advance(1);
+    assert(stage_count == 1 && stage_log[0] == WATCHDOG_STAGE_WARN && stage_at[0] == start + period / 2);
+    watchdog_mock_advance(period / 2);
+    assert(stage_count == 2 && stage_log[1] == WATCHDOG_STAGE_DUMP && stage_at[1] == start + period);
+    assert(z_wdt_feed(channel) == 0);
+    watchdog_mock_advance(10);
+    assert(z_wdt_feed(channel) == 0);
+    printf("✓ Warning at 50%% and dump at 100%% of the period, the channel still fed\n");
+
+    int64_t fed = z_wdt_now();
+    watchdog_mock_advance(3 * period);
+    assert(stage_count == 6);
+    for (int stage = WATCHDOG_STAGE_WARN; stage <= WATCHDOG_STAGE_RESET; stage++) {
+        assert(stage_log[2 + stage] == stage && stage_at[2 + stage] == fed + period / 2 + stage * (period / 2));
+    }
+    assert(z_wdt_feed(channel) == -1);
+    printf("✓ Stages started over from the feed, the reset timed the channel out at 200%%\n");
+
+    // A pass that comes late runs every missed stage in order
+    stage_count = 0;
+    channel = z_wdt_add_escalating(100, &escalation, NULL);
+    int64_t late = z_wdt_now() + 3 * period;
+    watchdog_mock_set_ticks(late);
+    watchdog_mock_advance(0);
+    assert(stage_count == 4);
+    for (int stage = WATCHDOG_STAGE_WARN; stage <= WATCHDOG_STAGE_RESET; stage++) {
+        assert(stage_log[stage] == stage && stage_at[stage] == late);
+    }
+    printf("✓ A late pass ran all four stages in order\n");
+
+    // Suspended time counts for no stage; resume acts as a feed
+    stage_count = 0;
+    channel = z_wdt_add_escalating(100, &escalation, NULL);
+    z_wdt_suspend();
+    watchdog_mock_advance(10 * period);
+    int64_t resumed = z_wdt_now();
+    z_wdt_resume();
+    watchdog_mock_advance(period / 2);
+    assert(stage_count == 1 && stage_at[0] == resumed + period / 2);
+    assert(z_wdt_delete(channel) == 0);
+    watchdog_mock_advance(3 * period);
+    assert(stage_count == 1);
+    printf("✓ The first stage came half a period after resume, none after delete\n");
+
+    // Default actions end in a system reset
+    uint32_t resets = watchdog_mock_resets();
+    assert(z_wdt_add_escalating(100, NULL, NULL) >= 0);
+    watchdog_mock_advance(2 * period - 1);
+    assert(watchdog_mock_resets() == resets);
+    watchdog_mock_advance(1);
+    assert(watchdog_mock_resets() == resets + 1);
+    printf("✓ Default escalation reset the system at its last stage\n");
+
+#ifndef _WIN32
+    // A plain channel without a callback exits the process instead, here a fork
+    fflush(stdout);
+    pid_t child = fork();
+    assert(child >= 0);
+    if (child == 0) {
+        z_wdt_add(100, NULL, NULL);
+        watchdog_mock_advance(period);
+        _exit(watchdog_mock_resets() == resets + 1 ? 2 : 3);
+    }
+    int status;
+    assert(waitpid(child, &status, 0) == child);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 1);
+    printf("✓ A timeout without a callback exited with status 1, no reset\n");
+#endif
+
+    z_wdt_cleanup();
+}
+
+/* Randomized operations against a reference model */
+typedef struct {
+    int id;                        // Live handle, -1 if unused or timed out
+    uint32_t period;               // Reload period (ms)
+    uint32_t slack;                // Slack (ms)
+    int64_t earliest;              // Must not time out before this tick
+    int64_t latest;                // Must have timed out by this tick
+} sim_channel_t;
+
+typedef struct {
+    const char *name;
+    z_wdt_config config;
+    uint32_t channels;             // Model slots (at most the context's capacity)
+    uint32_t max_slack;            // Slack drawn from [0, max_slack] ms
+} sim_fuzz_config_t;
+
+static sim_channel_t sim_model[SIM_SCALE_CHANNELS];
+static uint32_t sim_model_size;
+static uint32_t sim_active;
+static int64_t sim_resolution;     // Extra lateness from timer_resolution (ticks)
+static bool sim_suspended;
+static int sim_stale;               // Last handle deleted or timed out
+static int sim_failures;
+static uint64_t sim_rng = 0x9E3779B97F4A7C15ull;
+
+static uint32_t sim_random(uint32_t bound) {
+    sim_rng ^= sim_rng >> 12;
+    sim_rng ^= sim_rng << 25;
+    sim_rng ^= sim_rng >> 27;
+    return (uint32_t)((sim_rng * 0x2545F4914F6CDD1Dull) >> 32) % bound;
+}
+
+static void sim_fail(const char *what, uint32_t slot) {
+    if (sim_failures++ < 10) {
+        printf("✗ %s: slot %u at tick %lld (window %lld..%lld)\n", what, slot, (long long)z_wdt_now(),
+               (long long)sim_model[slot].earliest, (long long)sim_model[slot].latest);
+    }
+}
+
+// Window in which a channel fed now must time out
+static void sim_model_feed(sim_channel_t *channel) {
+    channel->earliest = z_wdt_now() + sim_ticks(channel->period);
+    channel->latest = channel->earliest + sim_ticks(channel->slack) + sim_resolution;
+}
+
+static void sim_fuzz_callback(int channel_id, void *user_data) {
+    uint32_t slot = (uint32_t)(uintptr_t)user_data;
+    sim_channel_t *channel = &sim_model[slot];
+
+    if (channel->id != channel_id) {
+        sim_fail("Timeout of a channel that is not live", slot);
+        return;
+    }
+    if (sim_suspended) {
+        sim_fail("Timeout while suspended", slot);
+    }
+    if (z_wdt_now() < channel->earliest) {
+        sim_fail("Early timeout", slot);
+    }
+    if (z_wdt_now() > channel->latest) {
+        sim_fail("Late timeout", slot);
+    }
+    sim_stale = channel->id;
+    channel->id = -1;
+    sim_active--;
+}
+
+// Move time forward; external contexts are processed at each published deadline
+static void sim_advance(z_wdt_ctx_t *ctx, bool external, int64_t ticks) {
+    int64_t target = z_wdt_now() + ticks;
+    if (!external) {
+        watchdog_mock_advance(ticks);
+        return;
+    }
+    for (int64_t deadline; (deadline = z_wdt_ctx_next_deadline(ctx)) <= target;) {
+        if (deadline > z_wdt_now()) {
+            watchdog_mock_set_ticks(deadline);
+        }
+        z_wdt_ctx_process(ctx);
+    }
+    watchdog_mock_set_ticks(target);
+}
+
+static void sim_fuzz(const sim_fuzz_config_t *fuzz) {
+    z_wdt_ctx_t *ctx = z_wdt_create(&fuzz->config);
+    assert(ctx != NULL);
+    bool external = fuzz->config.external_loop != 0;
+    uint32_t capacity = fuzz->channels;
+
+    sim_model_size = fuzz->channels;
+    sim_active = 0;
+    sim_suspended = false;
+    sim_failures = 0;
+    sim_resolution = sim_ticks(fuzz->config.timer_resolution);
+    for (uint32_t i = 0; i < sim_model_size; i++) {
+        sim_model[i].id = -1;
+    }
+
+    sim_stale = -1;
+    uint64_t timeouts = 0;
+    for (uint32_t step = 0; step < SIM_FUZZ_STEPS && sim_failures == 0; step++) {
+        uint32_t slot = sim_random(sim_model_size);
+        sim_channel_t *channel = &sim_model[slot];
+        uint32_t op = sim_random(100);
+
+        if (op < 12) {
+            if (channel->id >= 0) {
+                continue;
+            }
+            channel->period = 1 + sim_random(sim_random(2) ? 50 : 5000);
+            channel->slack = fuzz->max_slack ? sim_random(fuzz->max_slack + 1) : 0;
+            channel->id = z_wdt_ctx_add_ex(ctx, channel->period, channel->slack, sim_fuzz_callback,
+                                           (void *)(uintptr_t)slot);
+            if (channel->id < 0) {
+                if (sim_active < capacity) {
+                    sim_fail("Add failed below capacity", slot);
+                }
+                continue;
+            }
+            sim_model_feed(channel);
+            sim_active++;
+        } else if (op < 47) {
+            if (channel->id < 0) {
+                continue;
+            }
+            if (z_wdt_ctx_feed(ctx, channel->id) != 0) {
+                sim_fail("Feed of a live channel failed", slot);
+            }
+            sim_model_feed(channel);
+        } else if (op < 50) {
+            // Batch feed over a few random slots, live or not
+            int ids[8];
+            int live = 0;
+            for (int i = 0; i < 8; i++) {
+                sim_channel_t *pick = &sim_model[sim_random(sim_model_size)];
+                ids[i] = pick->id >= 0 ? pick->id : sim_stale;
+                live += pick->id >= 0;
+            }
+            int expected = 0;
+            for (int i = 0; i < 8; i++) {
+                expected += ids[i] >= 0;
+            }
+            int fed = z_wdt_ctx_feed_many(ctx, ids, 8);
+            if (fed < live || fed > expected) {
+                sim_fail("Batch feed count", slot);
+            }
+            for (uint32_t i = 0; i < sim_model_size; i++) {
+                for (int j = 0; j < 8 && sim_model[i].id >= 0; j++) {
+                    if (sim_model[i].id == ids[j]) {
+                        sim_model_feed(&sim_model[i]);
+                        break;
+                    }
+                }
+            }
+        } else if (op < 55) {
+            if (channel->id < 0) {
+                continue;
+            }
+            if (z_wdt_ctx_delete(ctx, channel->id) != 0) {
+                sim_fail("Delete of a live channel failed", slot);
+            }
+            sim_stale = channel->id;
+            channel->id = -1;
+            sim_active--;
+        } else if (op < 57) {
+            // A handle that was deleted or timed out must stay dead, unless
+            // its tag wrapped onto a live channel
+            bool live = false;
+            for (uint32_t i = 0; i < sim_model_size && !live; i++) {
+                live = sim_model[i].id == sim_stale;
+            }
+            if (sim_stale >= 0 && !live && z_wdt_ctx_feed(ctx, sim_stale) == 0) {
+                sim_fail("Feed of a stale handle succeeded", slot);
+            }
+        } else if (op < 58) {
+            if (sim_suspended) {
+                z_wdt_ctx_resume(ctx);
+                sim_suspended = false;
+                for (uint32_t i = 0; i < sim_model_size; i++) {
+                    if (sim_model[i].id >= 0) {
+                        sim_model_feed(&sim_model[i]);
+                    }
+                }
+            } else {
+                z_wdt_ctx_suspend(ctx);
+                sim_suspended = true;
+            }
+        } else {
+            uint32_t before = sim_active;
+            sim_advance(ctx, external, sim_random(100) < 95 ? sim_random(20) : sim_random(2000));
+            timeouts += before - sim_active;
+
+            // Everything whose window closed must have fired by now
+            for (uint32_t i = 0; i < sim_model_size && !sim_suspended; i++) {
+                if (sim_model[i].id >= 0 && sim_model[i].latest < z_wdt_now()) {
+                    sim_fail("Missed timeout", i);
+                    sim_model[i].id = -1;
+                }
+            }
+        }
+    }
+
+    z_wdt_destroy(ctx);
+    if (sim_failures != 0) {
+        printf("✗ Fuzz %s: %d failure(s)\n", fuzz->name, sim_failures);
+        fflush(stdout);
+        assert(sim_failures == 0);
+    }
+    printf("✓ Fuzz %s: %u steps, %llu timeouts matched the model\n", fuzz->name, SIM_FUZZ_STEPS,
+           (unsigned long long)timeouts);
+}
+
+// Run the model check over the configurations the scheduler has to handle
+void test_sim_fuzz(void) {
+    printf("\n=== Testing Randomized Operations ===\n");
+
+#ifdef WATCHDOG_STATIC_CHANNELS
+    static const sim_fuzz_config_t configs[] = {
+        { "default", { 0 }, SIM_FUZZ_CHANNELS, 0 },
+        { "slack", { 0 }, SIM_FUZZ_CHANNELS, 40 },
+        { "resolution", { .timer_resolution = 4 }, SIM_FUZZ_CHANNELS, 0 },
+        { "external", { .external_loop = 1 }, SIM_FUZZ_CHANNELS, 0 },
+    };
+#else
+    static const sim_fuzz_config_t configs[] = {
+        { "default", { .max_channels = SIM_FUZZ_CHANNELS }, SIM_FUZZ_CHANNELS, 0 },
+        { "sharded", { .max_channels = 100, .initial_channels = 1, .shards = 3, .dispatch_workers = 2 },
+          300, 0 },
+        { "slack", { .max_channels = SIM_FUZZ_CHANNELS }, SIM_FUZZ_CHANNELS, 40 },
+        { "resolution", { .max_channels = SIM_FUZZ_CHANNELS, .timer_resolution = 4 }, SIM_FUZZ_CHANNELS, 0 },
+        { "external", { .max_channels = SIM_FUZZ_CHANNELS, .external_loop = 1 }, SIM_FUZZ_CHANNELS, 0 },
+        { "scale", { .max_channels = 2500, .initial_channels = 0, .shards = 8 }, SIM_SCALE_CHANNELS, 0 },
+    };
+#endif
+    for (size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); i++) {
+        sim_fuzz(&configs[i]);
+    }
+}
+
+int main(void) {
+    printf("Embedded Watchdog Framework Virtual-Time Test Suite\n");
+    printf("===================================================\n");
+
+    test_sim_timeout_exact();
+    test_sim_feed();
+    test_sim_stale_feed();
+    test_sim_suspend_resume();
+    test_sim_resume_epoch();
+    test_sim_channel_suspend();
+    test_sim_slack();
+    test_sim_hardware_watchdog();
+    test_sim_external_loop();
+    test_sim_critical_class();
+    test_sim_adaptive();
+    test_sim_progress();
+    test_sim_channel_groups();
+    test_sim_shared_memory();
+    test_sim_flight_recorder();
+    test_sim_escalation();
+    test_sim_fuzz();
+
+    printf("\n=== Test Results ===\n");
+    printf("✓ All tests passed!\n");
+    return 0;
+}
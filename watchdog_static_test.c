@@ -0,0 +1,171 @@
+/*
+ * Tests for channels declared with Z_WDT_DEFINE_CHANNEL()
+ * A program of its own, since every z_wdt_init() in it adds the channels
+ * below. Linked against the mock platform (watchdog_os_mock.c) like the
+ * virtual-time suite, so timeouts are checked to the tick.
+ */
+
+#include "z_wdt_internal.h"
+#include "watchdog_os_mock.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <assert.h>
+
+// Timeouts seen by record_callback, per user_data tag
+static int recorded_count = 0;
+static int recorded_channel = -1;
+static int recorded_tag = 0;
+
+static void record_callback(int channel_id, void *user_data) {
+    recorded_count++;
+    recorded_channel = channel_id;
+    recorded_tag = user_data != NULL ? *(int *)user_data : 0;
+}
+
+static void reset_recorded(void) {
+    recorded_count = 0;
+    recorded_channel = -1;
+    recorded_tag = 0;
+}
+
+// Reload period in ticks, as the core rounds it
+static int64_t sim_ticks(uint32_t ms) {
+    return ((int64_t)ms * WATCHDOG_TICK_HZ + 999) / 1000;
+}
+
+#ifdef Z_WDT_HAVE_STATIC_CHANNELS
+static int sensor_tag = 7;
+
+Z_WDT_DEFINE_CHANNEL(control, 50, record_callback);
+Z_WDT_DEFINE_CHANNEL_EX(sensor, 100, record_callback, &sensor_tag);
+Z_WDT_DEFINE_CHANNEL(comms, 200, record_callback);
+
+// Test that init adds every declared channel to the leading slots
+void test_static_registration(void) {
+    printf("\n=== Testing Static Channel Registration ===\n");
+
+    assert(Z_WDT_STATIC_CHANNEL_COUNT == 3);
+    assert(z_wdt_static_id(control) == -1);
+    assert(z_wdt_feed_static(control) == -1);
+
+    assert(z_wdt_init() == 0);
+    reset_recorded();
+    const int ids[] = { z_wdt_static_id(control), z_wdt_static_id(sensor), z_wdt_static_id(comms) };
+    const z_wdt_static_channel *descriptors[] = { &z_wdt_channel_control, &z_wdt_channel_sensor,
+                                                  &z_wdt_channel_comms };
+    bool seen[3] = { false, false, false };
+    for (int i = 0; i < 3; i++) {
+        assert(ids[i] >= 0);
+        uint32_t slot = (uint32_t)ids[i] & WATCHDOG_INDEX_MASK;
+        assert(slot < 3 && !seen[slot]);
+        assert(&__start_z_wdt_channels[slot] == descriptors[i]);
+        seen[slot] = true;
+    }
+    assert(strcmp(z_wdt_channel_sensor.name, "sensor") == 0);
+
+    // Handles work with the regular calls too; runtime channels come after
+    assert(z_wdt_feed(ids[0]) == 0);
+    int dynamic = z_wdt_add(1000, record_callback, NULL);
+    assert(dynamic >= 0 && ((uint32_t)dynamic & WATCHDOG_INDEX_MASK) >= 3);
+    z_wdt_cleanup();
+    printf("✓ 3 declared channels pinned to slots 0-2 at init\n");
+}
+
+// Test feeding by name, exact timeouts and that timed-out slots are not reused
+void test_static_feed(void) {
+    printf("\n=== Testing Static Channel Feeds ===\n");
+
+    assert(z_wdt_init() == 0);
+    reset_recorded();
+    int64_t start = z_wdt_now();
+    for (int i = 0; i < 10; i++) {
+        watchdog_mock_advance(sim_ticks(40));
+        assert(z_wdt_feed_static(control) == 0);
+        assert(z_wdt_feed_static(sensor) == 0);
+        assert(z_wdt_feed_static(comms) == 0);
+    }
+    assert(recorded_count == 0);
+
+    // Stop feeding the sensor: it times out one period after its last feed
+    int64_t last_feed = z_wdt_now();
+    for (int i = 0; i < 2; i++) {
+        watchdog_mock_advance(sim_ticks(40));
+        assert(z_wdt_feed_static(control) == 0);
+        assert(z_wdt_feed_static(comms) == 0);
+    }
+    watchdog_mock_advance(last_feed + sim_ticks(100) - 1 - z_wdt_now());
+    assert(recorded_count == 0);
+    watchdog_mock_advance(1);
+    assert(recorded_count == 1 && recorded_tag == 7);
+    assert(recorded_channel == z_wdt_static_id(sensor));
+    assert(z_wdt_now() - start == 10 * sim_ticks(40) + sim_ticks(100));
+    assert(z_wdt_feed_static(sensor) == -1);
+    assert(z_wdt_feed(z_wdt_static_id(sensor)) == -1);
+
+    // Runtime channels churning through the table never land in its slot
+    uint32_t sensor_slot = (uint32_t)z_wdt_static_id(sensor) & WATCHDOG_INDEX_MASK;
+    for (int i = 0; i < 100; i++) {
+        int channel = z_wdt_add(1000, record_callback, NULL);
+        assert(channel >= 0 && ((uint32_t)channel & WATCHDOG_INDEX_MASK) != sensor_slot);
+        assert(z_wdt_delete(channel) == 0);
+    }
+    assert(z_wdt_feed_static(sensor) == -1);
+    assert(z_wdt_feed_static(control) == 0);
+    z_wdt_cleanup();
+    printf("✓ Sensor timed out on its exact tick and its slot stayed retired\n");
+}
+
+// Test that declared channels cannot be deleted and come back on re-init
+void test_static_lifecycle(void) {
+    printf("\n=== Testing Static Channel Lifecycle ===\n");
+
+    assert(z_wdt_init() == 0);
+    reset_recorded();
+    int control = z_wdt_static_id(control);
+    assert(z_wdt_delete(control) == -1);
+    assert(z_wdt_feed_static(control) == 0);
+    z_wdt_cleanup();
+    assert(z_wdt_feed_static(control) == -1);
+
+    // A fresh init adds them again, feedable right away
+    assert(z_wdt_init() == 0);
+    assert(z_wdt_feed_static(control) == 0);
+    assert(z_wdt_feed(z_wdt_static_id(control)) == 0);
+    watchdog_mock_advance(sim_ticks(200));
+    assert(recorded_count == 3);
+    assert(z_wdt_feed_static(comms) == -1);
+    z_wdt_cleanup();
+
+#ifndef WATCHDOG_STATIC_CHANNELS
+    // With several shards they still go to the first one
+    z_wdt_config config = { .shards = 4 };
+    assert(z_wdt_init_ex(&config) == 0);
+    assert(watchdog_handle_shard(z_wdt_static_id(comms)) == 0);
+    for (int i = 0; i < 8; i++) {
+        assert(z_wdt_add(1000, record_callback, NULL) >= 0);
+    }
+    assert(z_wdt_feed_static(comms) == 0);
+    z_wdt_cleanup();
+#endif
+    printf("✓ Delete refused, cleanup stops feeds and re-init re-adds them\n");
+}
+#endif
+
+int main(void) {
+    printf("Embedded Watchdog Framework Static Channel Test Suite\n");
+    printf("=====================================================\n");
+
+#ifdef Z_WDT_HAVE_STATIC_CHANNELS
+    test_static_registration();
+    test_static_feed();
+    test_static_lifecycle();
+#else
+    printf("\nZ_WDT_DEFINE_CHANNEL() needs a GNU toolchain on an ELF target, skipped\n");
+#endif
+
+    printf("\n=== Test Results ===\n");
+    printf("✓ All tests passed!\n");
+    return 0;
+}
@@ -6,6 +6,7 @@
 #include "z_wdt.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <stdbool.h>
 #include <signal.h>
 #include <assert.h>
@@ -18,6 +19,10 @@
 #else
     #include <unistd.h>
     #include <pthread.h>
+    #include <sys/wait.h>
+#endif
+#ifdef __linux__
+    #include <poll.h>
 #endif
 
 // Test state
@@ -341,6 +346,46 @@ void test_error_conditions(void) {
     printf("✓ Feeding non-existent channel handling works\n");
 }
 
+// Timeout order recorded by order_timeout_callback
+static int timeout_order[WATCHDOG_MAX_CHANNELS];
+static int timeout_order_count = 0;
+
+void order_timeout_callback(int channel_id, void *user_data) {
+    (void)user_data;
+    if (timeout_order_count < WATCHDOG_MAX_CHANNELS) {
+        timeout_order[timeout_order_count++] = channel_id;
+    }
+}
+
+// Test that channels expire in deadline order
+void test_timeout_order(void) {
+    printf("\n=== Testing Timeout Order ===\n");
+    
+    timeout_order_count = 0;
+    int slow = z_wdt_add(600, order_timeout_callback, NULL);
+    int fast = z_wdt_add(200, order_timeout_callback, NULL);
+    int removed = z_wdt_add(300, order_timeout_callback, NULL);
+    int middle = z_wdt_add(400, order_timeout_callback, NULL);
+    assert(slow >= 0 && fast >= 0 && removed >= 0 && middle >= 0);
+    
+    // Deleting a queued channel must not disturb the others
+    assert(z_wdt_delete(removed) == 0);
+    
+    usleep(900000); // 900ms
+    
+    if (timeout_order_count == 3 && timeout_order[0] == fast &&
+        timeout_order[1] == middle && timeout_order[2] == slow) {
+        printf("✓ Channels expired in deadline order\n");
+    } else {
+        printf("✗ Unexpected expiry order (%d timeouts)\n", timeout_order_count);
+        test_failures++;
+    }
+    
+    z_wdt_delete(slow);
+    z_wdt_delete(fast);
+    z_wdt_delete(middle);
+}
+
 // Test maximum channels
 void test_maximum_channels(void) {
     printf("\n=== Testing Maximum Channels ===\n");
@@ -366,6 +411,837 @@ void test_maximum_channels(void) {
     printf("✓ Cleaned up all channels\n");
 }
 
+// Test runtime-sized channel table and generation-tagged handles
+void test_dynamic_table(void) {
+    printf("\n=== Testing Dynamic Channel Table ===\n");
+    
+    enum { TABLE_SIZE = 600 };
+    static int channels[TABLE_SIZE];
+    z_wdt_config config = { .max_channels = TABLE_SIZE };
+    
+    z_wdt_cleanup();
+    assert(z_wdt_init_ex(&config) == 0);
+    
+    // Grow well beyond WATCHDOG_MAX_CHANNELS, chunk by chunk
+    for (int i = 0; i < TABLE_SIZE; i++) {
+        channels[i] = z_wdt_add(60000, watchdog_timeout_callback, &test_tasks[0]);
+        assert(channels[i] >= 0);
+    }
+    assert(z_wdt_add(60000, watchdog_timeout_callback, &test_tasks[0]) == -1);
+    printf("✓ Added %d channels, rejected one more\n", TABLE_SIZE);
+    
+    // A stale handle must not reach the slot's next owner
+    int stale = channels[0];
+    assert(z_wdt_delete(stale) == 0);
+    channels[0] = z_wdt_add(60000, watchdog_timeout_callback, &test_tasks[0]);
+    assert(channels[0] >= 0 && channels[0] != stale);
+    assert(z_wdt_feed(stale) == -1);
+    assert(z_wdt_delete(stale) == -1);
+    assert(z_wdt_feed(channels[0]) == 0);
+    printf("✓ Stale handle rejected after slot reuse\n");
+    
+    for (int i = 0; i < TABLE_SIZE; i++) {
+        assert(z_wdt_delete(channels[i]) == 0);
+    }
+    printf("✓ Cleaned up all channels\n");
+}
+
+// Timeouts counted by batch_timeout_callback
+static volatile int batch_timeouts = 0;
+
+void batch_timeout_callback(int channel_id, void *user_data) {
+    (void)user_data;
+    
+    printf("Batch channel %d timed out\n", channel_id);
+    batch_timeouts++;
+}
+
+// Test feeding channels in batches
+void test_batch_feed(void) {
+    printf("\n=== Testing Batch Feed ===\n");
+    
+    int channels[4];
+    for (int i = 0; i < 4; i++) {
+        channels[i] = z_wdt_add(400, batch_timeout_callback, NULL);
+        assert(channels[i] >= 0);
+    }
+    batch_timeouts = 0;
+    
+    // Keep all four alive, alternating between the list and mask variants
+    for (int round = 0; round < 6; round++) {
+        usleep(200000);
+        if (round % 2 == 0) {
+            assert(z_wdt_feed_many(channels, 4) == 4);
+        } else {
+            assert(z_wdt_feed_mask(channels, 0xF) == 4);
+        }
+    }
+    assert(batch_timeouts == 0);
+    printf("✓ Batch feeds kept all channels alive\n");
+    
+    // Feed only the first two; the others time out
+    for (int round = 0; round < 4; round++) {
+        usleep(200000);
+        z_wdt_feed_mask(channels, 0x3);
+    }
+    assert(batch_timeouts == 2);
+    assert(z_wdt_feed_many(channels, 4) == 2);
+    printf("✓ Unfed channels timed out, stale IDs not counted\n");
+    
+    assert(z_wdt_delete(channels[0]) == 0);
+    assert(z_wdt_delete(channels[1]) == 0);
+    assert(z_wdt_feed_many(NULL, 0) == 0);
+    assert(z_wdt_feed_mask(NULL, 0) == 0);
+}
+
+// Test channels spread over several shards
+void test_sharded_channels(void) {
+    printf("\n=== Testing Sharded Channels ===\n");
+    
+    enum { SHARDS = 4, PER_SHARD = 4, TOTAL = SHARDS * PER_SHARD };
+    int channels[TOTAL];
+    z_wdt_config config = { .max_channels = PER_SHARD, .shards = SHARDS };
+    
+    z_wdt_cleanup();
+    assert(z_wdt_init_ex(&config) == 0);
+    
+    // One thread fills its own shard first, then spills into the others
+    for (int i = 0; i < TOTAL; i++) {
+        channels[i] = z_wdt_add(400, batch_timeout_callback, NULL);
+        assert(channels[i] >= 0);
+    }
+    assert(z_wdt_add(400, batch_timeout_callback, NULL) == -1);
+    printf("✓ Filled %d shards of %d channels, rejected one more\n", SHARDS, PER_SHARD);
+    
+    // Keep the first half alive with batch feeds crossing shard boundaries
+    batch_timeouts = 0;
+    for (int round = 0; round < 4; round++) {
+        usleep(200000);
+        assert(z_wdt_feed_many(channels, TOTAL / 2) == TOTAL / 2);
+    }
+    assert(batch_timeouts == TOTAL / 2);
+    printf("✓ Unfed channels timed out in every shard\n");
+    
+    for (int i = 0; i < TOTAL; i++) {
+        assert(z_wdt_delete(channels[i]) == (i < TOTAL / 2 ? 0 : -1));
+    }
+    printf("✓ Cleaned up all channels\n");
+}
+
+// Counts timeouts per context in test_multiple_contexts
+static volatile int context_timeouts[2];
+
+void context_timeout_callback(int channel_id, void *user_data) {
+    (void)channel_id;
+    context_timeouts[(intptr_t)user_data]++;
+}
+
+// Test independent contexts with their own timer threads
+void test_multiple_contexts(void) {
+    printf("\n=== Testing Multiple Contexts ===\n");
+    
+    z_wdt_config coarse = { .timer_resolution = 50 };
+    z_wdt_ctx_t *fed = z_wdt_create(NULL);
+    z_wdt_ctx_t *starved = z_wdt_create(&coarse);
+    assert(fed != NULL && starved != NULL && fed != starved);
+    
+    context_timeouts[0] = 0;
+    context_timeouts[1] = 0;
+    int fed_channel = z_wdt_ctx_add(fed, 300, context_timeout_callback, (void *)0);
+    int starved_channel = z_wdt_ctx_add(starved, 300, context_timeout_callback, (void *)1);
+    assert(fed_channel >= 0 && starved_channel >= 0);
+    printf("✓ Created two contexts with one channel each\n");
+    
+    for (int round = 0; round < 5; round++) {
+        usleep(150000);
+        assert(z_wdt_ctx_feed(fed, fed_channel) == 0);
+    }
+    assert(context_timeouts[0] == 0);
+    assert(context_timeouts[1] == 1);
+    assert(z_wdt_ctx_feed(starved, starved_channel) == -1);
+    printf("✓ Contexts timed out independently\n");
+    
+    // The default context keeps working next to them
+    int channel = z_wdt_add(1000, watchdog_timeout_callback, &test_tasks[0]);
+    assert(channel >= 0);
+    assert(z_wdt_delete(channel) == 0);
+    
+    assert(z_wdt_ctx_delete(fed, fed_channel) == 0);
+    assert(z_wdt_ctx_feed(NULL, fed_channel) == -1);
+    z_wdt_destroy(fed);
+    z_wdt_destroy(starved);
+    z_wdt_destroy(NULL);
+    printf("✓ Destroyed both contexts\n");
+}
+
+// Wait for an external loop context's next deadline the way an event loop would
+static void wait_for_deadline(z_wdt_ctx_t *ctx) {
+#ifdef __linux__
+    struct pollfd pfd = { .fd = z_wdt_ctx_get_fd(ctx), .events = POLLIN };
+    assert(pfd.fd >= 0);
+    assert(poll(&pfd, 1, 2000) == 1);
+#else
+    int64_t remaining = z_wdt_ctx_next_deadline(ctx) - z_wdt_now();
+    if (remaining > 0) {
+        usleep((unsigned)(remaining * 1000000 / WATCHDOG_TICK_HZ));
+    }
+#endif
+}
+
+// Test driving a context from an application event loop
+void test_external_loop(void) {
+    printf("\n=== Testing External Loop ===\n");
+    
+    z_wdt_config config = { .external_loop = 1 };
+    z_wdt_ctx_t *ctx = z_wdt_create(&config);
+    assert(ctx != NULL);
+    assert(z_wdt_ctx_next_deadline(ctx) == INT64_MAX);
+    
+    context_timeouts[0] = 0;
+    int64_t start = z_wdt_now();
+    int channel = z_wdt_ctx_add(ctx, 200, context_timeout_callback, (void *)0);
+    assert(channel >= 0);
+    assert(z_wdt_ctx_next_deadline(ctx) != INT64_MAX);
+    printf("✓ Next deadline published without a timer thread\n");
+    
+    // Nothing runs until the loop processes the context; the deadline may
+    // be a scheduler lower bound, so a wakeup can come early
+    usleep(300000);
+    assert(context_timeouts[0] == 0);
+    for (int round = 0; round < 10 && context_timeouts[0] == 0; round++) {
+        wait_for_deadline(ctx);
+        z_wdt_ctx_process(ctx);
+    }
+    assert(context_timeouts[0] == 1);
+    assert(z_wdt_now() - start >= 200 * WATCHDOG_TICK_HZ / 1000);
+    assert(z_wdt_ctx_next_deadline(ctx) == INT64_MAX);
+#ifdef __linux__
+    struct pollfd pfd = { .fd = z_wdt_ctx_get_fd(ctx), .events = POLLIN };
+    assert(poll(&pfd, 1, 0) == 0);
+#endif
+    assert(z_wdt_ctx_feed(ctx, channel) == -1);
+    printf("✓ Loop processed the timeout and the descriptor re-armed\n");
+    
+    // A threaded context has no descriptor
+    assert(z_wdt_get_fd() == -1);
+    z_wdt_destroy(ctx);
+    printf("✓ Destroyed external loop context\n");
+}
+
+// Timeouts sharing a wakeup under slack, recorded by channel order
+static int64_t slack_fired_at[3];
+
+void slack_timeout_callback(int channel_id, void *user_data) {
+    (void)channel_id;
+    slack_fired_at[(intptr_t)user_data] = z_wdt_now();
+}
+
+// Test that deadlines within each other's slack coalesce into one wakeup
+void test_timer_slack(void) {
+    printf("\n=== Testing Timer Slack ===\n");
+    
+    static const uint32_t periods[3] = { 300, 303, 310 };
+    z_wdt_config config = { .external_loop = 1, .default_slack = 50 };
+    z_wdt_ctx_t *ctx = z_wdt_create(&config);
+    assert(ctx != NULL);
+    
+    int64_t start = z_wdt_now();
+    for (intptr_t i = 0; i < 3; i++) {
+        slack_fired_at[i] = 0;
+        assert(z_wdt_ctx_add(ctx, periods[i], slack_timeout_callback, (void *)i) >= 0);
+    }
+    
+    // All three windows overlap by more than 32ms, so the deadlines fall on
+    // at most two 32-tick boundaries; without slack each needs its own wakeup
+    int wakeups = 0;
+    int fired = 0;
+    for (int round = 0; round < 20 && fired < 3; round++) {
+        wait_for_deadline(ctx);
+        z_wdt_ctx_process(ctx);
+        
+        int now_fired = 0;
+        for (int i = 0; i < 3; i++) {
+            now_fired += slack_fired_at[i] != 0;
+        }
+        if (now_fired != fired) {
+            wakeups++;
+            fired = now_fired;
+        }
+    }
+    assert(fired == 3);
+    assert(wakeups <= 2);
+    for (int i = 0; i < 3; i++) {
+        int64_t elapsed_ms = (slack_fired_at[i] - start) * 1000 / WATCHDOG_TICK_HZ;
+        assert(elapsed_ms >= periods[i]);
+        assert(elapsed_ms <= periods[i] + 50 + 100);
+    }
+    printf("✓ Three timeouts fired in %d wakeup(s), none before its period\n", wakeups);
+    
+    z_wdt_destroy(ctx);
+}
+
+// Time of the timeout seen in test_adaptive_timeout
+static volatile int64_t adaptive_fired_at = 0;
+
+void adaptive_timeout_callback(int channel_id, void *user_data) {
+    (void)channel_id;
+    (void)user_data;
+    adaptive_fired_at = z_wdt_now();
+}
+
+// Test that an adaptive channel catches a fast feeder stalling well before its period
+void test_adaptive_timeout(void) {
+    printf("\n=== Testing Adaptive Timeout ===\n");
+    
+    z_wdt_ctx_t *ctx = z_wdt_create(NULL);
+    assert(ctx != NULL);
+    assert(z_wdt_ctx_add_adaptive(ctx, 1000, 2000, adaptive_timeout_callback, NULL) == -1);
+    int channel = z_wdt_ctx_add_adaptive(ctx, 1000, 100, adaptive_timeout_callback, NULL);
+    assert(channel >= 0);
+    
+    adaptive_fired_at = 0;
+    for (int i = 0; i < 100; i++) {
+        usleep(5000);
+        assert(z_wdt_ctx_feed(ctx, channel) == 0);
+    }
+    assert(adaptive_fired_at == 0);
+    
+    // Stall: the fixed period would take a second
+    int64_t stalled = z_wdt_now();
+    for (int i = 0; i < 100 && adaptive_fired_at == 0; i++) {
+        usleep(10000);
+    }
+    assert(adaptive_fired_at != 0);
+    int64_t elapsed_ms = (adaptive_fired_at - stalled) * 1000 / WATCHDOG_TICK_HZ;
+    assert(elapsed_ms >= 90 && elapsed_ms < 500);
+    printf("✓ Stalled 5ms feeder detected after %lldms (period 1000ms)\n", (long long)elapsed_ms);
+    
+    z_wdt_destroy(ctx);
+}
+
+#ifndef _WIN32
+// Shared by the feeder threads of test_progress_channel
+static volatile bool progress_feeding = true;
+static volatile int progress_timeouts = 0;
+static z_wdt_ctx_t *progress_ctx;
+static int progress_channel;
+
+void progress_timeout_callback(int channel_id, void *user_data) {
+    (void)channel_id;
+    (void)user_data;
+    progress_timeouts++;
+}
+
+static void *progress_feeder(void *arg) {
+    (void)arg;
+    while (progress_feeding) {
+        assert(z_wdt_ctx_feed(progress_ctx, progress_channel) == 0);
+        usleep(1000);
+    }
+    return NULL;
+}
+
+// Test several threads keeping one progress channel alive
+void test_progress_channel(void) {
+    printf("\n=== Testing Progress Channel ===\n");
+    
+    progress_ctx = z_wdt_create(NULL);
+    assert(progress_ctx != NULL);
+    progress_channel = z_wdt_ctx_add_progress(progress_ctx, 200, progress_timeout_callback, NULL);
+    assert(progress_channel >= 0);
+    
+    pthread_t threads[4];
+    progress_feeding = true;
+    progress_timeouts = 0;
+    for (int i = 0; i < 4; i++) {
+        assert(pthread_create(&threads[i], NULL, progress_feeder, NULL) == 0);
+    }
+    usleep(800000);
+    progress_feeding = false;
+    for (int i = 0; i < 4; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    assert(progress_timeouts == 0);
+    printf("✓ Four feeder threads kept the channel alive\n");
+    
+    // Detected at the second check without progress at the latest
+    usleep(500000);
+    assert(progress_timeouts == 1);
+    assert(z_wdt_ctx_feed(progress_ctx, progress_channel) == -1);
+    printf("✓ Channel timed out once the feeders stopped\n");
+    
+    z_wdt_destroy(progress_ctx);
+}
+#endif
+
+#ifndef _WIN32
+// Threads creating and destroying contexts in test_concurrent_contexts
+#define LIFECYCLE_THREADS 4
+#define LIFECYCLE_ROUNDS 100
+
+static void *lifecycle_worker(void *arg) {
+    intptr_t worker = (intptr_t)arg;
+    for (int round = 0; round < LIFECYCLE_ROUNDS; round++) {
+        // Alternate threaded and external loop contexts, so the log thread
+        // starts and stops under contention too
+        z_wdt_config config = { .external_loop = (round + worker) % 2 };
+        z_wdt_ctx_t *ctx = z_wdt_create(&config);
+        assert(ctx != NULL);
+        int channel = z_wdt_ctx_add(ctx, 1000, context_timeout_callback, (void *)0);
+        assert(channel >= 0);
+        assert(z_wdt_ctx_feed(ctx, channel) == 0);
+        assert(z_wdt_ctx_delete(ctx, channel) == 0);
+        z_wdt_destroy(ctx);
+    }
+    return NULL;
+}
+
+// Test contexts created and destroyed from several threads at once, with
+// no other context holding the platform services up
+void test_concurrent_contexts(void) {
+    printf("\n=== Testing Concurrent Context Lifecycle ===\n");
+    
+    pthread_t threads[LIFECYCLE_THREADS];
+    for (intptr_t i = 0; i < LIFECYCLE_THREADS; i++) {
+        assert(pthread_create(&threads[i], NULL, lifecycle_worker, (void *)i) == 0);
+    }
+    for (int i = 0; i < LIFECYCLE_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    printf("✓ %d threads created and destroyed %d contexts each\n", LIFECYCLE_THREADS, LIFECYCLE_ROUNDS);
+    
+    // The platform was stopped after the last one and starts again
+    z_wdt_ctx_t *ctx = z_wdt_create(NULL);
+    assert(ctx != NULL);
+    z_wdt_destroy(ctx);
+    printf("✓ Platform services restarted after the last context\n");
+}
+#endif
+
+// Counts group timeouts in test_channel_groups
+static volatile int group_timeouts = 0;
+static volatile int group_timeout_id = -1;
+
+void group_timeout_callback(int channel_id, void *user_data) {
+    (void)user_data;
+    group_timeout_id = channel_id;
+    group_timeouts++;
+}
+
+// Test a group of worker channels reporting as one
+void test_channel_groups(void) {
+    printf("\n=== Testing Channel Groups ===\n");
+    
+    // Members go into their group's shard, wherever the caller would place them
+#ifdef WATCHDOG_STATIC_CHANNELS
+    z_wdt_config config = { .shards = 1 };
+#else
+    z_wdt_config config = { .shards = 4 };
+#endif
+    z_wdt_ctx_t *ctx = z_wdt_create(&config);
+    assert(ctx != NULL);
+    
+    int group = z_wdt_ctx_group_create(ctx, group_timeout_callback, NULL);
+    assert(group >= 0);
+    int workers[3];
+    for (int i = 0; i < 3; i++) {
+        workers[i] = z_wdt_ctx_group_add(ctx, group, 300, NULL, NULL);
+        assert(workers[i] >= 0);
+    }
+    assert(z_wdt_ctx_group_add(ctx, group, 0, NULL, NULL) == -1);
+    assert(z_wdt_ctx_group_add(ctx, workers[0], 300, NULL, NULL) == -1);
+    assert(z_wdt_ctx_feed(ctx, group) == -1);
+    
+    // Every worker fed: the group stays healthy
+    group_timeouts = 0;
+    for (int round = 0; round < 6; round++) {
+        usleep(100000);
+        assert(z_wdt_ctx_feed_many(ctx, workers, 3) == 3);
+    }
+    assert(group_timeouts == 0);
+    printf("✓ Group stayed healthy while all workers were fed\n");
+    
+    // One worker stops: the group times out once and takes the others along
+    for (int round = 0; round < 6; round++) {
+        usleep(100000);
+        z_wdt_ctx_feed_many(ctx, workers, 2);
+    }
+    assert(group_timeouts == 1 && group_timeout_id == group);
+    assert(z_wdt_ctx_feed_many(ctx, workers, 3) == 0);
+    assert(z_wdt_ctx_delete(ctx, group) == -1);
+    printf("✓ Stalled worker timed out its group\n");
+    
+    z_wdt_destroy(ctx);
+}
+
+// Time of the timeout seen by critical_timeout_callback
+static volatile int64_t critical_fired_at = 0;
+
+void critical_timeout_callback(int channel_id, void *user_data) {
+    (void)channel_id;
+    (void)user_data;
+    critical_fired_at = z_wdt_now();
+}
+
+// Test critical channels on their real-time, pinned expiry thread. Without
+// the privilege for SCHED_FIFO or mlockall the thread still runs, at the
+// default priority.
+void test_critical_class(void) {
+    printf("\n=== Testing Critical Class ===\n");
+    
+    z_wdt_config config = { .critical_channels = 4, .critical_cpus = 1, .timer_resolution = 100 };
+    z_wdt_ctx_t *ctx = z_wdt_create(&config);
+    assert(ctx != NULL);
+    
+    critical_fired_at = 0;
+    context_timeouts[0] = 0;
+    int critical = z_wdt_ctx_add_class(ctx, 200, Z_WDT_CLASS_CRITICAL, critical_timeout_callback, NULL);
+    int normal = z_wdt_ctx_add(ctx, 200, context_timeout_callback, (void *)0);
+    assert(critical >= 0 && normal >= 0);
+    
+    for (int round = 0; round < 5; round++) {
+        usleep(100000);
+        assert(z_wdt_ctx_feed(ctx, critical) == 0);
+        assert(z_wdt_ctx_feed(ctx, normal) == 0);
+    }
+    assert(critical_fired_at == 0 && context_timeouts[0] == 0);
+    printf("✓ Fed critical and best-effort channels stayed healthy\n");
+    
+    // The critical thread isn't held to the 100ms timer resolution
+    int64_t deadline = z_wdt_now() + 200 * WATCHDOG_TICK_HZ / 1000;
+    assert(z_wdt_ctx_feed(ctx, critical) == 0);
+    usleep(400000);
+    assert(critical_fired_at >= deadline && critical_fired_at < deadline + 50 * WATCHDOG_TICK_HZ / 1000);
+    assert(context_timeouts[0] == 1);
+    assert(z_wdt_ctx_feed(ctx, critical) == -1);
+    printf("✓ Critical channel timed out %lld ticks after its deadline\n",
+           (long long)(critical_fired_at - deadline));
+    
+    z_wdt_destroy(ctx);
+}
+
+// Test a file-backed flight recorder across a real timeout, read back
+// from the file once the context is gone
+void test_flight_recorder(void) {
+    printf("\n=== Testing Flight Recorder ===\n");
+    
+    const char *path = "watchdog_test.rec";
+    z_wdt_config config = { .recorder_path = path };
+    z_wdt_ctx_t *ctx = z_wdt_create(&config);
+    assert(ctx != NULL);
+    
+    context_timeouts[0] = 0;
+    int fed = z_wdt_ctx_add(ctx, 200, context_timeout_callback, (void *)0);
+    int hung = z_wdt_ctx_add(ctx, 150, context_timeout_callback, (void *)0);
+    assert(fed >= 0 && hung >= 0);
+    for (int round = 0; round < 4; round++) {
+        usleep(100000);
+        assert(z_wdt_ctx_feed(ctx, fed) == 0);
+    }
+    assert(context_timeouts[0] == 1);
+    z_wdt_destroy(ctx);
+    
+    // Feeds come from this thread, the timeout from the timer thread
+    z_wdt_recorder_t *recorder = z_wdt_recorder_open(path);
+    assert(recorder != NULL);
+    z_wdt_event events[16];
+    int count = z_wdt_recorder_events(recorder, events, 16);
+    int feeds = 0, timeouts = 0;
+    uint32_t feeder = 0;
+    for (int i = 0; i < count; i++) {
+        assert(i == 0 || events[i].ticks >= events[i - 1].ticks);
+        if (events[i].type == Z_WDT_EVENT_FEED) {
+            assert(events[i].channel_id == fed && (feeds++ == 0 || events[i].thread == feeder));
+            feeder = events[i].thread;
+        } else if (events[i].type == Z_WDT_EVENT_TIMEOUT) {
+            assert(events[i].channel_id == hung);
+            timeouts++;
+        }
+    }
+    assert(count == 7 && feeds == 4 && timeouts == 1);
+    for (int i = 0; i < count; i++) {
+        assert(events[i].type != Z_WDT_EVENT_TIMEOUT || events[i].thread != feeder);
+    }
+    printf("✓ Recorded %d events, the timeout on the timer thread\n", count);
+    
+    z_wdt_channel_snapshot channels[4];
+    int64_t taken;
+    assert(z_wdt_recorder_channels(recorder, channels, 4, &taken) == 1);
+    assert(channels[0].channel_id == fed && channels[0].deadline > taken);
+    z_wdt_recorder_close(recorder);
+    remove(path);
+    printf("✓ Snapshot in the file holds the fed channel ahead of its deadline\n");
+}
+
+// Test pausing one group of channels while another keeps running
+void test_channel_suspend(void) {
+    printf("\n=== Testing Channel Suspend/Resume ===\n");
+    
+    z_wdt_ctx_t *ctx = z_wdt_create(NULL);
+    assert(ctx != NULL);
+    
+    int gpu = z_wdt_ctx_group_create(ctx, group_timeout_callback, NULL);
+    assert(gpu >= 0);
+    int kernels[2];
+    for (int i = 0; i < 2; i++) {
+        kernels[i] = z_wdt_ctx_group_add(ctx, gpu, 200, NULL, NULL);
+        assert(kernels[i] >= 0);
+    }
+    int cpu = z_wdt_ctx_add(ctx, 200, group_timeout_callback, NULL);
+    assert(cpu >= 0);
+    
+    // A long kernel: the GPU channels go unfed while suspended
+    group_timeouts = 0;
+    assert(z_wdt_ctx_channel_suspend(ctx, gpu) == 0);
+    for (int round = 0; round < 6; round++) {
+        usleep(100000);
+        assert(z_wdt_ctx_feed(ctx, cpu) == 0);
+        assert(z_wdt_ctx_feed(ctx, kernels[0]) == 0);
+    }
+    assert(group_timeouts == 0);
+    printf("✓ Suspended group stayed quiet for 600ms of its 200ms period\n");
+    
+    // Resumed with a fresh period, the stalled GPU channels time it out
+    assert(z_wdt_ctx_channel_resume(ctx, gpu) == 0);
+    for (int round = 0; round < 6; round++) {
+        usleep(100000);
+        assert(z_wdt_ctx_feed(ctx, cpu) == 0);
+    }
+    assert(group_timeouts == 1 && group_timeout_id == gpu);
+    assert(z_wdt_ctx_channel_resume(ctx, gpu) == -1);
+    printf("✓ Group timed out after resume while the CPU channel ran on\n");
+    
+    z_wdt_destroy(ctx);
+}
+
+// Test the instrumentation snapshot and its Prometheus export
+void test_statistics(void) {
+    printf("\n=== Testing Statistics ===\n");
+    
+    z_wdt_ctx_t *ctx = z_wdt_create(NULL);
+    assert(ctx != NULL);
+    
+    z_wdt_stats stats;
+    if (z_wdt_ctx_stats_get(ctx, &stats) != 0) {
+        z_wdt_destroy(ctx);
+        printf("✓ Built without instrumentation, snapshots fail cleanly\n");
+        return;
+    }
+    assert(stats.feeds == 0 && stats.timeouts == 0);
+    
+    context_timeouts[0] = 0;
+    int channel = z_wdt_ctx_add(ctx, 200, context_timeout_callback, (void *)0);
+    assert(channel >= 0);
+    z_wdt_channel_stats channel_stats;
+    assert(z_wdt_ctx_channel_stats_get(ctx, channel, &channel_stats) == 0);
+    assert(channel_stats.feeds == 0 && channel_stats.min_margin_us == INT64_MAX);
+    
+    // Feed with 50-100ms left, then let the channel run out
+    for (int i = 0; i < 3; i++) {
+        usleep(100000);
+        assert(z_wdt_ctx_feed(ctx, channel) == 0);
+    }
+    assert(z_wdt_ctx_channel_stats_get(ctx, channel, &channel_stats) == 0);
+    assert(channel_stats.feeds == 3);
+    assert(channel_stats.min_margin_us > 0 && channel_stats.min_margin_us <= 100000);
+    printf("✓ Channel fed %llu times, closest with %lldus left\n",
+           (unsigned long long)channel_stats.feeds, (long long)channel_stats.min_margin_us);
+    
+    usleep(400000);
+    assert(context_timeouts[0] == 1);
+    assert(z_wdt_ctx_channel_stats_get(ctx, channel, &channel_stats) == -1);
+    assert(z_wdt_ctx_stats_get(ctx, &stats) == 0);
+    assert(stats.feeds == 3);
+    assert(stats.timeouts == 1 && stats.detection_latency.count == 1);
+    assert(stats.detection_latency.max_ns < 200000000ull);
+    assert(stats.callback_duration.count == 1);
+    assert(stats.wakeups >= 1 && stats.lock_hold.count >= 1 && stats.lock_wait.count == stats.lock_hold.count);
+    printf("✓ Timeout detected %lluus late\n", (unsigned long long)(stats.detection_latency.max_ns / 1000));
+    
+    // The export reports its full length like snprintf()
+    int length = z_wdt_stats_prometheus(&stats, NULL, 0);
+    assert(length > 0);
+    char *text = malloc((size_t)length + 1);
+    assert(text != NULL);
+    assert(z_wdt_stats_prometheus(&stats, text, (size_t)length + 1) == length);
+    assert(strstr(text, "\nz_wdt_feeds_total 3\n") != NULL);
+    assert(strstr(text, "\nz_wdt_timeouts_total 1\n") != NULL);
+    assert(strstr(text, "z_wdt_detection_latency_seconds_bucket{le=\"+Inf\"} 1\n") != NULL);
+    assert(strstr(text, "\nz_wdt_lock_hold_seconds_count ") != NULL);
+    free(text);
+    printf("✓ Prometheus export of %d bytes\n", length);
+    
+    z_wdt_destroy(ctx);
+}
+
+// Test chaining the hardware watchdog; without a device enable must fail cleanly
+void test_hardware_watchdog(void) {
+    printf("\n=== Testing Hardware Watchdog ===\n");
+    
+    if (z_wdt_hw_enable(2000) != 0) {
+        int channel = z_wdt_add(1000, watchdog_timeout_callback, &test_tasks[0]);
+        assert(channel >= 0);
+        assert(z_wdt_delete(channel) == 0);
+        printf("✓ No hardware watchdog available, enable failed cleanly\n");
+        return;
+    }
+    
+    // A second owner is refused while the first pets the device
+    z_wdt_ctx_t *ctx = z_wdt_create(NULL);
+    assert(ctx != NULL);
+    assert(z_wdt_ctx_hw_enable(ctx, 2000) == -1);
+    z_wdt_destroy(ctx);
+    
+    int channel = z_wdt_add(500, watchdog_timeout_callback, &test_tasks[0]);
+    assert(channel >= 0);
+    for (int round = 0; round < 6; round++) {
+        usleep(250000);
+        assert(z_wdt_feed(channel) == 0);
+    }
+    assert(z_wdt_delete(channel) == 0);
+    z_wdt_hw_disable();
+    printf("✓ Hardware watchdog petted and disarmed\n");
+}
+
+#ifndef _WIN32
+// Events seen by the shared-memory supervisor
+static int shm_timeouts = 0;
+static int shm_exits = 0;
+
+static void shm_event_callback(const z_wdt_shm_event *event, void *user_data) {
+    (void)user_data;
+    
+    printf("Shared-memory channel %d (%s, pid %d) %s\n", event->channel_id, event->label, (int)event->pid,
+           event->reason == Z_WDT_SHM_EXITED ? "exited" : "timed out");
+    if (event->reason == Z_WDT_SHM_EXITED) {
+        shm_exits++;
+    } else {
+        shm_timeouts++;
+    }
+}
+
+// Worker process: feed a slot a few times, then hang for a while or exit
+static void shm_worker(const char *name, const char *label, bool hang) {
+    z_wdt_shm_t *shm = z_wdt_shm_attach(name);
+    int channel = shm ? z_wdt_shm_add(shm, 100, label) : -1;
+    if (channel < 0) {
+        _exit(1);
+    }
+    
+    for (int i = 0; i < 5; i++) {
+        usleep(30000);
+        if (z_wdt_shm_feed(shm, channel) != 0) {
+            _exit(1);
+        }
+    }
+    if (hang) {
+        usleep(1000000);
+    }
+    _exit(0);
+}
+
+// Test supervising forked worker processes through a shared-memory region
+void test_shared_memory(void) {
+    printf("\n=== Testing Shared-Memory Supervision ===\n");
+    
+    char name[Z_WDT_SHM_NAME_MAX];
+    snprintf(name, sizeof(name), "/z_wdt_test_%d", (int)getpid());
+    z_wdt_shm_t *shm = z_wdt_shm_create(name, 8, shm_event_callback, NULL);
+    if (shm == NULL) {
+        printf("✓ No shared memory available, create failed cleanly\n");
+        return;
+    }
+    
+    pid_t workers[2];
+    for (int i = 0; i < 2; i++) {
+        workers[i] = fork();
+        assert(workers[i] >= 0);
+        if (workers[i] == 0) {
+            shm_worker(name, i == 0 ? "hang" : "exit", i == 0);
+        }
+    }
+    
+    // Supervise until both workers are reported; reap the one that exits
+    // so it stops counting as alive
+    int passes = 0;
+    while (shm_timeouts + shm_exits < 2 && passes < 100) {
+        assert(z_wdt_shm_process(shm) >= 0);
+        for (int i = 0; i < 2; i++) {
+            int status;
+            if (workers[i] > 0 && waitpid(workers[i], &status, WNOHANG) == workers[i]) {
+                assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+                workers[i] = -1;
+            }
+        }
+        assert(z_wdt_shm_wait(shm) == 0);
+        passes++;
+    }
+    assert(shm_timeouts == 1 && shm_exits == 1);
+    printf("✓ Hung worker timed out, exited worker reported, %d supervisor passes\n", passes);
+    
+    for (int i = 0; i < 2; i++) {
+        if (workers[i] > 0) {
+            waitpid(workers[i], NULL, 0);
+        }
+    }
+    z_wdt_shm_close(shm);
+    assert(z_wdt_shm_attach(name) == NULL);
+}
+#endif
+
+// Callback that re-enters the API, which needs the mutex to be released
+static volatile bool reentry_fired = false;
+static volatile int reentry_channel = -1;
+
+void reentrant_timeout_callback(int channel_id, void *user_data) {
+    (void)user_data;
+    
+    printf("Re-entrant callback for channel %d\n", channel_id);
+    reentry_channel = z_wdt_add(60000, watchdog_timeout_callback, &test_tasks[0]);
+    reentry_fired = true;
+}
+
+// Executor that counts the callbacks it runs
+void counting_executor(watchdog_callback_t callback, int channel_id, void *user_data, void *context) {
+    (*(volatile int *)context)++;
+    callback(channel_id, user_data);
+}
+
+// Run one re-entrant timeout under the given dispatch configuration
+static void run_reentrant_timeout(const z_wdt_config *config) {
+    z_wdt_cleanup();
+    assert(z_wdt_init_ex(config) == 0);
+    
+    reentry_fired = false;
+    reentry_channel = -1;
+    int channel = z_wdt_add(200, reentrant_timeout_callback, NULL);
+    assert(channel >= 0);
+    
+    usleep(600000);
+    assert(reentry_fired);
+    assert(reentry_channel >= 0 && reentry_channel != channel);
+    assert(z_wdt_feed(channel) == -1);
+    assert(z_wdt_delete(reentry_channel) == 0);
+}
+
+// Test callback dispatch outside the watchdog mutex
+void test_callback_dispatch(void) {
+    printf("\n=== Testing Callback Dispatch ===\n");
+    
+    run_reentrant_timeout(NULL);
+    printf("✓ Timer thread callback re-entered the API\n");
+    
+    z_wdt_config pool_config = { .dispatch_workers = 2 };
+    run_reentrant_timeout(&pool_config);
+    printf("✓ Worker pool callback re-entered the API\n");
+    
+    volatile int executor_calls = 0;
+    z_wdt_config executor_config = { .executor = counting_executor, .executor_context = (void *)&executor_calls };
+    run_reentrant_timeout(&executor_config);
+    assert(executor_calls == 1);
+    printf("✓ User executor ran the callback\n");
+}
+
 int main(void) {
     printf("Embedded Watchdog Framework Test Suite\n");
     printf("=====================================\n");
@@ -380,11 +1256,38 @@ int main(void) {
     test_multiple_channels();
     test_suspend_resume();
     test_error_conditions();
+    test_timeout_order();
+    test_batch_feed();
     test_maximum_channels();
+#ifndef WATCHDOG_STATIC_CHANNELS
+    test_dynamic_table();
+    test_sharded_channels();
+    test_critical_class();
+#endif
+    test_callback_dispatch();
+    test_multiple_contexts();
+    test_external_loop();
+    test_timer_slack();
+    test_adaptive_timeout();
+#ifndef _WIN32
+    test_progress_channel();
+#endif
+    test_channel_groups();
+    test_channel_suspend();
+    test_flight_recorder();
+    test_statistics();
+    test_hardware_watchdog();
     
     // Clean up
     z_wdt_cleanup();
     
+#ifndef _WIN32
+    test_concurrent_contexts();
+    
+    // Forks worker processes, so it runs with no timer or log thread left
+    test_shared_memory();
+#endif
+    
     // Print results
     printf("\n=== Test Results ===\n");
     if (test_failures == 0) {
@@ -0,0 +1,215 @@
+/*
+ * Timing wheel tests
+ * The core is built for this program with the wheel scheduler whatever
+ * SCHED is, on a small, coarse wheel (see the Makefile), so level
+ * cascades and deadlines past the wheel span come up within a few
+ * thousand ticks. Linked against the mock platform like the virtual-time
+ * suite: every timeout must fire on the first slot boundary at or after
+ * its deadline, never earlier and never later.
+ */
+
+#include "z_wdt_internal.h"
+#include "watchdog_os_mock.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#if WATCHDOG_SCHEDULER != WATCHDOG_SCHED_WHEEL
+#error "watchdog_wheel_test must be built with -DWATCHDOG_SCHEDULER=WATCHDOG_SCHED_WHEEL"
+#endif
+
+#ifdef WATCHDOG_STATIC_CHANNELS
+#define WHEEL_BATCH WATCHDOG_MAX_CHANNELS
+#else
+#define WHEEL_BATCH 512
+#endif
+
+/* Wheel geometry in ticks */
+#define WHEEL_SLOT  ((int64_t)WATCHDOG_WHEEL_RESOLUTION)
+#define WHEEL_LEVEL1 (WHEEL_SLOT * WATCHDOG_WHEEL_SIZE)
+#define WHEEL_SPAN  (WHEEL_SLOT << (WATCHDOG_WHEEL_BITS * WATCHDOG_WHEEL_LEVELS))
+
+// One channel under test: when it should fire and when it did
+struct wheel_probe {
+    int channel;
+    int64_t expected;
+    int64_t fired_at;
+    int fired;
+};
+
+static struct wheel_probe probes[WHEEL_BATCH];
+
+static void probe_callback(int channel_id, void *user_data) {
+    struct wheel_probe *probe = user_data;
+    assert(probe->channel == channel_id);
+    probe->fired++;
+    probe->fired_at = z_wdt_now();
+}
+
+// Reload period in ticks, as the core rounds it
+static int64_t wheel_ticks(uint32_t ms) {
+    return ((int64_t)ms * WATCHDOG_TICK_HZ + 999) / 1000;
+}
+
+// Shortest period in ms that is at least the given number of ticks
+static uint32_t wheel_ms(int64_t ticks) {
+    return (uint32_t)((ticks * 1000 + WATCHDOG_TICK_HZ - 1) / WATCHDOG_TICK_HZ);
+}
+
+// First wheel slot boundary at or after a deadline
+static int64_t wheel_round(int64_t ticks) {
+    return (ticks + WHEEL_SLOT - 1) / WHEEL_SLOT * WHEEL_SLOT;
+}
+
+// Whether one of the first count probes is due on the given tick
+static bool probe_due(int count, int64_t tick) {
+    for (int i = 0; i < count; i++) {
+        if (probes[i].expected == tick) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Add one channel per period at the current tick, run the clock past the
+// last of them and check that each fired once, on its expected tick. With
+// every deadline inside the wheel span, the timer must also only wake for
+// an expiry or to cascade a level 1 slot, never early for nothing.
+static void run_batch(const uint32_t *periods, int count) {
+    int64_t start = z_wdt_now();
+    int64_t last = start;
+    for (int i = 0; i < count; i++) {
+        struct wheel_probe *probe = &probes[i];
+        memset(probe, 0, sizeof(*probe));
+        probe->channel = z_wdt_add(periods[i], probe_callback, probe);
+        assert(probe->channel >= 0);
+        probe->expected = wheel_round(start + wheel_ticks(periods[i]));
+        if (probe->expected > last) {
+            last = probe->expected;
+        }
+    }
+
+    bool within_span = last - start < WHEEL_SPAN;
+    int64_t next;
+    while ((next = watchdog_mock_next_timer()) <= last) {
+        assert(!within_span || next % WHEEL_LEVEL1 == 0 || probe_due(count, next));
+        watchdog_mock_advance(next - z_wdt_now());
+    }
+    watchdog_mock_advance(last - z_wdt_now());
+    for (int i = 0; i < count; i++) {
+        assert(probes[i].fired == 1);
+        assert(probes[i].fired_at == probes[i].expected);
+    }
+}
+
+// Test every deadline across three level 1 slots, from every phase of a level 0 slot
+void test_wheel_cascade(void) {
+    printf("\n=== Testing Level Cascades ===\n");
+
+    z_wdt_config config = { .max_channels = WHEEL_BATCH };
+    assert(z_wdt_init_ex(&config) == 0);
+
+    uint32_t periods[WHEEL_BATCH];
+    uint32_t longest = wheel_ms(3 * WHEEL_LEVEL1);
+    int checked = 0;
+    for (int64_t phase = 0; phase < WHEEL_SLOT + 1; phase++) {
+        // Start mid-way into a level 1 slot, off the level 0 grid by phase
+        int64_t now = z_wdt_now();
+        watchdog_mock_advance(wheel_round(now) + WHEEL_LEVEL1 / 2 + phase - now);
+
+        int count = 0;
+        for (uint32_t period = 1; period <= longest; period++) {
+            periods[count++] = period;
+            if (count == WHEEL_BATCH || period == longest) {
+                run_batch(periods, count);
+                checked += count;
+                count = 0;
+            }
+        }
+    }
+
+    z_wdt_cleanup();
+    printf("✓ %d timeouts across level boundaries fired on their slot's tick\n", checked);
+}
+
+// Test deadlines at and beyond the wheel span: they are parked in the top
+// level and re-linked as the wheel turns, and must still fire on time
+void test_wheel_beyond_span(void) {
+    printf("\n=== Testing Deadlines Beyond the Wheel Span ===\n");
+
+    z_wdt_config config = { .max_channels = WHEEL_BATCH };
+    assert(z_wdt_init_ex(&config) == 0);
+
+    const int64_t spans[] = {
+        WHEEL_SPAN - WHEEL_SLOT, WHEEL_SPAN - 1, WHEEL_SPAN, WHEEL_SPAN + 1,
+        WHEEL_SPAN + WHEEL_LEVEL1, 2 * WHEEL_SPAN + WHEEL_SLOT + 1, 5 * WHEEL_SPAN + 7,
+    };
+    int count = (int)(sizeof(spans) / sizeof(spans[0]));
+    assert(count <= WHEEL_BATCH);
+    uint32_t periods[sizeof(spans) / sizeof(spans[0])];
+    for (int i = 0; i < count; i++) {
+        periods[i] = wheel_ms(spans[i]);
+    }
+    run_batch(periods, count);
+
+    // After a long idle stretch the wheel catches up before linking
+    watchdog_mock_advance(3 * WHEEL_SPAN + 5);
+    run_batch(periods, count);
+
+    z_wdt_cleanup();
+    printf("✓ Timeouts up to five wheel spans away fired on their slot's tick\n");
+}
+
+// Test feeds that move a queued channel between levels: each feed lands
+// just before the channel's slot would cascade or expire
+void test_wheel_feed_across_levels(void) {
+    printf("\n=== Testing Feeds Across Levels ===\n");
+
+    assert(z_wdt_init() == 0);
+
+    const int64_t lengths[] = { WHEEL_SLOT, WHEEL_LEVEL1 - 1, WHEEL_LEVEL1 + 1, WHEEL_SPAN + WHEEL_LEVEL1 };
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        uint32_t period = wheel_ms(lengths[l]);
+        int64_t ticks = wheel_ticks(period);
+        struct wheel_probe *probe = &probes[0];
+        memset(probe, 0, sizeof(*probe));
+        probe->channel = z_wdt_add(period, probe_callback, probe);
+        assert(probe->channel >= 0);
+
+        // Alternate feeds one tick before the deadline with earlier ones
+        int64_t fed_at = z_wdt_now();
+        for (int i = 0; i < 20; i++) {
+            int64_t step = i % 2 ? ticks - 1 : 1 + (ticks - 2) * (i % 3) / 2;
+            watchdog_mock_advance(step);
+            assert(probe->fired == 0);
+            assert(z_wdt_feed(probe->channel) == 0);
+            fed_at = z_wdt_now();
+        }
+
+        probe->expected = wheel_round(fed_at + ticks);
+        watchdog_mock_advance(probe->expected - 1 - z_wdt_now());
+        assert(probe->fired == 0);
+        watchdog_mock_advance(1);
+        assert(probe->fired == 1 && probe->fired_at == probe->expected);
+    }
+
+    z_wdt_cleanup();
+    printf("✓ Fed channels moved between levels and fired one period after the last feed\n");
+}
+
+int main(void) {
+    printf("Embedded Watchdog Framework Timing Wheel Test Suite\n");
+    printf("===================================================\n");
+    printf("Wheel: %d tick(s) per slot, %d levels of %d slots, span %lld ticks\n",
+           WATCHDOG_WHEEL_RESOLUTION, WATCHDOG_WHEEL_LEVELS, WATCHDOG_WHEEL_SIZE, (long long)WHEEL_SPAN);
+
+    test_wheel_cascade();
+    test_wheel_beyond_span();
+    test_wheel_feed_across_levels();
+
+    printf("\n=== Test Results ===\n");
+    printf("✓ All tests passed!\n");
+    return 0;
+}
@@ -2,278 +2,2025 @@
  * Embedded Watchdog Framework Implementation
  */
 
-#include "z_wdt.h"
+#include "z_wdt_internal.h"
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-/* Internal data structures */
-struct watchdog_channel {
-    uint32_t reload_period;        // Period in milliseconds
-    int64_t timeout_abs_ticks;     // Absolute timeout in ticks
-    void *user_data;               // User data for callback
-    watchdog_callback_t callback;  // Callback function
-    bool active;                   // Channel active flag
-};
-
-struct watchdog_context {
-    struct watchdog_channel channels[WATCHDOG_MAX_CHANNELS];
-    int64_t current_ticks;         // Current system ticks
-    int next_timeout_channel;      // Next channel to timeout
-    int64_t next_timeout_ticks;    // Next timeout in ticks
-    bool initialized;              // Initialization flag
-    bool timer_running;            // Timer running flag
-};
-
-/* Global watchdog context */
+/* Default context behind the z_wdt_init() API */
 static struct watchdog_context g_watchdog_ctx = {0};
 
-/* Platform abstraction functions (must be implemented by platform layer) */
-extern int64_t watchdog_get_ticks(void);
-extern void watchdog_timer_start(int64_t timeout_ticks);
-extern void watchdog_timer_stop(void);
-extern void watchdog_log(const char *level, const char *format, ...);
-extern int watchdog_os_init(void);
-extern void watchdog_os_cleanup(void);
-extern void watchdog_mutex_lock(void);
-extern void watchdog_mutex_unlock(void);
+#ifdef WATCHDOG_STATIC_CHANNELS
+static struct watchdog_context g_static_contexts[WATCHDOG_MAX_CONTEXTS];
+#endif
+
+/* Context owning the hardware watchdog (NULL if none; claimed by CAS) */
+static struct watchdog_context *g_hw_owner = NULL;
+
+/* Contexts sharing the platform services, and those with threads needing the log thread */
+static uint32_t g_watchdog_users = 0;
+static uint32_t g_watchdog_log_users = 0;
+
+/*
+ * Spin lock serializing context creation and destruction: the static pool
+ * and the users counts above. A platform mutex cannot guard them, since
+ * the platform is started under it; it is held only to claim a slot or to
+ * start or stop the shared services.
+ */
+static uint32_t g_watchdog_lifecycle_lock = 0;
 
 /* Internal utility functions */
-static int64_t watchdog_ms_to_ticks(uint32_t ms);
-static int watchdog_get_next_timeout_channel(void);
-static void watchdog_schedule_next_timeout(void);
+static uint64_t watchdog_ticks_to_ns(int64_t ticks);
+static bool watchdog_adaptive_sample(struct watchdog_channel *channel, int64_t current_ticks, int64_t resumed_at);
+static int watchdog_add_channel(struct watchdog_context *ctx, uint32_t reload_period, uint32_t slack,
+                                uint32_t min_period, bool progress, bool critical,
+                                const z_wdt_escalation *escalation, watchdog_callback_t callback,
+                                void *user_data);
+static int watchdog_progress_claim(struct watchdog_progress *progress);
+static uint64_t watchdog_progress_total(const struct watchdog_progress *progress, int column);
+static void watchdog_lifecycle_lock(void);
+static void watchdog_lifecycle_unlock(void);
+static int watchdog_platform_acquire(bool threaded);
+static void watchdog_platform_release(bool threaded);
+static int watchdog_context_init(struct watchdog_context *ctx, const z_wdt_config *config);
+static void watchdog_context_release(struct watchdog_context *ctx);
+static void watchdog_context_free(struct watchdog_context *ctx);
+static int watchdog_shard_init(struct watchdog_shard *shard, uint32_t index,
+                               uint32_t max_channels, uint32_t initial_channels);
+static void watchdog_release_shards(struct watchdog_context *ctx);
+static struct watchdog_shard *watchdog_shard_of(struct watchdog_context *ctx, int channel_id);
+static struct watchdog_channel *watchdog_resolve(struct watchdog_shard *shard, int channel_id,
+                                                 uint32_t *generation);
+static int watchdog_feed_at(struct watchdog_context *ctx, int channel_id, int64_t current_ticks);
+static int watchdog_feed_slot(struct watchdog_context *ctx, struct watchdog_shard *shard,
+                              struct watchdog_channel *channel, int index, uint32_t generation,
+                              int64_t current_ticks);
+static void watchdog_feed_requeue(struct watchdog_shard *shard, int channel_id);
+static int watchdog_alloc_slot(struct watchdog_shard *shard);
+static int watchdog_claim_slot(struct watchdog_context *ctx, bool critical, struct watchdog_shard **shard);
+static void watchdog_release_slot(struct watchdog_shard *shard, int index);
+static void watchdog_retire_channel(struct watchdog_shard *shard, int index);
+static void watchdog_push_expired(struct watchdog_shard *shard, int index);
+static void watchdog_group_unlink(struct watchdog_shard *shard, int index);
+static void watchdog_group_expired(struct watchdog_shard *shard, int index);
+static void watchdog_feed_channel(struct watchdog_shard *shard, int index, int64_t current_ticks);
+static int64_t watchdog_effective_timeout(struct watchdog_shard *shard, int index);
+static int watchdog_set_suspended(struct watchdog_context *ctx, int channel_id, bool suspended);
+static void watchdog_requeue_channel(struct watchdog_shard *shard, int index, int64_t timeout);
+static void watchdog_process_shard(struct watchdog_context *ctx, struct watchdog_shard *shard);
+static void watchdog_channel_expired(struct watchdog_shard *shard, int index);
+static void watchdog_channel_escalate(struct watchdog_shard *shard, int index, int64_t timeout);
+static void watchdog_dispatch_stage(struct watchdog_context *ctx, const struct watchdog_stage_event *event);
+static void watchdog_dispatch_timeout(struct watchdog_context *ctx, struct watchdog_shard *shard, int index);
+static void watchdog_run_callback(struct watchdog_context *ctx, watchdog_callback_t callback, int channel_id,
+                                  void *user_data);
+static void watchdog_schedule_next_timeout(struct watchdog_context *ctx, struct watchdog_shard *shard);
+static void watchdog_arm_timer(struct watchdog_context *ctx);
+static void watchdog_arm_critical(struct watchdog_context *ctx);
+static void watchdog_hw_channel(int channel_id, void *user_data);
+static void watchdog_hw_pet_if_healthy(struct watchdog_context *ctx);
+#ifdef Z_WDT_HAVE_STATIC_CHANNELS
+static int watchdog_register_static(struct watchdog_context *ctx);
+#endif
 
 // Initialize watchdog system
 int z_wdt_init(void) {
+    return z_wdt_init_ex(NULL);
+}
+
+// Initialize watchdog system with a runtime configuration
+int z_wdt_init_ex(const z_wdt_config *config) {
     if (g_watchdog_ctx.initialized) {
-        watchdog_log("WARN", "Watchdog already initialized");
+        WATCHDOG_LOG_WARN("Watchdog already initialized");
         return 0;
     }
     
-    // Initialize context
+    bool threaded = config == NULL || !config->external_loop;
+    if (watchdog_platform_acquire(threaded) != 0) {
+        return -1;
+    }
     memset(&g_watchdog_ctx, 0, sizeof(g_watchdog_ctx));
-    g_watchdog_ctx.next_timeout_channel = -1;
-    g_watchdog_ctx.next_timeout_ticks = INT64_MAX;
-    g_watchdog_ctx.initialized = true;
-    g_watchdog_ctx.timer_running = true;
-    
-    // Initialize OS layer
-    if (watchdog_os_init() != 0) {
+    if (watchdog_context_init(&g_watchdog_ctx, config) != 0) {
+        watchdog_platform_release(threaded);
+        return -1;
+    }
+#ifdef Z_WDT_HAVE_STATIC_CHANNELS
+    if (watchdog_register_static(&g_watchdog_ctx) != 0) {
+        watchdog_context_release(&g_watchdog_ctx);
+        watchdog_platform_release(threaded);
         return -1;
     }
+#endif
     
-    watchdog_log("INFO", "Watchdog initialized successfully");
+    WATCHDOG_LOG_INFO("Watchdog initialized successfully");
     return 0;
 }
 
-// Add a watchdog channel
-int z_wdt_add(uint32_t reload_period, watchdog_callback_t callback, void *user_data) {
-    if (!g_watchdog_ctx.initialized) {
-        watchdog_log("ERROR", "Watchdog not initialized");
+// Create an independent watchdog context
+z_wdt_ctx_t *z_wdt_create(const z_wdt_config *config) {
+    struct watchdog_context *ctx = NULL;
+    
+#ifdef WATCHDOG_STATIC_CHANNELS
+    watchdog_lifecycle_lock();
+    for (uint32_t i = 0; i < WATCHDOG_MAX_CONTEXTS && ctx == NULL; i++) {
+        if (!g_static_contexts[i].allocated) {
+            ctx = &g_static_contexts[i];
+            memset(ctx, 0, sizeof(*ctx));
+            ctx->allocated = true;
+        }
+    }
+    watchdog_lifecycle_unlock();
+#else
+    ctx = calloc(1, sizeof(*ctx));
+    if (ctx != NULL) {
+        ctx->allocated = true;
+    }
+#endif
+    if (ctx == NULL) {
+        WATCHDOG_LOG_ERROR("No watchdog context available");
+        return NULL;
+    }
+    
+    bool threaded = config == NULL || !config->external_loop;
+    if (watchdog_platform_acquire(threaded) != 0) {
+        watchdog_context_free(ctx);
+        return NULL;
+    }
+    if (watchdog_context_init(ctx, config) != 0) {
+        watchdog_platform_release(threaded);
+        watchdog_context_free(ctx);
+        return NULL;
+    }
+    
+    WATCHDOG_LOG_INFO("Watchdog context created");
+    return ctx;
+}
+
+// Destroy a context from z_wdt_create(); its channels are dropped
+void z_wdt_destroy(z_wdt_ctx_t *ctx) {
+    if (ctx == NULL || !ctx->allocated) {
+        return;
+    }
+    
+    if (ctx->initialized) {
+        bool threaded = !ctx->external;
+        watchdog_context_release(ctx);
+        watchdog_platform_release(threaded);
+    }
+    watchdog_context_free(ctx);
+}
+
+// Add a watchdog channel with the context's default slack
+int z_wdt_ctx_add(z_wdt_ctx_t *ctx, uint32_t reload_period, watchdog_callback_t callback, void *user_data) {
+    return z_wdt_ctx_add_ex(ctx, reload_period, ctx != NULL ? ctx->default_slack : 0, callback, user_data);
+}
+
+// Add a watchdog channel whose timeout may fire up to slack ms late, so
+// it can share a timer wakeup with nearby timeouts
+int z_wdt_ctx_add_ex(z_wdt_ctx_t *ctx, uint32_t reload_period, uint32_t slack,
+                     watchdog_callback_t callback, void *user_data) {
+    return watchdog_add_channel(ctx, reload_period, slack, 0, false, false, NULL, callback, user_data);
+}
+
+// Add a watchdog channel whose timeout follows its feed rate: once a few
+// feed intervals are known it is their mean plus four mean deviations,
+// kept within [min_period, reload_period] ms. min_period should cover the
+// scheduling jitter of the feeding thread.
+int z_wdt_ctx_add_adaptive(z_wdt_ctx_t *ctx, uint32_t reload_period, uint32_t min_period,
+                           watchdog_callback_t callback, void *user_data) {
+    if (min_period == 0 || min_period > reload_period) {
+        WATCHDOG_LOG_ERROR("Invalid adaptive period range: %u-%ums", min_period, reload_period);
+        return -1;
+    }
+    
+    return watchdog_add_channel(ctx, reload_period, ctx != NULL ? ctx->default_slack : 0, min_period,
+                                false, false, NULL, callback, user_data);
+}
+
+// Add a channel that is healthy while it makes progress: feeds from any
+// number of threads only bump a per-CPU counter, and a period without a
+// single feed times it out (detected one to two periods after the last)
+int z_wdt_ctx_add_progress(z_wdt_ctx_t *ctx, uint32_t reload_period, watchdog_callback_t callback,
+                           void *user_data) {
+    return watchdog_add_channel(ctx, reload_period, ctx != NULL ? ctx->default_slack : 0, 0,
+                                true, false, NULL, callback, user_data);
+}
+
+// Add a channel of the given class. Critical channels live in the
+// context's critical shard, expired by its real-time thread; they take no
+// slack, since only that thread's wakeups need to be on time.
+int z_wdt_ctx_add_class(z_wdt_ctx_t *ctx, uint32_t reload_period, z_wdt_class cls,
+                        watchdog_callback_t callback, void *user_data) {
+    if (cls == Z_WDT_CLASS_BEST_EFFORT) {
+        return z_wdt_ctx_add(ctx, reload_period, callback, user_data);
+    }
+    if (cls != Z_WDT_CLASS_CRITICAL || ctx == NULL || (ctx->initialized && ctx->critical == NULL)) {
+        WATCHDOG_LOG_ERROR("Channel class %d not configured", (int)cls);
+        return -1;
+    }
+    
+    return watchdog_add_channel(ctx, reload_period, 0, 0, false, true, NULL, callback, user_data);
+}
+
+// Add a channel that escalates instead of timing out at once: it runs the
+// warn, dump and restart actions at 50%, 100% and 150% of the period
+// without a feed, and times out with the reset action at 200%. escalation
+// may be NULL for the default actions and must outlive the channel.
+int z_wdt_ctx_add_escalating(z_wdt_ctx_t *ctx, uint32_t reload_period, const z_wdt_escalation *escalation,
+                             void *user_data) {
+    static const z_wdt_escalation defaults;
+    
+    escalation = escalation != NULL ? escalation : &defaults;
+    return watchdog_add_channel(ctx, reload_period, ctx != NULL ? ctx->default_slack : 0, 0, false, false,
+                                escalation, escalation->reset, user_data);
+}
+
+// Add a channel of any kind but a group member (min_period 0: fixed period,
+// escalation NULL: times out at its deadline)
+static int watchdog_add_channel(struct watchdog_context *ctx, uint32_t reload_period, uint32_t slack,
+                                uint32_t min_period, bool progress, bool critical,
+                                const z_wdt_escalation *escalation, watchdog_callback_t callback,
+                                void *user_data) {
+    if (ctx == NULL || !ctx->initialized) {
+        WATCHDOG_LOG_ERROR("Watchdog not initialized");
         return -1;
     }
     
     if (reload_period == 0) {
-        watchdog_log("ERROR", "Invalid reload period: 0");
+        WATCHDOG_LOG_ERROR("Invalid reload period: 0");
         return -1;
     }
     
-    watchdog_mutex_lock();
+    // Start each counter column from zero before feeders can see it
+    int column = -1;
+    if (progress) {
+        column = watchdog_progress_claim(&ctx->progress);
+        if (column < 0) {
+            WATCHDOG_LOG_ERROR("No available progress counters (max %u)", WATCHDOG_PROGRESS_CHANNELS);
+            return -1;
+        }
+    }
     
-    // Find unused channel
-    for (int id = 0; id < WATCHDOG_MAX_CHANNELS; id++) {
-        if (!g_watchdog_ctx.channels[id].active) {
-            g_watchdog_ctx.channels[id].reload_period = reload_period;
-            g_watchdog_ctx.channels[id].user_data = user_data;
-            g_watchdog_ctx.channels[id].timeout_abs_ticks = INT64_MAX;
-            g_watchdog_ctx.channels[id].callback = callback;
-            g_watchdog_ctx.channels[id].active = true;
-            
-            // Feed the channel immediately
-            z_wdt_feed(id);
-            
-            watchdog_mutex_unlock();
-            
-            watchdog_log("INFO", "Added watchdog channel %d with period %ums", id, reload_period);
-            return id;
+    struct watchdog_shard *shard;
+    int index = watchdog_claim_slot(ctx, critical, &shard);
+    if (index < 0) {
+        if (column >= 0) {
+            WATCHDOG_FETCH_AND(&ctx->progress.used, ~((uint64_t)1 << column));
         }
+        WATCHDOG_LOG_ERROR("No available watchdog channels");
+        return -1;
     }
     
-    watchdog_mutex_unlock();
-    watchdog_log("ERROR", "No available watchdog channels");
-    return -1;
+    struct watchdog_channel *channel = WATCHDOG_CHANNEL(shard, index);
+    channel->reload_period = reload_period;
+    channel->slack = slack;
+    channel->min_period = min_period;
+    channel->progress = column;
+    channel->escalation = escalation;
+    channel->stage = 0;
+    channel->user_data = user_data;
+    channel->callback = callback;
+    WATCHDOG_STORE(&channel->samples, 0);
+#if WATCHDOG_STATS
+    WATCHDOG_STORE(&channel->feeds, 0);
+    WATCHDOG_STORE(&channel->min_margin, INT64_MAX);
+#endif
+    
+    // Feed the channel immediately, then publish it to feeders
+    int64_t current_ticks = watchdog_get_ticks();
+    watchdog_feed_channel(shard, index, current_ticks);
+    WATCHDOG_STORE_RELEASE(&channel->generation, channel->generation + 1);
+    watchdog_schedule_next_timeout(ctx, shard);
+    
+    int channel_id = watchdog_make_handle(shard->index, (uint32_t)index, channel->generation);
+    
+    watchdog_mutex_unlock(shard->mutex);
+    watchdog_recorder_event(&ctx->recorder, Z_WDT_EVENT_ADD, channel_id, current_ticks);
+    
+    if (progress) {
+        WATCHDOG_LOG_INFO("Added progress watchdog channel %d with period %ums", channel_id, reload_period);
+    } else if (critical) {
+        WATCHDOG_LOG_INFO("Added critical watchdog channel %d with period %ums", channel_id, reload_period);
+    } else if (escalation != NULL) {
+        WATCHDOG_LOG_INFO("Added escalating watchdog channel %d with period %ums", channel_id, reload_period);
+    } else if (min_period != 0) {
+        WATCHDOG_LOG_INFO("Added adaptive watchdog channel %d with period %u-%ums", channel_id, min_period, reload_period);
+    } else if (slack != 0) {
+        WATCHDOG_LOG_INFO("Added watchdog channel %d with period %ums, slack %ums", channel_id, reload_period, slack);
+    } else {
+        WATCHDOG_LOG_INFO("Added watchdog channel %d with period %ums", channel_id, reload_period);
+    }
+    return channel_id;
+}
+
+// Add a channel group. It has no period of its own and times out, calling
+// callback with the group's handle, as soon as any member misses its deadline.
+int z_wdt_ctx_group_create(z_wdt_ctx_t *ctx, watchdog_callback_t callback, void *user_data) {
+    if (ctx == NULL || !ctx->initialized) {
+        WATCHDOG_LOG_ERROR("Watchdog not initialized");
+        return -1;
+    }
+    
+    if (callback == NULL) {
+        WATCHDOG_LOG_ERROR("Channel group needs a callback");
+        return -1;
+    }
+    
+    struct watchdog_shard *shard;
+    int index = watchdog_claim_slot(ctx, false, &shard);
+    if (index < 0) {
+        WATCHDOG_LOG_ERROR("No available watchdog channels");
+        return -1;
+    }
+    
+    // The deadline stays parked at INT64_MAX; the scheduler key caches the
+    // earliest member deadline, and an empty group isn't queued at all
+    struct watchdog_channel *channel = WATCHDOG_CHANNEL(shard, index);
+    channel->user_data = user_data;
+    channel->callback = callback;
+    channel->is_group = true;
+    channel->sched_key = INT64_MAX;
+#if WATCHDOG_STATS
+    WATCHDOG_STORE(&channel->feeds, 0);
+    WATCHDOG_STORE(&channel->min_margin, INT64_MAX);
+#endif
+    WATCHDOG_STORE_RELEASE(&channel->generation, channel->generation + 1);
+    
+    int group_id = watchdog_make_handle(shard->index, (uint32_t)index, channel->generation);
+    
+    watchdog_mutex_unlock(shard->mutex);
+    watchdog_recorder_event(&ctx->recorder, Z_WDT_EVENT_ADD, group_id, watchdog_get_ticks());
+    
+    WATCHDOG_LOG_INFO("Added watchdog channel group %d", group_id);
+    return group_id;
+}
+
+// Add a member to a group, in the group's shard. It is fed like any other
+// channel; callback may be NULL when the group's callback is enough.
+int z_wdt_ctx_group_add(z_wdt_ctx_t *ctx, int group_id, uint32_t reload_period,
+                        watchdog_callback_t callback, void *user_data) {
+    if (ctx == NULL || !ctx->initialized) {
+        WATCHDOG_LOG_ERROR("Watchdog not initialized");
+        return -1;
+    }
+    
+    if (reload_period == 0) {
+        WATCHDOG_LOG_ERROR("Invalid reload period: 0");
+        return -1;
+    }
+    
+    struct watchdog_shard *shard = watchdog_shard_of(ctx, group_id);
+    if (shard == NULL) {
+        WATCHDOG_LOG_ERROR("Invalid channel group: %d", group_id);
+        return -1;
+    }
+    
+    watchdog_mutex_lock(shard->mutex);
+    
+    uint32_t generation;
+    struct watchdog_channel *group = watchdog_resolve(shard, group_id, &generation);
+    if (group == NULL || !group->is_group) {
+        watchdog_mutex_unlock(shard->mutex);
+        WATCHDOG_LOG_ERROR("Invalid channel group: %d", group_id);
+        return -1;
+    }
+    
+    int index = watchdog_alloc_slot(shard);
+    if (index < 0) {
+        watchdog_mutex_unlock(shard->mutex);
+        WATCHDOG_LOG_ERROR("No available watchdog channels");
+        return -1;
+    }
+    
+    int group_index = (int)((uint32_t)group_id & WATCHDOG_INDEX_MASK);
+    struct watchdog_channel *channel = WATCHDOG_CHANNEL(shard, index);
+    channel->reload_period = reload_period;
+    channel->slack = ctx->default_slack;
+    channel->user_data = user_data;
+    channel->callback = callback;
+#if WATCHDOG_STATS
+    WATCHDOG_STORE(&channel->feeds, 0);
+    WATCHDOG_STORE(&channel->min_margin, INT64_MAX);
+#endif
+    
+    // Members are never queued; a key below every timeout keeps feeds off the
+    // shard lock, since the group's key is already a lower bound for them
+    WATCHDOG_STORE(&channel->sched_key, INT64_MIN);
+    channel->group = group_index;
+    channel->group_prev = -1;
+    channel->group_next = group->group_first;
+    if (group->group_first >= 0) {
+        WATCHDOG_CHANNEL(shard, group->group_first)->group_prev = index;
+    }
+    group->group_first = index;
+    
+    // Feeding pulls the group's key in to the new deadline if it is earlier;
+    // members join a suspended group parked
+    int64_t current_ticks = watchdog_get_ticks();
+    if (group->suspended) {
+        WATCHDOG_STORE(WATCHDOG_TIMEOUT(shard, index), INT64_MAX);
+    } else {
+        watchdog_feed_channel(shard, index, current_ticks);
+    }
+    WATCHDOG_STORE_RELEASE(&channel->generation, channel->generation + 1);
+    watchdog_schedule_next_timeout(ctx, shard);
+    
+    int channel_id = watchdog_make_handle(shard->index, (uint32_t)index, channel->generation);
+    
+    watchdog_mutex_unlock(shard->mutex);
+    watchdog_recorder_event(&ctx->recorder, Z_WDT_EVENT_ADD, channel_id, current_ticks);
+    
+    WATCHDOG_LOG_INFO("Added watchdog channel %d to group %d with period %ums", channel_id, group_id, reload_period);
+    return channel_id;
 }
 
 // Delete a watchdog channel
-int z_wdt_delete(int channel_id) {
-    if (!g_watchdog_ctx.initialized) {
-        watchdog_log("ERROR", "Watchdog not initialized");
+int z_wdt_ctx_delete(z_wdt_ctx_t *ctx, int channel_id) {
+    if (ctx == NULL || !ctx->initialized) {
+        WATCHDOG_LOG_ERROR("Watchdog not initialized");
         return -1;
     }
     
-    if (channel_id < 0 || channel_id >= WATCHDOG_MAX_CHANNELS) {
-        watchdog_log("ERROR", "Invalid channel ID: %d", channel_id);
+    struct watchdog_shard *shard = watchdog_shard_of(ctx, channel_id);
+    if (shard == NULL ||
+        watchdog_table_lookup(&shard->table, (uint32_t)channel_id & WATCHDOG_INDEX_MASK) == NULL) {
+        WATCHDOG_LOG_ERROR("Invalid channel ID: %d", channel_id);
         return -1;
     }
     
-    watchdog_mutex_lock();
+    watchdog_mutex_lock(shard->mutex);
     
-    if (g_watchdog_ctx.channels[channel_id].active) {
-        g_watchdog_ctx.channels[channel_id].active = false;
-        g_watchdog_ctx.channels[channel_id].reload_period = 0;
-        g_watchdog_ctx.channels[channel_id].callback = NULL;
-        g_watchdog_ctx.channels[channel_id].user_data = NULL;
+    uint32_t generation;
+    struct watchdog_channel *channel = watchdog_resolve(shard, channel_id, &generation);
+    int index = (int)((uint32_t)channel_id & WATCHDOG_INDEX_MASK);
+    if (channel != NULL && (uint32_t)index < shard->pinned_slots) {
+        watchdog_mutex_unlock(shard->mutex);
+        WATCHDOG_LOG_ERROR("Channel %d is defined statically and cannot be deleted", channel_id);
+        return -1;
+    }
+    if (channel != NULL) {
+        bool is_group = channel->is_group;
+        
+        // A group takes its members with it; a member just leaves its group,
+        // whose key stays a valid lower bound for the rest
+        if (is_group) {
+            for (int member = channel->group_first, next; member >= 0; member = next) {
+                struct watchdog_channel *member_channel = WATCHDOG_CHANNEL(shard, member);
+                next = member_channel->group_next;
+                WATCHDOG_STORE_RELEASE(&member_channel->generation, member_channel->generation + 1);
+                WATCHDOG_STORE_RELEASE(WATCHDOG_TIMEOUT(shard, member), INT64_MAX);
+                watchdog_release_slot(shard, member);
+            }
+        } else if (channel->group >= 0) {
+            watchdog_group_unlink(shard, index);
+        }
+        
+        // Retire the generation first so in-flight feeds can no longer succeed
+        WATCHDOG_STORE_RELEASE(&channel->generation, generation + 1);
+        WATCHDOG_STORE_RELEASE(WATCHDOG_TIMEOUT(shard, index), INT64_MAX);
+        watchdog_sched_remove(shard, index);
+        watchdog_release_slot(shard, index);
         
         // Reschedule next timeout
-        watchdog_schedule_next_timeout();
+        watchdog_schedule_next_timeout(ctx, shard);
         
-        watchdog_mutex_unlock();
+        watchdog_mutex_unlock(shard->mutex);
+        watchdog_recorder_event(&ctx->recorder, Z_WDT_EVENT_DELETE, channel_id, watchdog_get_ticks());
         
-        watchdog_log("INFO", "Deleted watchdog channel %d", channel_id);
+        if (is_group) {
+            WATCHDOG_LOG_INFO("Deleted watchdog channel group %d and its members", channel_id);
+        } else {
+            WATCHDOG_LOG_INFO("Deleted watchdog channel %d", channel_id);
+        }
         return 0;
     }
     
-    watchdog_mutex_unlock();
-    watchdog_log("WARN", "Channel %d not active", channel_id);
+    watchdog_mutex_unlock(shard->mutex);
+    WATCHDOG_LOG_WARN("Channel %d not active", channel_id);
     return -1;
 }
 
-// Feed a watchdog channel
-int z_wdt_feed(int channel_id) {
-    if (!g_watchdog_ctx.initialized) {
+// Feed a watchdog channel (lock-free; the timer thread validates lazily)
+int z_wdt_ctx_feed(z_wdt_ctx_t *ctx, int channel_id) {
+    if (ctx == NULL || !WATCHDOG_LOAD(&ctx->initialized)) {
         return -1;
     }
     
-    if (channel_id < 0 || channel_id >= WATCHDOG_MAX_CHANNELS) {
+    int result = watchdog_feed_at(ctx, channel_id, watchdog_get_ticks());
+    if (result > 0) {
+        watchdog_feed_rearm(ctx, channel_id);
+    }
+    
+    return result < 0 ? -1 : 0;
+}
+
+// Re-arm a channel whose feed returned 1 (timeout ahead of its scheduler key)
+void watchdog_feed_rearm(struct watchdog_context *ctx, int channel_id) {
+    struct watchdog_shard *shard = watchdog_shard_of(ctx, channel_id);
+    watchdog_mutex_lock(shard->mutex);
+    watchdog_feed_requeue(shard, channel_id);
+    watchdog_schedule_next_timeout(ctx, shard);
+    watchdog_mutex_unlock(shard->mutex);
+}
+
+// Feed several channels with one clock read and one lock per affected shard
+int z_wdt_ctx_feed_many(z_wdt_ctx_t *ctx, const int *channel_ids, size_t count) {
+    if (ctx == NULL || !WATCHDOG_LOAD(&ctx->initialized) || (channel_ids == NULL && count > 0)) {
         return -1;
     }
     
-    if (!g_watchdog_ctx.channels[channel_id].active) {
+    int64_t current_ticks = watchdog_get_ticks();
+    uint64_t requeue = 0;              // Shards with channels to re-arm
+    int fed = 0;
+    
+    for (size_t i = 0; i < count; i++) {
+        int result = watchdog_feed_at(ctx, channel_ids[i], current_ticks);
+        fed += result >= 0;
+        if (result > 0) {
+            requeue |= (uint64_t)1 << watchdog_handle_shard(channel_ids[i]);
+        }
+    }
+    
+    for (; requeue != 0; requeue &= requeue - 1) {
+        struct watchdog_shard *shard = &ctx->shards[WATCHDOG_CTZ64(requeue)];
+        watchdog_mutex_lock(shard->mutex);
+        for (size_t i = 0; i < count; i++) {
+            if (watchdog_handle_shard(channel_ids[i]) == shard->index) {
+                watchdog_feed_requeue(shard, channel_ids[i]);
+            }
+        }
+        watchdog_schedule_next_timeout(ctx, shard);
+        watchdog_mutex_unlock(shard->mutex);
+    }
+    
+    return fed;
+}
+
+// Feed channel_ids[i] for every bit i set in mask
+int z_wdt_ctx_feed_mask(z_wdt_ctx_t *ctx, const int *channel_ids, uint64_t mask) {
+    if (ctx == NULL || !WATCHDOG_LOAD(&ctx->initialized) || (channel_ids == NULL && mask != 0)) {
         return -1;
     }
     
     int64_t current_ticks = watchdog_get_ticks();
+    uint64_t requeue = 0;              // Shards with channels to re-arm
+    int fed = 0;
     
-    // Update timeout for this channel
-    g_watchdog_ctx.channels[channel_id].timeout_abs_ticks = 
-        current_ticks + watchdog_ms_to_ticks(g_watchdog_ctx.channels[channel_id].reload_period);
+    for (uint64_t bits = mask; bits != 0; bits &= bits - 1) {
+        int channel_id = channel_ids[WATCHDOG_CTZ64(bits)];
+        int result = watchdog_feed_at(ctx, channel_id, current_ticks);
+        fed += result >= 0;
+        if (result > 0) {
+            requeue |= (uint64_t)1 << watchdog_handle_shard(channel_id);
+        }
+    }
     
-    // Reschedule next timeout
-    watchdog_schedule_next_timeout();
+    for (; requeue != 0; requeue &= requeue - 1) {
+        struct watchdog_shard *shard = &ctx->shards[WATCHDOG_CTZ64(requeue)];
+        watchdog_mutex_lock(shard->mutex);
+        for (uint64_t bits = mask; bits != 0; bits &= bits - 1) {
+            int channel_id = channel_ids[WATCHDOG_CTZ64(bits)];
+            if (watchdog_handle_shard(channel_id) == shard->index) {
+                watchdog_feed_requeue(shard, channel_id);
+            }
+        }
+        watchdog_schedule_next_timeout(ctx, shard);
+        watchdog_mutex_unlock(shard->mutex);
+    }
     
-    return 0;
+    return fed;
 }
 
 // Suspend watchdog (for power management)
-void z_wdt_suspend(void) {
-    if (!g_watchdog_ctx.initialized) {
+void z_wdt_ctx_suspend(z_wdt_ctx_t *ctx) {
+    if (ctx == NULL || !ctx->initialized) {
         return;
     }
     
-    watchdog_mutex_lock();
-    g_watchdog_ctx.timer_running = false;
-    watchdog_mutex_unlock();
+    watchdog_mutex_lock(ctx->timer_mutex);
+    WATCHDOG_STORE(&ctx->timer_running, false);
+    WATCHDOG_STORE(&ctx->next_timeout_ticks, INT64_MAX);
+    watchdog_timer_stop(ctx->timer);
+    watchdog_mutex_unlock(ctx->timer_mutex);
+    if (ctx->critical != NULL) {
+        watchdog_mutex_lock(ctx->critical->mutex);
+        watchdog_arm_critical(ctx);
+        watchdog_mutex_unlock(ctx->critical->mutex);
+    }
     
-    watchdog_log("INFO", "Watchdog suspended");
+    WATCHDOG_LOG_INFO("Watchdog suspended");
 }
 
 // Resume watchdog (for power management)
-void z_wdt_resume(void) {
-    if (!g_watchdog_ctx.initialized) {
+void z_wdt_ctx_resume(z_wdt_ctx_t *ctx) {
+    if (ctx == NULL || !ctx->initialized) {
         return;
     }
     
-    watchdog_mutex_lock();
+    // Resuming counts as a feed of every channel, applied lazily: no
+    // deadline is rewritten here. A channel coming due that was not fed
+    // since is moved one period past this epoch instead of timing out (see
+    // watchdog_effective_timeout()), so resume costs the same for any
+    // number of channels and the catch-up runs on the timer thread.
+    WATCHDOG_STORE_RELEASE(&ctx->resumed_at, watchdog_get_ticks());
+    WATCHDOG_STORE(&ctx->timer_running, true);
+    watchdog_arm_timer(ctx);
+    if (ctx->critical != NULL) {
+        watchdog_mutex_lock(ctx->critical->mutex);
+        watchdog_arm_critical(ctx);
+        watchdog_mutex_unlock(ctx->critical->mutex);
+    }
+    
+    WATCHDOG_LOG_INFO("Watchdog resumed");
+}
+
+// Suspend one channel, or a group with all of its members: its deadline is
+// parked at INT64_MAX, where feeds leave it, until z_wdt_ctx_channel_resume()
+int z_wdt_ctx_channel_suspend(z_wdt_ctx_t *ctx, int channel_id) {
+    return watchdog_set_suspended(ctx, channel_id, true);
+}
+
+// Resume a suspended channel or group with a fresh period, as if fed now
+int z_wdt_ctx_channel_resume(z_wdt_ctx_t *ctx, int channel_id) {
+    return watchdog_set_suspended(ctx, channel_id, false);
+}
+
+// Park or restart a channel and, for a group, its members. A member of a
+// suspended group stays parked until the group resumes.
+static int watchdog_set_suspended(struct watchdog_context *ctx, int channel_id, bool suspended) {
+    if (ctx == NULL || !ctx->initialized) {
+        WATCHDOG_LOG_ERROR("Watchdog not initialized");
+        return -1;
+    }
+    
+    struct watchdog_shard *shard = watchdog_shard_of(ctx, channel_id);
+    if (shard == NULL) {
+        WATCHDOG_LOG_ERROR("Invalid channel ID: %d", channel_id);
+        return -1;
+    }
+    
+    watchdog_mutex_lock(shard->mutex);
     
-    // Feed all active channels
+    uint32_t generation;
+    struct watchdog_channel *channel = watchdog_resolve(shard, channel_id, &generation);
+    if (channel == NULL || channel->callback == watchdog_hw_channel) {
+        watchdog_mutex_unlock(shard->mutex);
+        WATCHDOG_LOG_WARN("Channel %d not active or not suspendable", channel_id);
+        return -1;
+    }
+    if (channel->suspended == suspended) {
+        watchdog_mutex_unlock(shard->mutex);
+        return 0;
+    }
+    
+    int index = (int)((uint32_t)channel_id & WATCHDOG_INDEX_MASK);
+    bool group_suspended = channel->group >= 0 && WATCHDOG_CHANNEL(shard, channel->group)->suspended;
     int64_t current_ticks = watchdog_get_ticks();
-    for (int id = 0; id < WATCHDOG_MAX_CHANNELS; id++) {
-        if (g_watchdog_ctx.channels[id].active) {
-            g_watchdog_ctx.channels[id].timeout_abs_ticks = 
-                current_ticks + watchdog_ms_to_ticks(g_watchdog_ctx.channels[id].reload_period);
+    channel->suspended = suspended;
+    
+    if (channel->is_group) {
+        for (int member = channel->group_first; member >= 0; member = WATCHDOG_CHANNEL(shard, member)->group_next) {
+            if (suspended) {
+                WATCHDOG_STORE(WATCHDOG_TIMEOUT(shard, member), INT64_MAX);
+            } else if (!WATCHDOG_CHANNEL(shard, member)->suspended) {
+                watchdog_feed_channel(shard, member, current_ticks);
+            }
+        }
+    } else if (!suspended && !group_suspended) {
+        // Progress made while suspended doesn't count for the new period
+        if (channel->progress >= 0) {
+            shard->progress->seen[channel->progress] = watchdog_progress_total(shard->progress, channel->progress);
         }
+        watchdog_feed_channel(shard, index, current_ticks);
+    } else if (suspended) {
+        WATCHDOG_STORE(WATCHDOG_TIMEOUT(shard, index), INT64_MAX);
     }
     
-    g_watchdog_ctx.timer_running = true;
-    watchdog_schedule_next_timeout();
+    // A member's key is its group's to keep; anything else leaves the scheduler
+    if (suspended && channel->group < 0) {
+        WATCHDOG_STORE(&channel->sched_key, INT64_MAX);
+        watchdog_sched_remove(shard, index);
+    }
+    watchdog_schedule_next_timeout(ctx, shard);
     
-    watchdog_mutex_unlock();
+    watchdog_mutex_unlock(shard->mutex);
     
-    watchdog_log("INFO", "Watchdog resumed");
+    if (suspended) {
+        WATCHDOG_LOG_INFO("Watchdog channel %d suspended", channel_id);
+    } else {
+        WATCHDOG_LOG_INFO("Watchdog channel %d resumed", channel_id);
+    }
+    return 0;
 }
 
-// Process watchdog (called by timer thread)
-void z_wdt_process(void) {
-    if (!g_watchdog_ctx.initialized || !g_watchdog_ctx.timer_running) {
-        return;
+// Current time in ticks, the clock z_wdt_next_deadline() is measured on
+int64_t z_wdt_now(void) {
+    return watchdog_get_ticks();
+}
+
+// Absolute tick at which the context next needs z_wdt_ctx_process()
+// (INT64_MAX if nothing is armed); lets an external loop size its wait
+int64_t z_wdt_ctx_next_deadline(z_wdt_ctx_t *ctx) {
+    if (ctx == NULL || !ctx->initialized) {
+        return INT64_MAX;
+    }
+    return WATCHDOG_LOAD(&ctx->next_timeout_ticks);
+}
+
+// Descriptor that turns readable when the next deadline passes, for an
+// external_loop context on platforms that have one (-1 otherwise).
+// z_wdt_ctx_process() re-arms it, which also clears the readiness.
+int z_wdt_ctx_get_fd(z_wdt_ctx_t *ctx) {
+    if (ctx == NULL || !ctx->initialized || !ctx->external) {
+        return -1;
+    }
+    return watchdog_timer_fd(ctx->timer);
+}
+
+// Arm the hardware watchdog and pet it from a synthetic channel every half
+// timeout for as long as no other channel of the context times out
+int z_wdt_ctx_hw_enable(z_wdt_ctx_t *ctx, uint32_t hw_timeout) {
+    if (ctx == NULL || !ctx->initialized) {
+        WATCHDOG_LOG_ERROR("Watchdog not initialized");
+        return -1;
+    }
+    struct watchdog_context *owner = NULL;
+    if (!WATCHDOG_CAS(&g_hw_owner, &owner, ctx)) {
+        WATCHDOG_LOG_ERROR("Hardware watchdog already enabled");
+        return -1;
     }
     
-    int64_t current_ticks = watchdog_get_ticks();
+    // The device may round the timeout to what it supports
+    uint32_t timeout = hw_timeout;
+    if (watchdog_hw_open(&timeout) != 0) {
+        WATCHDOG_STORE_RELEASE(&g_hw_owner, NULL);
+        WATCHDOG_LOG_ERROR("Failed to open the hardware watchdog");
+        return -1;
+    }
+    uint32_t pet_period = timeout / 2 > 0 ? timeout / 2 : 1;
     
-    // Check for timeouts
-    for (int id = 0; id < WATCHDOG_MAX_CHANNELS; id++) {
-        if (g_watchdog_ctx.channels[id].active && 
-            g_watchdog_ctx.channels[id].timeout_abs_ticks <= current_ticks) {
-            
-            watchdog_log("ERROR", "Watchdog channel %d timeout!", id);
-            
-            if (g_watchdog_ctx.channels[id].callback) {
-                g_watchdog_ctx.channels[id].callback(id, g_watchdog_ctx.channels[id].user_data);
-            } else {
-                watchdog_log("FATAL", "No callback for channel %d, system will exit", id);
-                exit(1);
-            }
-            
-            // Deactivate the channel after timeout
-            g_watchdog_ctx.channels[id].active = false;
-        }
+    // The pet's wakeup is rounded up to timer_resolution like any other;
+    // that delay must stay within the rest of the device timeout
+    if (ctx->timer_resolution >= watchdog_ms_to_ticks(timeout) - watchdog_ms_to_ticks(pet_period)) {
+        watchdog_hw_close();
+        WATCHDOG_STORE_RELEASE(&g_hw_owner, NULL);
+        WATCHDOG_LOG_ERROR("timer_resolution must be below half the hardware watchdog timeout (%ums)", timeout);
+        return -1;
+    }
+    
+    WATCHDOG_STORE(&ctx->hw_tripped, false);
+    WATCHDOG_STORE(&ctx->hw_enabled, true);
+    watchdog_hw_pet();
+    
+    // No slack: the default one could push the pet past the device timeout
+    ctx->hw_channel = z_wdt_ctx_add_ex(ctx, pet_period, 0, watchdog_hw_channel, ctx);
+    if (ctx->hw_channel < 0) {
+        z_wdt_ctx_hw_disable(ctx);
+        return -1;
+    }
+    
+    WATCHDOG_LOG_INFO("Hardware watchdog enabled: timeout %ums, petted every %ums", timeout, pet_period);
+    return 0;
+}
+
+// Stop petting and disarm the hardware watchdog, if the device allows it
+void z_wdt_ctx_hw_disable(z_wdt_ctx_t *ctx) {
+    if (ctx == NULL || WATCHDOG_LOAD_ACQUIRE(&g_hw_owner) != ctx) {
+        return;
+    }
+    
+    if (ctx->hw_channel >= 0) {
+        z_wdt_ctx_delete(ctx, ctx->hw_channel);
+        ctx->hw_channel = -1;
     }
+    WATCHDOG_STORE(&ctx->hw_enabled, false);
+    watchdog_hw_close();
+    WATCHDOG_STORE_RELEASE(&g_hw_owner, NULL);
     
-    // Reschedule next timeout
-    watchdog_schedule_next_timeout();
+    WATCHDOG_LOG_INFO("Hardware watchdog disabled");
 }
 
-// Convert milliseconds to ticks
-static int64_t watchdog_ms_to_ticks(uint32_t ms) {
-    return (int64_t)ms;
+// Snapshot a context's counters and histograms (any thread, lock-free)
+int z_wdt_ctx_stats_get(z_wdt_ctx_t *ctx, z_wdt_stats *stats) {
+#if WATCHDOG_STATS
+    if (ctx == NULL || !WATCHDOG_LOAD(&ctx->initialized) || stats == NULL) {
+        return -1;
+    }
+    
+    memset(stats, 0, sizeof(*stats));
+    for (uint32_t i = 0; i < WATCHDOG_STATS_CPUS; i++) {
+        stats->feeds += WATCHDOG_LOAD(&ctx->stats.cpus[i].feeds);
+        stats->feed_requeues += WATCHDOG_LOAD(&ctx->stats.cpus[i].feed_requeues);
+    }
+    stats->wakeups = WATCHDOG_LOAD(&ctx->stats.wakeups);
+    for (uint32_t i = 0; i < ctx->shard_count; i++) {
+        watchdog_stats_merge(&stats->detection_latency, &ctx->shards[i].detection_latency);
+    }
+    stats->timeouts = stats->detection_latency.count;
+    watchdog_stats_merge(&stats->callback_duration, &ctx->stats.callback_duration);
+    watchdog_stats_merge(&stats->lock_wait, &ctx->stats.lock_wait);
+    watchdog_stats_merge(&stats->lock_hold, &ctx->stats.lock_hold);
+    return 0;
+#else
+    (void)ctx;
+    (void)stats;
+    return -1;
+#endif
 }
 
-// Get next timeout channel
-static int watchdog_get_next_timeout_channel(void) {
-    int next_channel = -1;
-    int64_t next_timeout = INT64_MAX;
+// Feed count and closest call of an active channel
+int z_wdt_ctx_channel_stats_get(z_wdt_ctx_t *ctx, int channel_id, z_wdt_channel_stats *stats) {
+#if WATCHDOG_STATS
+    if (ctx == NULL || !WATCHDOG_LOAD(&ctx->initialized) || stats == NULL) {
+        return -1;
+    }
     
-    for (int id = 0; id < WATCHDOG_MAX_CHANNELS; id++) {
-        if (g_watchdog_ctx.channels[id].active && 
-            g_watchdog_ctx.channels[id].timeout_abs_ticks < next_timeout) {
-            next_channel = id;
-            next_timeout = g_watchdog_ctx.channels[id].timeout_abs_ticks;
-        }
+    struct watchdog_shard *shard = watchdog_shard_of(ctx, channel_id);
+    uint32_t generation;
+    struct watchdog_channel *channel = shard != NULL ? watchdog_resolve(shard, channel_id, &generation) : NULL;
+    if (channel == NULL) {
+        return -1;
     }
     
-    return next_channel;
+    int64_t margin = WATCHDOG_LOAD(&channel->min_margin);
+    stats->feeds = channel->progress >= 0 ? watchdog_progress_total(shard->progress, channel->progress) :
+                   WATCHDOG_LOAD(&channel->feeds);
+    stats->min_margin_us = margin == INT64_MAX ? INT64_MAX :
+                           margin / WATCHDOG_TICK_HZ * 1000000 + margin % WATCHDOG_TICK_HZ * 1000000 / WATCHDOG_TICK_HZ;
+    
+    // The slot may have been reused while reading
+    return WATCHDOG_LOAD_ACQUIRE(&channel->generation) == generation ? 0 : -1;
+#else
+    (void)ctx;
+    (void)channel_id;
+    (void)stats;
+    return -1;
+#endif
+}
+
+// Flight recorder of a context, to read while it runs (NULL if not configured)
+z_wdt_recorder_t *z_wdt_ctx_recorder(z_wdt_ctx_t *ctx) {
+    if (ctx == NULL || !ctx->initialized || ctx->recorder.region == NULL) {
+        return NULL;
+    }
+    return &ctx->recorder;
 }
 
-// Schedule next timeout
-static void watchdog_schedule_next_timeout(void) {
-    int next_channel = watchdog_get_next_timeout_channel();
+// Copy the channel table into the context's recorder now, as a timeout
+// does. Returns the number of channels kept, -1 without a recorder or
+// while a timeout is taking one.
+int z_wdt_ctx_snapshot(z_wdt_ctx_t *ctx) {
+    if (ctx == NULL || !ctx->initialized) {
+        return -1;
+    }
     
-    if (next_channel >= 0) {
-        g_watchdog_ctx.next_timeout_channel = next_channel;
-        g_watchdog_ctx.next_timeout_ticks = g_watchdog_ctx.channels[next_channel].timeout_abs_ticks;
-    } else {
-        g_watchdog_ctx.next_timeout_channel = -1;
-        g_watchdog_ctx.next_timeout_ticks = INT64_MAX;
+    int count = watchdog_recorder_snapshot(ctx);
+    watchdog_recorder_flush(&ctx->recorder);
+    return count;
+}
+
+// Marks the synthetic hardware watchdog channel; it never times out, so
+// this is never called
+static void watchdog_hw_channel(int channel_id, void *user_data) {
+    (void)channel_id;
+    (void)user_data;
+}
+
+// Pet the hardware watchdog unless some channel has timed out; from then
+// on the device runs out and resets the system
+static void watchdog_hw_pet_if_healthy(struct watchdog_context *ctx) {
+    if (WATCHDOG_LOAD(&ctx->hw_enabled) && !WATCHDOG_LOAD(&ctx->hw_tripped)) {
+        watchdog_hw_pet();
+    }
+}
+
+// Process a context (called by its timer thread or the application's loop,
+// takes the shard mutexes itself)
+void z_wdt_ctx_process(z_wdt_ctx_t *ctx) {
+    if (ctx == NULL || !ctx->initialized || !WATCHDOG_LOAD(&ctx->timer_running)) {
+        return;
     }
+    
+    // One timer serves every shard but the critical one; only the shards
+    // that are due get locked
+    int64_t current_ticks = watchdog_get_ticks();
+    for (uint32_t i = 0; i < ctx->shard_count; i++) {
+        struct watchdog_shard *shard = &ctx->shards[i];
+        if (!shard->critical && WATCHDOG_LOAD(&shard->next_timeout_ticks) <= current_ticks) {
+            watchdog_process_shard(ctx, shard);
+        }
+    }
+    
+    // Re-arm for the earliest remaining timeout
+    watchdog_arm_timer(ctx);
+#if WATCHDOG_STATS
+    WATCHDOG_FETCH_ADD(&ctx->stats.wakeups, 1);
+#endif
 }
 
+// Process a context's critical shard (called by its critical timer thread,
+// which watchdog_process_shard() re-arms under the shard mutex)
+void z_wdt_ctx_process_critical(z_wdt_ctx_t *ctx) {
+    if (ctx == NULL || !ctx->initialized || ctx->critical == NULL || !WATCHDOG_LOAD(&ctx->timer_running)) {
+        return;
+    }
+    
+    watchdog_process_shard(ctx, ctx->critical);
+#if WATCHDOG_STATS
+    WATCHDOG_FETCH_ADD(&ctx->stats.wakeups, 1);
+#endif
+}
 
-// Cleanup function
-void z_wdt_cleanup(void) {
-    if (g_watchdog_ctx.initialized) {
-        watchdog_os_cleanup();
-        g_watchdog_ctx.initialized = false;
-        watchdog_log("INFO", "Watchdog cleaned up");
+// Expire one shard's channels and run their callbacks without its mutex
+static void watchdog_process_shard(struct watchdog_context *ctx, struct watchdog_shard *shard) {
+    struct watchdog_stage_event staged[WATCHDOG_STAGE_BATCH];
+    uint64_t lock_start = WATCHDOG_STATS_NOW();
+    watchdog_mutex_lock(shard->mutex);
+    uint64_t locked = WATCHDOG_STATS_NOW();
+    
+    // Channels fed since they were queued come back out of the scheduler
+    // and are re-queued by watchdog_channel_expired(); the rest time out
+    int64_t current_ticks = watchdog_get_ticks();
+    shard->current_ticks = current_ticks;
+    
+    // Dequeue every channel whose timeout has passed. Escalation stages are
+    // copied out here, so they can run unlocked even if the channel goes.
+    shard->staged = staged;
+    shard->staged_count = 0;
+    watchdog_sched_expire(shard, current_ticks, watchdog_channel_expired);
+    uint32_t staged_count = shard->staged_count;
+    shard->staged = NULL;
+    
+    // The caller re-arms the timer once all shards are done; the critical
+    // shard has its timer to itself
+    WATCHDOG_STORE(&shard->next_timeout_ticks, watchdog_sched_next(shard));
+    if (shard->critical) {
+        watchdog_arm_critical(ctx);
+    }
+    
+    int expired = shard->expired_head;
+    shard->expired_head = -1;
+    shard->expired_tail = -1;
+    bool hw_pet = shard->hw_pet_due;
+    shard->hw_pet_due = false;
+    
+    watchdog_mutex_unlock(shard->mutex);
+    WATCHDOG_STATS_RECORD(&ctx->stats.lock_wait, locked - lock_start);
+    WATCHDOG_STATS_RECORD(&ctx->stats.lock_hold, WATCHDOG_STATS_NOW() - locked);
+    
+    if (hw_pet) {
+        watchdog_hw_pet_if_healthy(ctx);
+    }
+    for (uint32_t i = 0; i < staged_count; i++) {
+        watchdog_dispatch_stage(ctx, &staged[i]);
+    }
+    if (expired < 0) {
+        return;
     }
-}
\ No newline at end of file
+    
+    // Record the timeouts and the channel table as it stands, and get them
+    // to the recorder's file before a callback can take the system down
+    if (ctx->recorder.region != NULL) {
+        for (int index = expired; index >= 0; index = WATCHDOG_CHANNEL(shard, index)->next_free) {
+            int channel_id = watchdog_make_handle(shard->index, (uint32_t)index,
+                                                  WATCHDOG_CHANNEL(shard, index)->generation - 1);
+            watchdog_recorder_event(&ctx->recorder, Z_WDT_EVENT_TIMEOUT, channel_id, current_ticks);
+        }
+        watchdog_recorder_snapshot(ctx);
+        watchdog_recorder_flush(&ctx->recorder);
+    }
+    
+    // Run the callbacks without the mutex, so they may call back into the
+    // API and never stall other threads. Retired slots can't be reused or
+    // touched by feeders until they are freed below.
+    for (int index = expired; index >= 0; index = WATCHDOG_CHANNEL(shard, index)->next_free) {
+        watchdog_dispatch_timeout(ctx, shard, index);
+    }
+    
+    watchdog_mutex_lock(shard->mutex);
+    while (expired >= 0) {
+        int next = WATCHDOG_CHANNEL(shard, expired)->next_free;
+        watchdog_release_slot(shard, expired);
+        expired = next;
+    }
+    watchdog_mutex_unlock(shard->mutex);
+}
+
+// Handle a channel whose armed key passed (already removed from the scheduler)
+static void watchdog_channel_expired(struct watchdog_shard *shard, int index) {
+    struct watchdog_channel *channel = WATCHDOG_CHANNEL(shard, index);
+    
+    // A group's cached key came due: only now look at its members
+    if (channel->is_group) {
+        watchdog_group_expired(shard, index);
+        return;
+    }
+    
+    // Fed (or resumed) since it was queued: re-queue it at its real timeout
+    int64_t timeout = watchdog_effective_timeout(shard, index);
+    if (channel->escalation != NULL) {
+        watchdog_channel_escalate(shard, index, timeout);
+        return;
+    }
+    if (timeout > shard->current_ticks) {
+        watchdog_requeue_channel(shard, index, timeout);
+        return;
+    }
+    
+    // The hardware watchdog channel never times out: it reloads itself and
+    // the pet happens after unlocking
+    if (channel->callback == watchdog_hw_channel) {
+        watchdog_feed_channel(shard, index, shard->current_ticks);
+        shard->hw_pet_due = true;
+        return;
+    }
+    
+    // A member times out with its group (only the array backend scans
+    // members directly; the other schedulers never queue them)
+    if (channel->group >= 0) {
+        watchdog_group_expired(shard, channel->group);
+        return;
+    }
+    
+    // A progress channel survives the period if its total moved at all
+    if (channel->progress >= 0) {
+        uint64_t total = watchdog_progress_total(shard->progress, channel->progress);
+        if (total != shard->progress->seen[channel->progress]) {
+            shard->progress->seen[channel->progress] = total;
+            watchdog_feed_channel(shard, index, shard->current_ticks);
+            return;
+        }
+    }
+    
+    // Deactivate the channel now; the callback is dispatched after unlocking
+    WATCHDOG_STATS_RECORD(&shard->detection_latency, watchdog_ticks_to_ns(shard->current_ticks - timeout));
+    watchdog_retire_channel(shard, index);
+    watchdog_push_expired(shard, index);
+}
+
+// Fire the stages of an escalating channel that came due: the ones before
+// the reset are batched for dispatch and the channel is re-queued at its
+// next stage, the reset times it out. A late pass fires all stages it
+// missed at once; stages count from the deadline, so a feed starts over.
+static void watchdog_channel_escalate(struct watchdog_shard *shard, int index, int64_t timeout) {
+    struct watchdog_channel *channel = WATCHDOG_CHANNEL(shard, index);
+    int64_t lead = watchdog_channel_lead(channel);
+    
+    if (timeout != channel->stage_deadline) {
+        if (channel->stage > WATCHDOG_STAGE_WARN) {
+            WATCHDOG_LOG_INFO("Watchdog channel %d fed again after stage %d",
+                              watchdog_make_handle(shard->index, (uint32_t)index, channel->generation),
+                              channel->stage - 1);
+        }
+        channel->stage_deadline = timeout;
+        channel->stage = WATCHDOG_STAGE_WARN;
+    }
+    
+    int64_t due = timeout - lead + channel->stage * lead;
+    while (due <= shard->current_ticks && channel->stage < WATCHDOG_STAGE_RESET) {
+        // A full batch leaves the rest of the stages to the next tick
+        if (shard->staged_count == WATCHDOG_STAGE_BATCH) {
+            watchdog_requeue_channel(shard, index, shard->current_ticks + 1);
+            return;
+        }
+        
+        const z_wdt_escalation *escalation = channel->escalation;
+        struct watchdog_stage_event *event = &shard->staged[shard->staged_count++];
+        event->callback = channel->stage == WATCHDOG_STAGE_WARN ? escalation->warn :
+                          channel->stage == WATCHDOG_STAGE_DUMP ? escalation->dump : escalation->restart;
+        event->user_data = channel->user_data;
+        event->channel_id = watchdog_make_handle(shard->index, (uint32_t)index, channel->generation);
+        event->stage = channel->stage++;
+        due += lead;
+    }
+    if (due > shard->current_ticks) {
+        watchdog_requeue_channel(shard, index, due);
+        return;
+    }
+    
+    // Reset stage: the channel times out with the reset action as callback
+    WATCHDOG_STATS_RECORD(&shard->detection_latency, watchdog_ticks_to_ns(shard->current_ticks - due));
+    watchdog_retire_channel(shard, index);
+    watchdog_push_expired(shard, index);
+}
+
+// Descend into a group whose key came due: re-queue it at its earliest member
+// deadline, or time it out with all of its members once one has passed
+static void watchdog_group_expired(struct watchdog_shard *shard, int index) {
+    struct watchdog_channel *group = WATCHDOG_CHANNEL(shard, index);
+    
+    int64_t earliest = INT64_MAX;
+    for (int member = group->group_first; member >= 0; member = WATCHDOG_CHANNEL(shard, member)->group_next) {
+        int64_t timeout = watchdog_effective_timeout(shard, member);
+        earliest = timeout < earliest ? timeout : earliest;
+    }
+    
+    // Members left or were fed: cache the new earliest deadline. An empty
+    // group drops out of the scheduler until a member is added.
+    if (earliest == INT64_MAX) {
+        WATCHDOG_STORE(&group->sched_key, INT64_MAX);
+        watchdog_sched_remove(shard, index);
+        return;
+    }
+    if (earliest > shard->current_ticks) {
+        watchdog_requeue_channel(shard, index, earliest);
+        return;
+    }
+    
+    // The group reports first; members with a callback of their own that
+    // missed their deadline report too, the others are freed right away
+    WATCHDOG_STATS_RECORD(&shard->detection_latency, watchdog_ticks_to_ns(shard->current_ticks - earliest));
+    watchdog_retire_channel(shard, index);
+    watchdog_push_expired(shard, index);
+    
+    for (int member = group->group_first, next; member >= 0; member = next) {
+        struct watchdog_channel *channel = WATCHDOG_CHANNEL(shard, member);
+        bool report = channel->callback != NULL &&
+                      WATCHDOG_LOAD(WATCHDOG_TIMEOUT(shard, member)) <= shard->current_ticks;
+        
+        next = channel->group_next;
+        channel->group = -1;
+        channel->group_prev = -1;
+        channel->group_next = -1;
+        watchdog_retire_channel(shard, member);
+        if (report) {
+            watchdog_push_expired(shard, member);
+        } else {
+            watchdog_release_slot(shard, member);
+        }
+    }
+    group->group_first = -1;
+}
+
+// Take a timed-out channel out of service (mutex held); feeds fail from here on
+static void watchdog_retire_channel(struct watchdog_shard *shard, int index) {
+    struct watchdog_channel *channel = WATCHDOG_CHANNEL(shard, index);
+    
+    WATCHDOG_STORE_RELEASE(&channel->generation, channel->generation + 1);
+    WATCHDOG_STORE_RELEASE(WATCHDOG_TIMEOUT(shard, index), INT64_MAX);
+    watchdog_table_retire(&shard->table, index);
+}
+
+// Append a retired channel to the shard's list of callbacks to dispatch
+static void watchdog_push_expired(struct watchdog_shard *shard, int index) {
+    WATCHDOG_CHANNEL(shard, index)->next_free = -1;
+    if (shard->expired_tail >= 0) {
+        WATCHDOG_CHANNEL(shard, shard->expired_tail)->next_free = index;
+    } else {
+        shard->expired_head = index;
+    }
+    shard->expired_tail = index;
+}
+
+// Remove a member from its group's list (mutex held)
+static void watchdog_group_unlink(struct watchdog_shard *shard, int index) {
+    struct watchdog_channel *channel = WATCHDOG_CHANNEL(shard, index);
+    
+    if (channel->group_prev >= 0) {
+        WATCHDOG_CHANNEL(shard, channel->group_prev)->group_next = channel->group_next;
+    } else {
+        WATCHDOG_CHANNEL(shard, channel->group)->group_first = channel->group_next;
+    }
+    if (channel->group_next >= 0) {
+        WATCHDOG_CHANNEL(shard, channel->group_next)->group_prev = channel->group_prev;
+    }
+    channel->group = -1;
+    channel->group_prev = -1;
+    channel->group_next = -1;
+}
+
+// Run an escalation stage of a channel that is still being watched: its
+// action on the configured runner, or the default right here
+static void watchdog_dispatch_stage(struct watchdog_context *ctx, const struct watchdog_stage_event *event) {
+    if (event->callback != NULL) {
+        watchdog_run_callback(ctx, event->callback, event->channel_id, event->user_data);
+        return;
+    }
+    
+    if (event->stage == WATCHDOG_STAGE_WARN) {
+        WATCHDOG_LOG_WARN("Watchdog channel %d not fed for half its period", event->channel_id);
+    } else if (event->stage == WATCHDOG_STAGE_DUMP) {
+        WATCHDOG_LOG_ERROR("Watchdog channel %d missed its deadline, escalating", event->channel_id);
+        if (ctx->recorder.region != NULL) {
+            watchdog_recorder_snapshot(ctx);
+            watchdog_recorder_flush(&ctx->recorder);
+        }
+    } else {
+        WATCHDOG_LOG_ERROR("Watchdog channel %d missed its deadline by half a period, no restart action",
+                           event->channel_id);
+    }
+}
+
+// Report a timed-out channel and hand its callback to the configured runner
+static void watchdog_dispatch_timeout(struct watchdog_context *ctx, struct watchdog_shard *shard, int index) {
+    struct watchdog_channel *channel = WATCHDOG_CHANNEL(shard, index);
+    
+    // The generation was retired on expiry; the handle names the one before
+    int channel_id = watchdog_make_handle(shard->index, (uint32_t)index, channel->generation - 1);
+    WATCHDOG_LOG_ERROR("Watchdog channel %d timeout!", channel_id);
+    
+    if (WATCHDOG_LOAD(&ctx->hw_enabled) && !WATCHDOG_EXCHANGE(&ctx->hw_tripped, true)) {
+        WATCHDOG_LOG_FATAL("Channel %d timed out, no longer petting the hardware watchdog", channel_id);
+    }
+    
+    // Runs unlocked, after the flight recorder has been flushed. Only the
+    // default reset stage of an escalating channel resets the system.
+    if (!channel->callback) {
+        if (channel->escalation != NULL) {
+            WATCHDOG_LOG_FATAL("Channel %d reached its reset stage, resetting the system", channel_id);
+            watchdog_system_reset();
+            return;
+        }
+        WATCHDOG_LOG_FATAL("No callback for channel %d, system will exit", channel_id);
+        exit(1);
+    }
+    
+    watchdog_run_callback(ctx, channel->callback, channel_id, channel->user_data);
+}
+
+// Run a callback on the context's executor, its worker pool, or in place
+static void watchdog_run_callback(struct watchdog_context *ctx, watchdog_callback_t callback, int channel_id,
+                                  void *user_data) {
+    if (ctx->executor != NULL) {
+        ctx->executor(callback, channel_id, user_data, ctx->executor_context);
+    } else if (ctx->dispatch_pool) {
+        watchdog_dispatch_submit(ctx->dispatch_pool, callback, channel_id, user_data);
+    } else {
+        uint64_t started = WATCHDOG_STATS_NOW();
+        callback(channel_id, user_data);
+        WATCHDOG_STATS_RECORD(&ctx->stats.callback_duration, WATCHDOG_STATS_NOW() - started);
+    }
+}
+
+// Convert a tick interval to nanoseconds
+static uint64_t watchdog_ticks_to_ns(int64_t ticks) {
+    return (uint64_t)(ticks / WATCHDOG_TICK_HZ * 1000000000 + ticks % WATCHDOG_TICK_HZ * 1000000000 / WATCHDOG_TICK_HZ);
+}
+
+// Take the lifecycle lock, spinning on a plain load between attempts
+static void watchdog_lifecycle_lock(void) {
+    while (WATCHDOG_EXCHANGE(&g_watchdog_lifecycle_lock, 1) != 0) {
+        while (WATCHDOG_LOAD(&g_watchdog_lifecycle_lock) != 0) {
+        }
+    }
+}
+
+static void watchdog_lifecycle_unlock(void) {
+    WATCHDOG_STORE_RELEASE(&g_watchdog_lifecycle_lock, 0);
+}
+
+// Start the platform services shared by all contexts for the first one.
+// The log thread only runs while some context has threads of its own;
+// otherwise records are drained on the logging thread. Contexts created
+// concurrently wait on the lifecycle lock until the services are up.
+static int watchdog_platform_acquire(bool threaded) {
+    watchdog_lifecycle_lock();
+    if (g_watchdog_users++ == 0 && watchdog_os_init() != 0) {
+        g_watchdog_users = 0;
+        watchdog_lifecycle_unlock();
+        return -1;
+    }
+    
+    if (threaded && g_watchdog_log_users++ == 0) {
+        if (watchdog_log_start() != 0) {
+            g_watchdog_log_users = 0;
+            if (--g_watchdog_users == 0) {
+                watchdog_os_cleanup();
+            }
+            watchdog_lifecycle_unlock();
+            return -1;
+        }
+        watchdog_log_async(true);
+    }
+    watchdog_lifecycle_unlock();
+    return 0;
+}
+
+// Stop the shared platform services after the last context
+static void watchdog_platform_release(bool threaded) {
+    watchdog_lifecycle_lock();
+    if (threaded && --g_watchdog_log_users == 0) {
+        watchdog_log_async(false);
+        watchdog_log_stop();
+    }
+    
+    if (--g_watchdog_users == 0) {
+        watchdog_os_cleanup();
+    }
+    watchdog_lifecycle_unlock();
+}
+
+// Set up a zeroed context: shards, callback dispatch and its timer thread
+static int watchdog_context_init(struct watchdog_context *ctx, const z_wdt_config *config) {
+    uint32_t max_channels = WATCHDOG_MAX_CHANNELS;
+    uint32_t initial_channels = WATCHDOG_MAX_CHANNELS;
+    uint32_t shard_count = 1;
+    if (config != NULL && config->max_channels != 0) {
+        max_channels = config->max_channels;
+        initial_channels = config->initial_channels;
+    }
+    if (initial_channels > max_channels) {
+        initial_channels = max_channels;
+    }
+    if (config != NULL && config->shards != 0) {
+        shard_count = config->shards;
+    }
+    if (shard_count > WATCHDOG_MAX_SHARDS) {
+        WATCHDOG_LOG_ERROR("Invalid shard count: %u (max %u)", shard_count, WATCHDOG_MAX_SHARDS);
+        return -1;
+    }
+    
+    // The critical class takes one more shard, served by a thread of its own
+    uint32_t critical_channels = config != NULL ? config->critical_channels : 0;
+    if (critical_channels != 0 && config->external_loop) {
+        WATCHDOG_LOG_ERROR("The critical class needs a timer thread, not an external loop");
+        return -1;
+    }
+    if (critical_channels != 0 && shard_count >= WATCHDOG_MAX_SHARDS) {
+        WATCHDOG_LOG_ERROR("No shard left for the critical class (max %u shards)", WATCHDOG_MAX_SHARDS);
+        return -1;
+    }
+    
+    ctx->timer_mutex = watchdog_mutex_create();
+    if (ctx->timer_mutex == NULL) {
+        WATCHDOG_LOG_ERROR("Failed to create timer mutex");
+        return -1;
+    }
+    memset(&ctx->progress, 0, sizeof(ctx->progress));
+    ctx->resumed_at = INT64_MIN;
+    for (uint32_t i = 0; i < shard_count + (critical_channels != 0); i++) {
+        bool critical = i == shard_count;
+        ctx->shards[i].progress = &ctx->progress;
+        ctx->shards[i].resumed_at = &ctx->resumed_at;
+        ctx->shards[i].critical = critical;
+        if (watchdog_shard_init(&ctx->shards[i], i, critical ? critical_channels : max_channels,
+                                critical ? critical_channels : initial_channels) != 0) {
+            watchdog_release_shards(ctx);
+            return -1;
+        }
+        ctx->shard_count++;
+    }
+    ctx->critical = critical_channels != 0 ? &ctx->shards[shard_count] : NULL;
+    ctx->shard_policy = config != NULL ? config->shard_policy : Z_WDT_SHARD_BY_THREAD;
+    ctx->timer_resolution = config != NULL ? watchdog_ms_to_ticks(config->timer_resolution) : 0;
+    ctx->default_slack = config != NULL ? config->default_slack : 0;
+    ctx->next_timeout_ticks = INT64_MAX;
+    ctx->timer_running = true;
+    
+    // The recorder is in place before the first channel is added
+    const char *recorder_path = config != NULL ? config->recorder_path : NULL;
+    if ((recorder_path != NULL || (config != NULL && config->flight_recorder)) &&
+        watchdog_recorder_init(&ctx->recorder, recorder_path) != 0) {
+        watchdog_release_shards(ctx);
+        return -1;
+    }
+    
+    // Pick where timeout callbacks run: executor, worker pool or timer thread
+    if (config != NULL && config->executor != NULL) {
+        ctx->executor = config->executor;
+        ctx->executor_context = config->executor_context;
+    } else if (config != NULL && config->dispatch_workers > 0) {
+        ctx->dispatch_pool = watchdog_dispatch_create(config->dispatch_workers);
+        if (ctx->dispatch_pool == NULL) {
+            WATCHDOG_LOG_ERROR("Failed to start %u dispatch workers", config->dispatch_workers);
+            watchdog_release_shards(ctx);
+            return -1;
+        }
+    }
+    
+    ctx->external = config != NULL && config->external_loop;
+    ctx->timer = watchdog_timer_create(ctx, config != NULL ? config->timer_priority : 0, ctx->external);
+    if (ctx->timer == NULL) {
+        WATCHDOG_LOG_ERROR("Failed to start the timer");
+        if (ctx->dispatch_pool != NULL) {
+            watchdog_dispatch_destroy(ctx->dispatch_pool);
+            ctx->dispatch_pool = NULL;
+        }
+        watchdog_release_shards(ctx);
+        return -1;
+    }
+    
+    if (ctx->critical != NULL) {
+        ctx->critical_timer = watchdog_timer_create_critical(ctx, config->critical_priority, config->critical_cpus);
+        if (ctx->critical_timer == NULL) {
+            WATCHDOG_LOG_ERROR("Failed to start the critical timer");
+            watchdog_timer_destroy(ctx->timer);
+            ctx->timer = NULL;
+            if (ctx->dispatch_pool != NULL) {
+                watchdog_dispatch_destroy(ctx->dispatch_pool);
+                ctx->dispatch_pool = NULL;
+            }
+            watchdog_release_shards(ctx);
+            return -1;
+        }
+    }
+    
+    WATCHDOG_STORE_RELEASE(&ctx->initialized, true);
+    return 0;
+}
+
+// Stop a context's timer and workers, then free its shards
+static void watchdog_context_release(struct watchdog_context *ctx) {
+    z_wdt_ctx_hw_disable(ctx);
+    watchdog_timer_destroy(ctx->critical_timer);
+    ctx->critical_timer = NULL;
+    watchdog_timer_destroy(ctx->timer);
+    ctx->timer = NULL;
+    if (ctx->dispatch_pool != NULL) {
+        watchdog_dispatch_destroy(ctx->dispatch_pool);
+        ctx->dispatch_pool = NULL;
+    }
+    WATCHDOG_STORE(&ctx->initialized, false);
+    watchdog_release_shards(ctx);
+}
+
+// Return a context to the static pool or the heap
+static void watchdog_context_free(struct watchdog_context *ctx) {
+#ifdef WATCHDOG_STATIC_CHANNELS
+    watchdog_lifecycle_lock();
+    ctx->allocated = false;
+    watchdog_lifecycle_unlock();
+#else
+    free(ctx);
+#endif
+}
+
+// Set up one shard's table, scheduler and lock
+static int watchdog_shard_init(struct watchdog_shard *shard, uint32_t index,
+                               uint32_t max_channels, uint32_t initial_channels) {
+    shard->index = index;
+    shard->expired_head = -1;
+    shard->expired_tail = -1;
+    shard->next_timeout_ticks = INT64_MAX;
+    
+    if (watchdog_table_init(&shard->table, max_channels, initial_channels) != 0) {
+        WATCHDOG_LOG_ERROR("Failed to allocate channel table (%u channels)", max_channels);
+        return -1;
+    }
+    shard->current_ticks = watchdog_get_ticks();
+    watchdog_sched_reset(shard);
+    if (watchdog_sched_reserve(shard, shard->table.capacity) != 0) {
+        WATCHDOG_LOG_ERROR("Failed to allocate scheduler");
+        watchdog_sched_release(shard);
+        watchdog_table_cleanup(&shard->table);
+        return -1;
+    }
+    
+    shard->mutex = watchdog_mutex_create();
+    if (shard->mutex == NULL) {
+        WATCHDOG_LOG_ERROR("Failed to create mutex for shard %u", index);
+        watchdog_sched_release(shard);
+        watchdog_table_cleanup(&shard->table);
+        return -1;
+    }
+    return 0;
+}
+
+// Tear down every initialized shard, the timer mutex and the recorder
+static void watchdog_release_shards(struct watchdog_context *ctx) {
+    for (uint32_t i = 0; i < ctx->shard_count; i++) {
+        struct watchdog_shard *shard = &ctx->shards[i];
+        // Static feeds stop at the pinned slot count before the table goes
+        WATCHDOG_STORE_RELEASE(&shard->pinned_slots, 0);
+        watchdog_sched_release(shard);
+        watchdog_table_cleanup(&shard->table);
+        watchdog_mutex_destroy(shard->mutex);
+        shard->mutex = NULL;
+        shard->critical = false;
+    }
+    ctx->shard_count = 0;
+    ctx->critical = NULL;
+    
+    if (ctx->timer_mutex != NULL) {
+        watchdog_mutex_destroy(ctx->timer_mutex);
+        ctx->timer_mutex = NULL;
+    }
+    watchdog_recorder_release(&ctx->recorder);
+}
+
+#ifdef Z_WDT_HAVE_STATIC_CHANNELS
+// Add the Z_WDT_DEFINE_CHANNEL() descriptors to the first shard's leading
+// slots, which a fresh table hands out in order, so each channel's slot is
+// its position in the section
+static int watchdog_register_static(struct watchdog_context *ctx) {
+    const z_wdt_static_channel *first = __start_z_wdt_channels;
+    uint32_t count = first != NULL ? (uint32_t)(__stop_z_wdt_channels - first) : 0;
+    struct watchdog_shard *shard = &ctx->shards[0];
+    int64_t current_ticks = watchdog_get_ticks();
+    
+    watchdog_mutex_lock(shard->mutex);
+    for (uint32_t i = 0; i < count; i++) {
+        const z_wdt_static_channel *descriptor = &first[i];
+        int index = descriptor->reload_period != 0 ? watchdog_alloc_slot(shard) : -1;
+        if (index != (int)i) {
+            watchdog_mutex_unlock(shard->mutex);
+            WATCHDOG_LOG_ERROR("Cannot add static watchdog channel %u of %u", i, count);
+            return -1;
+        }
+        
+        struct watchdog_channel *channel = WATCHDOG_CHANNEL(shard, index);
+        channel->reload_period = descriptor->reload_period;
+        channel->slack = ctx->default_slack;
+        channel->user_data = descriptor->user_data;
+        channel->callback = descriptor->callback;
+#if WATCHDOG_STATS
+        WATCHDOG_STORE(&channel->feeds, 0);
+        WATCHDOG_STORE(&channel->min_margin, INT64_MAX);
+#endif
+        watchdog_feed_channel(shard, index, current_ticks);
+        WATCHDOG_STORE_RELEASE(&channel->generation, channel->generation + 1);
+        *descriptor->channel_id = watchdog_make_handle(shard->index, (uint32_t)index, channel->generation);
+        watchdog_recorder_event(&ctx->recorder, Z_WDT_EVENT_ADD, *descriptor->channel_id, current_ticks);
+    }
+    WATCHDOG_STORE_RELEASE(&shard->pinned_slots, count);
+    watchdog_schedule_next_timeout(ctx, shard);
+    watchdog_mutex_unlock(shard->mutex);
+    
+    if (count != 0) {
+        WATCHDOG_LOG_INFO("Added %u static watchdog channels", count);
+    }
+    return 0;
+}
+#endif
+
+// Shard named by a handle (NULL for negative IDs and unused shard numbers)
+static struct watchdog_shard *watchdog_shard_of(struct watchdog_context *ctx, int channel_id) {
+    if (channel_id < 0) {
+        return NULL;
+    }
+    
+    uint32_t shard = watchdog_handle_shard(channel_id);
+    return shard < WATCHDOG_LOAD(&ctx->shard_count) ? &ctx->shards[shard] : NULL;
+}
+
+// Map a handle to its channel in the shard if it still names the active
+// generation. The slot generation is returned even on failure (0 if there's no slot).
+static struct watchdog_channel *watchdog_resolve(struct watchdog_shard *shard, int channel_id,
+                                                 uint32_t *generation) {
+    *generation = 0;
+    if (channel_id < 0) {
+        return NULL;
+    }
+    
+    struct watchdog_channel *channel =
+        watchdog_table_lookup(&shard->table, (uint32_t)channel_id & WATCHDOG_INDEX_MASK);
+    if (channel == NULL) {
+        return NULL;
+    }
+    
+    *generation = WATCHDOG_LOAD_ACQUIRE(&channel->generation);
+    return watchdog_handle_matches(channel_id, *generation) ? channel : NULL;
+}
+
+// Lock-free part of a feed: move the timeout one period past current_ticks.
+// Returns -1 for a stale handle, 0 when done and 1 if the scheduler is
+// armed later than the new timeout and needs watchdog_feed_requeue().
+static int watchdog_feed_at(struct watchdog_context *ctx, int channel_id, int64_t current_ticks) {
+    struct watchdog_shard *shard = watchdog_shard_of(ctx, channel_id);
+    if (shard == NULL) {
+        return -1;
+    }
+    
+    uint32_t generation;
+    struct watchdog_channel *channel = watchdog_resolve(shard, channel_id, &generation);
+    if (channel == NULL || channel->is_group) {
+        return -1;
+    }
+    
+    return watchdog_feed_slot(ctx, shard, channel, (int)((uint32_t)channel_id & WATCHDOG_INDEX_MASK),
+                              generation, current_ticks);
+}
+
+// Feed a resolved channel seen with the given (active) generation, as for
+// watchdog_feed_at()
+static int watchdog_feed_slot(struct watchdog_context *ctx, struct watchdog_shard *shard,
+                              struct watchdog_channel *channel, int index, uint32_t generation,
+                              int64_t current_ticks) {
+    // Progress channels just count the feed in the calling CPU's row. A
+    // feed racing a delete may count once for the column's next owner.
+    if (channel->progress >= 0) {
+        uint32_t cpu = watchdog_shard_hint(Z_WDT_SHARD_BY_CPU);
+        WATCHDOG_FETCH_ADD(&shard->progress->counts[cpu % WATCHDOG_PROGRESS_CPUS][channel->progress], 1);
+#if WATCHDOG_STATS
+        WATCHDOG_FETCH_ADD(&ctx->stats.cpus[cpu % WATCHDOG_STATS_CPUS].feeds, 1);
+#endif
+        watchdog_recorder_event_on(&ctx->recorder, cpu, Z_WDT_EVENT_FEED,
+                                   watchdog_make_handle(shard->index, (uint32_t)index, generation), current_ticks);
+        return 0;
+    }
+    
+    bool newest = channel->min_period != 0 &&
+                  watchdog_adaptive_sample(channel, current_ticks, WATCHDOG_LOAD(&ctx->resumed_at));
+    return watchdog_feed_deadline(ctx, shard, channel, index, generation, current_ticks, newest);
+}
+
+// Claim a free progress counter column and zero it (-1 if all are taken)
+static int watchdog_progress_claim(struct watchdog_progress *progress) {
+    uint64_t used = WATCHDOG_LOAD(&progress->used);
+    int column;
+    do {
+        if (~used == 0 || (column = WATCHDOG_CTZ64(~used)) >= WATCHDOG_PROGRESS_CHANNELS) {
+            return -1;
+        }
+    } while (!WATCHDOG_CAS(&progress->used, &used, used | (uint64_t)1 << column));
+    
+    for (uint32_t cpu = 0; cpu < WATCHDOG_PROGRESS_CPUS; cpu++) {
+        WATCHDOG_STORE(&progress->counts[cpu][column], 0);
+    }
+    progress->seen[column] = 0;
+    return column;
+}
+
+// Feeds counted in a progress column over all CPUs
+static uint64_t watchdog_progress_total(const struct watchdog_progress *progress, int column) {
+    uint64_t total = 0;
+    for (uint32_t cpu = 0; cpu < WATCHDOG_PROGRESS_CPUS; cpu++) {
+        total += WATCHDOG_LOAD(&progress->counts[cpu][column]);
+    }
+    return total;
+}
+
+// Record the interval since an adaptive channel's previous feed, or since
+// the last resume if that came later. Returns false, without a sample, when
+// another feed already recorded this tick or a later one.
+static bool watchdog_adaptive_sample(struct watchdog_channel *channel, int64_t current_ticks, int64_t resumed_at) {
+    int64_t last = WATCHDOG_LOAD(&channel->last_feed);
+    while (current_ticks > last && !WATCHDOG_CAS(&channel->last_feed, &last, current_ticks)) {
+    }
+    last = resumed_at > last ? resumed_at : last;
+    if (last >= current_ticks) {
+        return false;
+    }
+    
+    // Concurrent feeders of one channel may drop a sample here, which only
+    // slows down adaptation. Gaps beyond the period count as the period.
+    int64_t interval = current_ticks - last;
+    int64_t limit = watchdog_ms_to_ticks(channel->reload_period);
+    interval = interval < limit ? interval : limit;
+    
+    uint32_t samples = WATCHDOG_LOAD(&channel->samples);
+    int64_t mean = interval * 8;
+    int64_t dev = interval * 2;
+    if (samples != 0) {
+        int64_t error = interval - WATCHDOG_LOAD(&channel->interval_mean) / 8;
+        mean = WATCHDOG_LOAD(&channel->interval_mean) + error;
+        dev = WATCHDOG_LOAD(&channel->interval_dev);
+        dev += (error < 0 ? -error : error) - dev / 4;
+    }
+    WATCHDOG_STORE(&channel->interval_mean, mean);
+    WATCHDOG_STORE(&channel->interval_dev, dev);
+    if (samples < WATCHDOG_ADAPTIVE_WARMUP) {
+        WATCHDOG_STORE(&channel->samples, samples + 1);
+    }
+    return true;
+}
+
+// Re-arm a fed channel whose timeout moved ahead of its scheduler key (mutex held)
+static void watchdog_feed_requeue(struct watchdog_shard *shard, int channel_id) {
+    uint32_t generation;
+    struct watchdog_channel *channel = watchdog_resolve(shard, channel_id, &generation);
+    if (channel == NULL) {
+        return;
+    }
+    
+    int index = (int)((uint32_t)channel_id & WATCHDOG_INDEX_MASK);
+    int64_t key = WATCHDOG_LOAD(WATCHDOG_TIMEOUT(shard, index)) - watchdog_channel_lead(channel);
+    if (key < channel->sched_key) {
+        watchdog_requeue_channel(shard, index, key);
+    }
+}
+
+// Take a free slot, growing the table by a chunk when needed (mutex held)
+static int watchdog_alloc_slot(struct watchdog_shard *shard) {
+    int index = watchdog_table_alloc(&shard->table);
+    if (index >= 0) {
+        return index;
+    }
+    
+    // Size the scheduler for the new chunk first so a queued slot always fits
+    if (shard->table.capacity >= shard->table.max_channels ||
+        watchdog_sched_reserve(shard, shard->table.capacity + WATCHDOG_CHUNK_SIZE) != 0 ||
+        watchdog_table_grow(&shard->table) != 0) {
+        return -1;
+    }
+    return watchdog_table_alloc(&shard->table);
+}
+
+// Take a free slot for a new channel, starting at the caller's shard and
+// spilling over into the next ones when full; critical channels only go
+// to the critical shard. Returns with that shard's mutex held, or -1 with
+// no mutex held.
+static int watchdog_claim_slot(struct watchdog_context *ctx, bool critical, struct watchdog_shard **shard) {
+    if (critical) {
+        *shard = ctx->critical;
+        watchdog_mutex_lock((*shard)->mutex);
+        int index = watchdog_alloc_slot(*shard);
+        if (index < 0) {
+            watchdog_mutex_unlock((*shard)->mutex);
+        }
+        return index;
+    }
+    
+    uint32_t shard_count = ctx->shard_count - (ctx->critical != NULL);
+    uint32_t first = shard_count > 1 ? watchdog_shard_hint(ctx->shard_policy) % shard_count : 0;
+    
+    for (uint32_t n = 0; n < shard_count; n++) {
+        *shard = &ctx->shards[(first + n) % shard_count];
+        watchdog_mutex_lock((*shard)->mutex);
+        int index = watchdog_alloc_slot(*shard);
+        if (index >= 0) {
+            return index;
+        }
+        watchdog_mutex_unlock((*shard)->mutex);
+    }
+    return -1;
+}
+
+// Clear a retired channel and put its slot back on the free list (mutex held)
+static void watchdog_release_slot(struct watchdog_shard *shard, int index) {
+    struct watchdog_channel *channel = WATCHDOG_CHANNEL(shard, index);
+    
+    if (channel->progress >= 0) {
+        WATCHDOG_FETCH_AND(&shard->progress->used, ~((uint64_t)1 << channel->progress));
+        channel->progress = -1;
+    }
+    channel->reload_period = 0;
+    channel->min_period = 0;
+    channel->callback = NULL;
+    channel->user_data = NULL;
+    channel->escalation = NULL;
+    channel->is_group = false;
+    channel->suspended = false;
+    channel->group = -1;
+    channel->group_first = -1;
+    channel->group_prev = -1;
+    channel->group_next = -1;
+    
+    // Pinned slots stay with their static channel, retired
+    if ((uint32_t)index < shard->pinned_slots) {
+        watchdog_table_retire(&shard->table, index);
+        return;
+    }
+    watchdog_table_free(&shard->table, index);
+}
+
+// Set a channel's timeout one period after current_ticks and requeue it.
+// Groups have no period; their members are fed instead.
+static void watchdog_feed_channel(struct watchdog_shard *shard, int index, int64_t current_ticks) {
+    struct watchdog_channel *channel = WATCHDOG_CHANNEL(shard, index);
+    if (channel->is_group) {
+        return;
+    }
+    
+    int64_t timeout = watchdog_channel_timeout(channel, current_ticks);
+    
+    // Adaptive intervals start over from here, so suspended time never counts
+    WATCHDOG_STORE(&channel->last_feed, current_ticks);
+    shard->current_ticks = current_ticks;
+    WATCHDOG_STORE_RELEASE(WATCHDOG_TIMEOUT(shard, index), timeout);
+    watchdog_requeue_channel(shard, index, timeout - watchdog_channel_lead(channel));
+}
+
+// Deadline of a channel, counting the last resume as a feed (mutex held).
+// Only a deadline whose first stage passed needs looking at: if it is
+// earlier than one period after the resume, the channel was not fed since
+// and gets that instead, stored like a feed so later checks see it directly.
+static int64_t watchdog_effective_timeout(struct watchdog_shard *shard, int index) {
+    struct watchdog_channel *channel = WATCHDOG_CHANNEL(shard, index);
+    int64_t *deadline = WATCHDOG_TIMEOUT(shard, index);
+    int64_t timeout = WATCHDOG_LOAD(deadline);
+    int64_t resumed_at = WATCHDOG_LOAD_ACQUIRE(shard->resumed_at);
+    if (timeout - watchdog_channel_lead(channel) > shard->current_ticks || resumed_at == INT64_MIN) {
+        return timeout;
+    }
+    
+    int64_t resumed_timeout = watchdog_channel_timeout(channel, resumed_at);
+    if (resumed_timeout <= timeout) {
+        return timeout;
+    }
+    
+    // Concurrent feeds may store a later timeout; adaptive intervals start
+    // at the resume, as if it had fed the channel
+    while (resumed_timeout > timeout && !WATCHDOG_CAS(deadline, &timeout, resumed_timeout)) {
+    }
+    int64_t last = WATCHDOG_LOAD(&channel->last_feed);
+    while (resumed_at > last && !WATCHDOG_CAS(&channel->last_feed, &last, resumed_at)) {
+    }
+    return resumed_timeout > timeout ? resumed_timeout : timeout;
+}
+
+// Arm the scheduler for a channel at the given timeout (mutex held). A
+// group member isn't queued itself; it can only pull its group's key in.
+static void watchdog_requeue_channel(struct watchdog_shard *shard, int index, int64_t timeout) {
+    struct watchdog_channel *channel = WATCHDOG_CHANNEL(shard, index);
+    if (channel->group >= 0) {
+        index = channel->group;
+        channel = WATCHDOG_CHANNEL(shard, index);
+        if (timeout >= channel->sched_key) {
+            return;
+        }
+    }
+    
+    WATCHDOG_STORE(&channel->sched_key, timeout);
+    watchdog_sched_update(shard, index);
+}
+
+// Publish a shard's next timeout and re-arm the timer if it moved (mutex held)
+static void watchdog_schedule_next_timeout(struct watchdog_context *ctx, struct watchdog_shard *shard) {
+    int64_t next_timeout = watchdog_sched_next(shard);
+    
+    if (next_timeout != shard->next_timeout_ticks) {
+        WATCHDOG_STORE(&shard->next_timeout_ticks, next_timeout);
+        if (shard->critical) {
+            watchdog_arm_critical(ctx);
+        } else {
+            watchdog_arm_timer(ctx);
+        }
+    }
+}
+
+// Arm the platform timer for the earliest timeout over all shards. Taken
+// after any shard mutex, so concurrent re-arms can't leave a later deadline.
+static void watchdog_arm_timer(struct watchdog_context *ctx) {
+    watchdog_mutex_lock(ctx->timer_mutex);
+    
+    int64_t next_timeout = INT64_MAX;
+    for (uint32_t i = 0; i < ctx->shard_count; i++) {
+        int64_t timeout = WATCHDOG_LOAD(&ctx->shards[i].next_timeout_ticks);
+        if (timeout < next_timeout && !ctx->shards[i].critical) {
+            next_timeout = timeout;
+        }
+    }
+    
+    // Round wakeups up to the context's resolution so nearby timeouts share one
+    if (ctx->timer_resolution > 1 && next_timeout != INT64_MAX) {
+        next_timeout = (next_timeout + ctx->timer_resolution - 1) / ctx->timer_resolution * ctx->timer_resolution;
+    }
+    if (ctx->timer_running && next_timeout != INT64_MAX) {
+        watchdog_timer_start(ctx->timer, next_timeout);
+    } else {
+        next_timeout = INT64_MAX;
+        watchdog_timer_stop(ctx->timer);
+    }
+    WATCHDOG_STORE(&ctx->next_timeout_ticks, next_timeout);
+    
+    watchdog_mutex_unlock(ctx->timer_mutex);
+}
+
+// Arm the critical timer for the critical shard's next timeout, exactly:
+// no timer_resolution rounding. The shard mutex serializes the re-arms.
+static void watchdog_arm_critical(struct watchdog_context *ctx) {
+    int64_t next_timeout = WATCHDOG_LOAD(&ctx->critical->next_timeout_ticks);
+    if (WATCHDOG_LOAD(&ctx->timer_running) && next_timeout != INT64_MAX) {
+        watchdog_timer_start(ctx->critical_timer, next_timeout);
+    } else {
+        watchdog_timer_stop(ctx->critical_timer);
+    }
+}
+
+// Cleanup function
+void z_wdt_cleanup(void) {
+    if (g_watchdog_ctx.initialized) {
+        bool threaded = !g_watchdog_ctx.external;
+        watchdog_context_release(&g_watchdog_ctx);
+        watchdog_platform_release(threaded);
+        WATCHDOG_LOG_INFO("Watchdog cleaned up");
+    }
+}
+
+/* Default context wrappers */
+z_wdt_ctx_t *z_wdt_default(void) {
+    return &g_watchdog_ctx;
+}
+
+int z_wdt_add(uint32_t reload_period, watchdog_callback_t callback, void *user_data) {
+    return z_wdt_ctx_add(&g_watchdog_ctx, reload_period, callback, user_data);
+}
+
+int z_wdt_add_ex(uint32_t reload_period, uint32_t slack, watchdog_callback_t callback, void *user_data) {
+    return z_wdt_ctx_add_ex(&g_watchdog_ctx, reload_period, slack, callback, user_data);
+}
+
+int z_wdt_add_adaptive(uint32_t reload_period, uint32_t min_period, watchdog_callback_t callback, void *user_data) {
+    return z_wdt_ctx_add_adaptive(&g_watchdog_ctx, reload_period, min_period, callback, user_data);
+}
+
+int z_wdt_add_progress(uint32_t reload_period, watchdog_callback_t callback, void *user_data) {
+    return z_wdt_ctx_add_progress(&g_watchdog_ctx, reload_period, callback, user_data);
+}
+
+int z_wdt_add_class(uint32_t reload_period, z_wdt_class cls, watchdog_callback_t callback, void *user_data) {
+    return z_wdt_ctx_add_class(&g_watchdog_ctx, reload_period, cls, callback, user_data);
+}
+
+int z_wdt_add_escalating(uint32_t reload_period, const z_wdt_escalation *escalation, void *user_data) {
+    return z_wdt_ctx_add_escalating(&g_watchdog_ctx, reload_period, escalation, user_data);
+}
+
+int z_wdt_group_create(watchdog_callback_t callback, void *user_data) {
+    return z_wdt_ctx_group_create(&g_watchdog_ctx, callback, user_data);
+}
+
+int z_wdt_group_add(int group_id, uint32_t reload_period, watchdog_callback_t callback, void *user_data) {
+    return z_wdt_ctx_group_add(&g_watchdog_ctx, group_id, reload_period, callback, user_data);
+}
+
+int z_wdt_delete(int channel_id) {
+    return z_wdt_ctx_delete(&g_watchdog_ctx, channel_id);
+}
+
+int z_wdt_feed(int channel_id) {
+    return z_wdt_ctx_feed(&g_watchdog_ctx, channel_id);
+}
+
+int z_wdt_feed_many(const int *channel_ids, size_t count) {
+    return z_wdt_ctx_feed_many(&g_watchdog_ctx, channel_ids, count);
+}
+
+int z_wdt_feed_mask(const int *channel_ids, uint64_t mask) {
+    return z_wdt_ctx_feed_mask(&g_watchdog_ctx, channel_ids, mask);
+}
+
+#ifdef Z_WDT_HAVE_STATIC_CHANNELS
+// Feed a Z_WDT_DEFINE_CHANNEL() channel by its pinned slot (see z_wdt_feed_static()).
+// Checks the slot against the pinned count, which is 0 outside z_wdt_init()
+// ... z_wdt_cleanup(), and the generation; then only the deadline half of a
+// feed runs, as static channels are never progress or adaptive channels.
+int z_wdt_feed_static_slot(uint32_t slot) {
+    struct watchdog_context *ctx = &g_watchdog_ctx;
+    struct watchdog_shard *shard = &ctx->shards[0];
+    if (slot >= WATCHDOG_LOAD_ACQUIRE(&shard->pinned_slots)) {
+        return -1;
+    }
+    
+    // The slot never changes owner, so only a timeout can retire it
+    struct watchdog_channel *channel = WATCHDOG_CHANNEL(shard, slot);
+    uint32_t generation = WATCHDOG_LOAD_ACQUIRE(&channel->generation);
+    if (!WATCHDOG_GEN_ACTIVE(generation)) {
+        return -1;
+    }
+    
+    int result = watchdog_feed_deadline(ctx, shard, channel, (int)slot, generation, watchdog_get_ticks(), false);
+    if (result > 0) {
+        watchdog_mutex_lock(shard->mutex);
+        watchdog_feed_requeue(shard, watchdog_make_handle(shard->index, slot, generation));
+        watchdog_schedule_next_timeout(ctx, shard);
+        watchdog_mutex_unlock(shard->mutex);
+    }
+    
+    return result < 0 ? -1 : 0;
+}
+#endif
+
+void z_wdt_suspend(void) {
+    z_wdt_ctx_suspend(&g_watchdog_ctx);
+}
+
+void z_wdt_resume(void) {
+    z_wdt_ctx_resume(&g_watchdog_ctx);
+}
+
+int z_wdt_channel_suspend(int channel_id) {
+    return z_wdt_ctx_channel_suspend(&g_watchdog_ctx, channel_id);
+}
+
+int z_wdt_channel_resume(int channel_id) {
+    return z_wdt_ctx_channel_resume(&g_watchdog_ctx, channel_id);
+}
+
+void z_wdt_process(void) {
+    z_wdt_ctx_process(&g_watchdog_ctx);
+}
+
+int64_t z_wdt_next_deadline(void) {
+    return z_wdt_ctx_next_deadline(&g_watchdog_ctx);
+}
+
+int z_wdt_get_fd(void) {
+    return z_wdt_ctx_get_fd(&g_watchdog_ctx);
+}
+
+int z_wdt_hw_enable(uint32_t hw_timeout) {
+    return z_wdt_ctx_hw_enable(&g_watchdog_ctx, hw_timeout);
+}
+
+void z_wdt_hw_disable(void) {
+    z_wdt_ctx_hw_disable(&g_watchdog_ctx);
+}
+
+int z_wdt_stats_get(z_wdt_stats *stats) {
+    return z_wdt_ctx_stats_get(&g_watchdog_ctx, stats);
+}
+
+int z_wdt_channel_stats_get(int channel_id, z_wdt_channel_stats *stats) {
+    return z_wdt_ctx_channel_stats_get(&g_watchdog_ctx, channel_id, stats);
+}
+
+z_wdt_recorder_t *z_wdt_recorder(void) {
+    return z_wdt_ctx_recorder(&g_watchdog_ctx);
+}
+
+int z_wdt_snapshot(void) {
+    return z_wdt_ctx_snapshot(&g_watchdog_ctx);
+}
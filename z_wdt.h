@@ -5,6 +5,7 @@
 #ifndef Z_WDT_H
 #define Z_WDT_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -12,22 +13,298 @@ extern "C" {
 #endif
 
 /* Configuration */
-#define WATCHDOG_MAX_CHANNELS 16
+#ifndef WATCHDOG_MAX_CHANNELS
+#define WATCHDOG_MAX_CHANNELS 16   // Default table size (fixed size with WATCHDOG_STATIC_CHANNELS)
+#endif
+#ifndef WATCHDOG_TICK_HZ
+#define WATCHDOG_TICK_HZ 1000      // Rate of watchdog_get_ticks(); reload periods stay in ms
+#endif
 
 /* Callback function type */
 typedef void (*watchdog_callback_t)(int channel_id, void *user_data);
 
+/* Runs a timeout callback somewhere else, e.g. on an application thread pool */
+typedef void (*z_wdt_executor_t)(watchdog_callback_t callback, int channel_id, void *user_data,
+                                 void *context);
+
+/* How z_wdt_add() picks a shard for a new channel */
+typedef enum {
+    Z_WDT_SHARD_BY_THREAD = 0,     // Hash of the creating thread
+    Z_WDT_SHARD_BY_CPU             // CPU the creating thread runs on
+} z_wdt_shard_policy;
+
+/* Channel classes for z_wdt_add_class() */
+typedef enum {
+    Z_WDT_CLASS_BEST_EFFORT = 0,   // Expired by the context's timer thread
+    Z_WDT_CLASS_CRITICAL           // Expired by the real-time critical thread (z_wdt_config.critical_channels)
+} z_wdt_class;
+
+/*
+ * Stage actions of an escalating channel (z_wdt_add_escalating()), each
+ * run once per missed feed at the given share of the period after the
+ * last feed. A feed starts over from the first stage; the last stage
+ * times the channel out. NULL picks the default action.
+ */
+typedef struct {
+    watchdog_callback_t warn;      // 50% (default: log a warning)
+    watchdog_callback_t dump;      // 100% (default: log, snapshot and flush the flight recorder)
+    watchdog_callback_t restart;   // 150% (default: log only)
+    watchdog_callback_t reset;     // 200%, the timeout (default: reset the system)
+} z_wdt_escalation;
+
+/* Independent watchdog instance with its own channels and timer thread */
+typedef struct watchdog_context z_wdt_ctx_t;
+
+/* Runtime configuration for z_wdt_init_ex() and z_wdt_create(); zero fields select defaults */
+typedef struct {
+    uint32_t max_channels;         // Channel table limit per shard (up to 2^(20 - WATCHDOG_SHARD_BITS))
+    uint32_t initial_channels;     // Slots allocated up front, the rest grow in chunks
+    uint32_t dispatch_workers;     // Callback worker threads (0 = run on the timer thread)
+    z_wdt_executor_t executor;     // Callback executor, takes precedence over dispatch_workers
+    void *executor_context;        // Passed to executor
+    uint32_t shards;               // Independent channel tables with their own locks (0 = 1)
+    z_wdt_shard_policy shard_policy;  // Placement of new channels across shards
+    uint32_t timer_resolution;     // Timer wakeups are rounded up to this many ms (0 = exact)
+    int timer_priority;            // Real-time priority of the timer thread (0 = default)
+    int external_loop;             // Nonzero: no threads, call z_wdt_process() when z_wdt_get_fd() is readable
+    uint32_t default_slack;        // Slack in ms for channels from z_wdt_add() (see z_wdt_add_ex())
+    uint32_t critical_channels;    // Channel table of the critical class (0 = no critical class)
+    int critical_priority;         // Real-time priority of the critical thread (0 = platform default)
+    uint64_t critical_cpus;        // CPUs the critical thread is pinned to, bit i for CPU i (0 = any)
+    int flight_recorder;           // Nonzero: record channel events (see z_wdt_ctx_recorder())
+    const char *recorder_path;     // File backing the recorder so it outlives a crash (implies flight_recorder)
+} z_wdt_config;
+
+/* Log2 histogram: buckets[i] counts samples of at least 2^(i-1) and under
+   2^i microseconds (buckets[0]: under 1us); longer ones only add to count */
+#define Z_WDT_STATS_BUCKETS 24
+
+typedef struct {
+    uint64_t count;                // Samples
+    uint64_t sum_ns;               // Total of all samples
+    uint64_t max_ns;               // Largest sample
+    uint64_t buckets[Z_WDT_STATS_BUCKETS];
+} z_wdt_histogram;
+
+/* Snapshot of a context's instrumentation (z_wdt_stats_get()) */
+typedef struct {
+    uint64_t feeds;                // Successful feeds
+    uint64_t feed_requeues;        // Feeds that moved ahead of the scheduler and took a shard lock
+    uint64_t wakeups;              // Processing passes
+    uint64_t timeouts;             // Channels that timed out (detection_latency.count)
+    z_wdt_histogram detection_latency;  // Processing time minus the missed deadline
+    z_wdt_histogram callback_duration;  // Callbacks run on the processing thread (no executor or workers)
+    z_wdt_histogram lock_wait;     // Processing pass waiting for a shard mutex
+    z_wdt_histogram lock_hold;     // Processing pass holding a shard mutex
+} z_wdt_stats;
+
+/* Per-channel counters (z_wdt_channel_stats_get()) */
+typedef struct {
+    uint64_t feeds;                // Feeds since the channel was added
+    int64_t min_margin_us;         // Least time left before the deadline at a feed (INT64_MAX if never fed)
+} z_wdt_channel_stats;
+
+/*
+ * Shared-memory supervision: one supervisor process creates a named
+ * region, worker processes attach to it and feed their slots without a
+ * syscall, and only the supervisor runs a deadline loop, reporting missed
+ * deadlines and slot owners that exited
+ */
+#define Z_WDT_SHM_NAME_MAX 32      // Region names and slot labels, including the NUL
+
+typedef struct watchdog_shm z_wdt_shm_t;
+
+typedef enum {
+    Z_WDT_SHM_TIMEOUT = 0,         // The slot was not fed within its period
+    Z_WDT_SHM_EXITED               // The owning process no longer exists
+} z_wdt_shm_reason;
+
+typedef struct {
+    int channel_id;                // Handle of the retired slot
+    int32_t pid;                   // Owning process
+    uint32_t reload_period;        // Period in milliseconds
+    z_wdt_shm_reason reason;
+    char label[Z_WDT_SHM_NAME_MAX];
+} z_wdt_shm_event;
+
+typedef void (*z_wdt_shm_callback_t)(const z_wdt_shm_event *event, void *user_data);
+
+/*
+ * Flight recorder: a fixed-size ring of channel events per CPU, written
+ * without locks or atomic read-modify-writes, plus a copy of the channel
+ * table taken whenever a channel times out. A file-backed recorder can be
+ * read with z_wdt_recorder_open() after the process or system went down.
+ */
+typedef struct watchdog_recorder z_wdt_recorder_t;
+
+typedef enum {
+    Z_WDT_EVENT_ADD = 1,           // Channel or group added
+    Z_WDT_EVENT_FEED,              // Channel fed
+    Z_WDT_EVENT_DELETE,            // Channel or group deleted
+    Z_WDT_EVENT_TIMEOUT            // Channel timed out, before its callback ran
+} z_wdt_event_type;
+
+typedef struct {
+    int64_t ticks;                 // watchdog_get_ticks() at the event
+    int channel_id;
+    uint32_t thread;               // Platform thread ID, low 28 bits
+    uint32_t cpu;                  // Ring the event was written to (CPU modulo the ring count)
+    z_wdt_event_type type;
+} z_wdt_event;
+
+typedef struct {
+    int channel_id;
+    uint32_t reload_period;        // Period in milliseconds (0 for a group)
+    int64_t deadline;              // Absolute timeout in ticks (INT64_MAX if suspended or a group)
+} z_wdt_channel_snapshot;
+
 /* Public API */
 int z_wdt_init(void);
+int z_wdt_init_ex(const z_wdt_config *config);
 int z_wdt_add(uint32_t reload_period, watchdog_callback_t callback, void *user_data);
+int z_wdt_add_ex(uint32_t reload_period, uint32_t slack, watchdog_callback_t callback, void *user_data);
+int z_wdt_add_adaptive(uint32_t reload_period, uint32_t min_period, watchdog_callback_t callback, void *user_data);
+int z_wdt_add_progress(uint32_t reload_period, watchdog_callback_t callback, void *user_data);
+int z_wdt_add_class(uint32_t reload_period, z_wdt_class cls, watchdog_callback_t callback, void *user_data);
+int z_wdt_add_escalating(uint32_t reload_period, const z_wdt_escalation *escalation, void *user_data);
 int z_wdt_delete(int channel_id);
 int z_wdt_feed(int channel_id);
+int z_wdt_feed_many(const int *channel_ids, size_t count);
+int z_wdt_feed_mask(const int *channel_ids, uint64_t mask);
 void z_wdt_suspend(void);
 void z_wdt_resume(void);
+int z_wdt_channel_suspend(int channel_id);
+int z_wdt_channel_resume(int channel_id);
 void z_wdt_cleanup(void);
 
-/* Platform internal API (called by platform layer) */
+/* External event loop integration (z_wdt_config.external_loop) */
+int64_t z_wdt_now(void);
+int64_t z_wdt_next_deadline(void);
+int z_wdt_get_fd(void);
+
+/* Channel groups: time out as soon as any member does; deleting a group deletes its members */
+int z_wdt_group_create(watchdog_callback_t callback, void *user_data);
+int z_wdt_group_add(int group_id, uint32_t reload_period, watchdog_callback_t callback, void *user_data);
+
+/*
+ * Channels declared at build time (GNU toolchains, ELF targets).
+ * Z_WDT_DEFINE_CHANNEL() places a read-only descriptor in the
+ * z_wdt_channels linker section, and z_wdt_init() adds all of them to the
+ * default context before it returns (one by one, under the shard mutex),
+ * pinned to the leading slots of its first shard in section order.
+ * z_wdt_feed_static(name) feeds one by that position, a link-time
+ * constant, instead of decoding a handle: it checks the position against
+ * the registered count and the slot generation, then runs the deadline
+ * CAS, recorder event and stats of a normal feed. They cannot be deleted,
+ * and a channel that timed out stays retired.
+ */
+#if defined(__GNUC__) && defined(__ELF__)
+#define Z_WDT_HAVE_STATIC_CHANNELS 1
+
+typedef struct {
+    const char *name;
+    uint32_t reload_period;        // Period in milliseconds
+    watchdog_callback_t callback;
+    void *user_data;
+    int *channel_id;               // Handle, set by z_wdt_init() (-1 before)
+} z_wdt_static_channel;
+
+/* Section bounds provided by the linker (NULL when nothing is declared) */
+extern const z_wdt_static_channel __start_z_wdt_channels[] __attribute__((weak));
+extern const z_wdt_static_channel __stop_z_wdt_channels[] __attribute__((weak));
+
+/* The explicit alignment stops the compiler padding descriptors apart */
+#define Z_WDT_DEFINE_CHANNEL_EX(name, period, cb, data)                             \
+    int z_wdt_channel_id_##name = -1;                                               \
+    __attribute__((section("z_wdt_channels"), used,                                 \
+                   aligned(__alignof__(z_wdt_static_channel))))                     \
+    const z_wdt_static_channel z_wdt_channel_##name =                               \
+        { #name, (period), (cb), (data), &z_wdt_channel_id_##name }
+#define Z_WDT_DEFINE_CHANNEL(name, period, cb) Z_WDT_DEFINE_CHANNEL_EX(name, period, cb, NULL)
+
+/* Use a channel defined in another file */
+#define Z_WDT_DECLARE_CHANNEL(name)                                                 \
+    extern int z_wdt_channel_id_##name;                                             \
+    extern const z_wdt_static_channel z_wdt_channel_##name
+
+#define Z_WDT_STATIC_CHANNEL_COUNT ((size_t)(__stop_z_wdt_channels - __start_z_wdt_channels))
+#define z_wdt_static_id(name) (z_wdt_channel_id_##name)
+#define z_wdt_feed_static(name) \
+    z_wdt_feed_static_slot((uint32_t)(&z_wdt_channel_##name - __start_z_wdt_channels))
+
+int z_wdt_feed_static_slot(uint32_t slot);
+#endif
+
+/* Hardware watchdog petted while no channel has timed out (timeout in ms) */
+int z_wdt_hw_enable(uint32_t hw_timeout);
+void z_wdt_hw_disable(void);
+
+/* Instrumentation snapshots, -1 when built with WATCHDOG_STATS=0 */
+int z_wdt_stats_get(z_wdt_stats *stats);
+int z_wdt_channel_stats_get(int channel_id, z_wdt_channel_stats *stats);
+int z_wdt_stats_prometheus(const z_wdt_stats *stats, char *buffer, size_t size);
+
+/* Flight recorder of the default context (NULL if not configured) and an on-demand table snapshot */
+z_wdt_recorder_t *z_wdt_recorder(void);
+int z_wdt_snapshot(void);
+
+/* Context API: the calls above act on the default context set up by z_wdt_init(), z_wdt_default() */
+z_wdt_ctx_t *z_wdt_default(void);
+z_wdt_ctx_t *z_wdt_create(const z_wdt_config *config);
+void z_wdt_destroy(z_wdt_ctx_t *ctx);
+int z_wdt_ctx_add(z_wdt_ctx_t *ctx, uint32_t reload_period, watchdog_callback_t callback, void *user_data);
+int z_wdt_ctx_add_ex(z_wdt_ctx_t *ctx, uint32_t reload_period, uint32_t slack,
+                     watchdog_callback_t callback, void *user_data);
+int z_wdt_ctx_add_adaptive(z_wdt_ctx_t *ctx, uint32_t reload_period, uint32_t min_period,
+                           watchdog_callback_t callback, void *user_data);
+int z_wdt_ctx_add_progress(z_wdt_ctx_t *ctx, uint32_t reload_period, watchdog_callback_t callback,
+                           void *user_data);
+int z_wdt_ctx_add_class(z_wdt_ctx_t *ctx, uint32_t reload_period, z_wdt_class cls,
+                        watchdog_callback_t callback, void *user_data);
+int z_wdt_ctx_add_escalating(z_wdt_ctx_t *ctx, uint32_t reload_period, const z_wdt_escalation *escalation,
+                             void *user_data);
+int z_wdt_ctx_delete(z_wdt_ctx_t *ctx, int channel_id);
+int z_wdt_ctx_group_create(z_wdt_ctx_t *ctx, watchdog_callback_t callback, void *user_data);
+int z_wdt_ctx_group_add(z_wdt_ctx_t *ctx, int group_id, uint32_t reload_period,
+                        watchdog_callback_t callback, void *user_data);
+int z_wdt_ctx_feed(z_wdt_ctx_t *ctx, int channel_id);
+int z_wdt_ctx_feed_many(z_wdt_ctx_t *ctx, const int *channel_ids, size_t count);
+int z_wdt_ctx_feed_mask(z_wdt_ctx_t *ctx, const int *channel_ids, uint64_t mask);
+void z_wdt_ctx_suspend(z_wdt_ctx_t *ctx);
+void z_wdt_ctx_resume(z_wdt_ctx_t *ctx);
+int z_wdt_ctx_channel_suspend(z_wdt_ctx_t *ctx, int channel_id);
+int z_wdt_ctx_channel_resume(z_wdt_ctx_t *ctx, int channel_id);
+int64_t z_wdt_ctx_next_deadline(z_wdt_ctx_t *ctx);
+int z_wdt_ctx_get_fd(z_wdt_ctx_t *ctx);
+int z_wdt_ctx_hw_enable(z_wdt_ctx_t *ctx, uint32_t hw_timeout);
+void z_wdt_ctx_hw_disable(z_wdt_ctx_t *ctx);
+int z_wdt_ctx_stats_get(z_wdt_ctx_t *ctx, z_wdt_stats *stats);
+int z_wdt_ctx_channel_stats_get(z_wdt_ctx_t *ctx, int channel_id, z_wdt_channel_stats *stats);
+z_wdt_recorder_t *z_wdt_ctx_recorder(z_wdt_ctx_t *ctx);
+int z_wdt_ctx_snapshot(z_wdt_ctx_t *ctx);
+
+/* Reading a recorder: a live one, or the file of an earlier run (open, read, close) */
+z_wdt_recorder_t *z_wdt_recorder_open(const char *path);
+void z_wdt_recorder_close(z_wdt_recorder_t *recorder);
+int z_wdt_recorder_events(z_wdt_recorder_t *recorder, z_wdt_event *events, size_t max);
+int z_wdt_recorder_channels(z_wdt_recorder_t *recorder, z_wdt_channel_snapshot *channels, size_t max,
+                            int64_t *ticks);
+
+/* Shared-memory supervision: supervisor side (create, process, wait) and worker side (attach, add, feed) */
+z_wdt_shm_t *z_wdt_shm_create(const char *name, uint32_t slots, z_wdt_shm_callback_t callback, void *user_data);
+z_wdt_shm_t *z_wdt_shm_attach(const char *name);
+void z_wdt_shm_close(z_wdt_shm_t *shm);
+int z_wdt_shm_add(z_wdt_shm_t *shm, uint32_t reload_period, const char *label);
+int z_wdt_shm_delete(z_wdt_shm_t *shm, int channel_id);
+int z_wdt_shm_feed(z_wdt_shm_t *shm, int channel_id);
+int z_wdt_shm_process(z_wdt_shm_t *shm);
+int z_wdt_shm_wait(z_wdt_shm_t *shm);
+
+/* Platform internal API (called by platform layer, or by the application's loop) */
 void z_wdt_process(void);
+void z_wdt_ctx_process(z_wdt_ctx_t *ctx);
+void z_wdt_ctx_process_critical(z_wdt_ctx_t *ctx);
+void z_wdt_log_drain(void);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,210 @@
+/*
+ * Embedded Watchdog Framework - C++17 interface
+ * Header-only RAII layer over the context API. A z_wdt::Channel owns its
+ * channel and deletes it when destroyed; periods are std::chrono durations
+ * and the timeout callback is any callable, so state is captured instead of
+ * passed through void *user_data.
+ *
+ * Channel::feed() is inline: the handle is resolved once when the channel
+ * is added, and each feed moves the deadline slot directly, entering the
+ * library only when the scheduler must be re-armed. It reads the channel
+ * table layout, so code including this header must be built with the same
+ * -D flags as the library (WATCHDOG_SCHEDULER, WATCHDOG_STATIC_CHANNELS,
+ * WATCHDOG_STATS, WATCHDOG_TICK_HZ...).
+ *
+ * No exceptions are thrown: a Channel that could not be added is empty and
+ * its feed() returns -1. Channels must be destroyed before z_wdt_cleanup()
+ * or z_wdt_destroy() of their context.
+ */
+
+#ifndef Z_WDT_HPP
+#define Z_WDT_HPP
+
+extern "C" {
+#include "z_wdt_internal.h"
+}
+
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace z_wdt {
+
+namespace detail {
+
+// Timeout callback shared by its Channel and the library: the Channel holds
+// one reference and the pending timeout the other
+struct Callback {
+    std::atomic<int> refs{2};
+
+    virtual ~Callback() = default;
+    virtual void invoke(int channel_id) = 0;
+
+    void release(int count) noexcept {
+        if (refs.fetch_sub(count, std::memory_order_acq_rel) == count) {
+            delete this;
+        }
+    }
+};
+
+template <typename F>
+struct CallbackImpl final : Callback {
+    F function;
+
+    explicit CallbackImpl(F &&f) : function(std::move(f)) {}
+    explicit CallbackImpl(const F &f) : function(f) {}
+
+    // The callable takes the channel ID or nothing
+    void invoke(int channel_id) override {
+        if constexpr (std::is_invocable_v<F &, int>) {
+            function(channel_id);
+        } else {
+            function();
+        }
+    }
+};
+
+// watchdog_callback_t entry: a channel times out once, so the timeout's
+// reference is dropped after the call
+inline void trampoline(int channel_id, void *user_data) {
+    Callback *callback = static_cast<Callback *>(user_data);
+    callback->invoke(channel_id);
+    callback->release(1);
+}
+
+} // namespace detail
+
+// Move-only owner of a watchdog channel
+class Channel {
+public:
+    Channel() noexcept = default;
+
+    // Add a channel to ctx (the default context if nullptr) that times out
+    // period after its last feed, rounded up to whole milliseconds
+    template <typename Rep, typename Period, typename F>
+    Channel(std::chrono::duration<Rep, Period> period, F &&callback, z_wdt_ctx_t *ctx = nullptr) noexcept {
+        static_assert(std::is_invocable_v<std::decay_t<F> &, int> || std::is_invocable_v<std::decay_t<F> &>,
+                      "callback must be callable as f(int channel_id) or f()");
+
+        auto ms = std::chrono::ceil<std::chrono::milliseconds>(period).count();
+        if (ms <= 0 || ms > static_cast<decltype(ms)>(UINT32_MAX)) {
+            return;
+        }
+
+        detail::Callback *holder = new (std::nothrow) detail::CallbackImpl<std::decay_t<F>>(std::forward<F>(callback));
+        if (holder == nullptr) {
+            return;
+        }
+
+        ctx_ = ctx != nullptr ? ctx : z_wdt_default();
+        id_ = z_wdt_ctx_add(ctx_, static_cast<uint32_t>(ms), detail::trampoline, holder);
+        if (id_ < 0) {
+            delete holder;
+            ctx_ = nullptr;
+            return;
+        }
+        callback_ = holder;
+        bind();
+    }
+
+    Channel(const Channel &) = delete;
+    Channel &operator=(const Channel &) = delete;
+
+    Channel(Channel &&other) noexcept {
+        take(other);
+    }
+
+    Channel &operator=(Channel &&other) noexcept {
+        if (this != &other) {
+            reset();
+            take(other);
+        }
+        return *this;
+    }
+
+    ~Channel() {
+        reset();
+    }
+
+    // Feed the channel: 0 on success, -1 if it is empty, timed out or its
+    // context is gone. Lock-free unless the scheduler must be re-armed.
+    int feed() noexcept {
+        if (channel_ == nullptr || !WATCHDOG_LOAD(&ctx_->initialized)) {
+            return -1;
+        }
+
+        int result = watchdog_feed_deadline(ctx_, shard_, channel_, static_cast<int>(index_), generation_,
+                                            watchdog_get_ticks(), false);
+        if (result > 0) {
+            watchdog_feed_rearm(ctx_, id_);
+        }
+        return result < 0 ? -1 : 0;
+    }
+
+    // Delete the channel now (if it has not timed out) and leave this empty
+    void reset() noexcept {
+        if (callback_ != nullptr) {
+            // A deleted channel can no longer time out, so both references go;
+            // otherwise its callback has run or is running and drops the other
+            callback_->release(z_wdt_ctx_delete(ctx_, id_) == 0 ? 2 : 1);
+        }
+        clear();
+    }
+
+    // Channel ID for the C API (-1 if empty)
+    int id() const noexcept {
+        return id_;
+    }
+
+    explicit operator bool() const noexcept {
+        return callback_ != nullptr;
+    }
+
+private:
+    // Resolve the handle once for the inline feed; a channel that already
+    // timed out is left unbound and its feeds fail
+    void bind() noexcept {
+        shard_ = &ctx_->shards[watchdog_handle_shard(id_)];
+        index_ = static_cast<uint32_t>(id_) & WATCHDOG_INDEX_MASK;
+        struct watchdog_channel *channel = watchdog_table_lookup(&shard_->table, index_);
+        if (channel != nullptr) {
+            generation_ = WATCHDOG_LOAD_ACQUIRE(&channel->generation);
+            channel_ = watchdog_handle_matches(id_, generation_) ? channel : nullptr;
+        }
+    }
+
+    void take(Channel &other) noexcept {
+        ctx_ = other.ctx_;
+        callback_ = other.callback_;
+        shard_ = other.shard_;
+        channel_ = other.channel_;
+        index_ = other.index_;
+        generation_ = other.generation_;
+        id_ = other.id_;
+        other.clear();
+    }
+
+    void clear() noexcept {
+        ctx_ = nullptr;
+        callback_ = nullptr;
+        shard_ = nullptr;
+        channel_ = nullptr;
+        index_ = 0;
+        generation_ = 0;
+        id_ = -1;
+    }
+
+    z_wdt_ctx_t *ctx_ = nullptr;
+    detail::Callback *callback_ = nullptr;
+    struct watchdog_shard *shard_ = nullptr;
+    struct watchdog_channel *channel_ = nullptr;   // Bound slot, nullptr if empty or already timed out
+    uint32_t index_ = 0;
+    uint32_t generation_ = 0;
+    int id_ = -1;
+};
+
+} // namespace z_wdt
+
+#endif // Z_WDT_HPP
@@ -0,0 +1,819 @@
+/*
+ * Embedded Watchdog Framework - Internal Definitions
+ * Shared between the core and the deadline scheduler backends
+ */
+
+#ifndef Z_WDT_INTERNAL_H
+#define Z_WDT_INTERNAL_H
+
+#include "z_wdt.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Deadline scheduler backends (select with -DWATCHDOG_SCHEDULER=...) */
+#define WATCHDOG_SCHED_ARRAY 0         // Linear scan over the channel table
+#define WATCHDOG_SCHED_HEAP  1         // Indexed binary min-heap
+#define WATCHDOG_SCHED_WHEEL 2         // Hierarchical timing wheel
+
+#ifndef WATCHDOG_SCHEDULER
+#define WATCHDOG_SCHEDULER WATCHDOG_SCHED_HEAP
+#endif
+
+/* Timing wheel configuration (WATCHDOG_SCHED_WHEEL only) */
+#ifndef WATCHDOG_WHEEL_RESOLUTION
+#define WATCHDOG_WHEEL_RESOLUTION 1    // Ticks per wheel slot at level 0
+#endif
+#ifndef WATCHDOG_WHEEL_LEVELS
+#define WATCHDOG_WHEEL_LEVELS 4        // Levels of 64 slots, spans 64^levels slots
+#endif
+#define WATCHDOG_WHEEL_BITS 6
+#define WATCHDOG_WHEEL_SIZE (1 << WATCHDOG_WHEEL_BITS)
+
+/* Count trailing zeros of a non-zero 64-bit word */
+#if defined(__GNUC__)
+#define WATCHDOG_CTZ64(x) __builtin_ctzll(x)
+#else
+static inline int watchdog_ctz64(uint64_t x) {
+    int n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+}
+#define WATCHDOG_CTZ64(x) watchdog_ctz64(x)
+#endif
+
+/* Count leading zeros of a non-zero 64-bit word */
+#if defined(__GNUC__)
+#define WATCHDOG_CLZ64(x) __builtin_clzll(x)
+#else
+static inline int watchdog_clz64(uint64_t x) {
+    int n = 0;
+    while (!(x & ((uint64_t)1 << 63))) {
+        x <<= 1;
+        n++;
+    }
+    return n;
+}
+#define WATCHDOG_CLZ64(x) watchdog_clz64(x)
+#endif
+
+/*
+ * Atomic accessors for fields shared with the lock-free feed path, on the
+ * GNU __atomic builtins (GCC, Clang, armclang...). Other compilers must
+ * define WATCHDOG_CUSTOM_ATOMICS and provide the same macros with the same
+ * orderings; plain read-modify-write sequences are not enough, even on a
+ * single core when feeds come from interrupts.
+ */
+#if defined(__GNUC__)
+#define WATCHDOG_LOAD(p)            __atomic_load_n((p), __ATOMIC_RELAXED)
+#define WATCHDOG_LOAD_ACQUIRE(p)    __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define WATCHDOG_STORE(p, v)        __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#define WATCHDOG_STORE_RELEASE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define WATCHDOG_CAS(p, expected, desired) \
+    __atomic_compare_exchange_n((p), (expected), (desired), false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#define WATCHDOG_EXCHANGE(p, v)     __atomic_exchange_n((p), (v), __ATOMIC_ACQ_REL)
+#define WATCHDOG_FETCH_ADD(p, v)    __atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+#define WATCHDOG_FETCH_AND(p, v)    __atomic_fetch_and((p), (v), __ATOMIC_RELAXED)
+#elif !defined(WATCHDOG_CUSTOM_ATOMICS)
+#error "z_wdt needs the GNU __atomic builtins; define WATCHDOG_CUSTOM_ATOMICS and the WATCHDOG_LOAD... macros"
+#endif
+
+/*
+ * Log levels. Messages below WATCHDOG_LOG_LEVEL compile to nothing,
+ * arguments included. Release builds (NDEBUG) keep WARN and above.
+ */
+#define WATCHDOG_LEVEL_DEBUG 0
+#define WATCHDOG_LEVEL_INFO  1
+#define WATCHDOG_LEVEL_WARN  2
+#define WATCHDOG_LEVEL_ERROR 3
+#define WATCHDOG_LEVEL_FATAL 4
+
+#ifndef WATCHDOG_LOG_LEVEL
+#ifdef NDEBUG
+#define WATCHDOG_LOG_LEVEL WATCHDOG_LEVEL_WARN
+#else
+#define WATCHDOG_LOG_LEVEL WATCHDOG_LEVEL_INFO
+#endif
+#endif
+
+#ifndef WATCHDOG_LOG_RING_BITS
+#define WATCHDOG_LOG_RING_BITS 8       // 256 queued records
+#endif
+#define WATCHDOG_LOG_MAX_ARGS 4
+
+/*
+ * Log macros: the format must be a string literal and the arguments
+ * integers (cast %s arguments to intptr_t; they must stay valid until the
+ * record is drained). A trailing 0 keeps the argument list non-empty;
+ * more than WATCHDOG_LOG_MAX_ARGS arguments fail to compile.
+ */
+#define WATCHDOG_LOG(level, ...) \
+    do { \
+        if ((level) >= WATCHDOG_LOG_LEVEL) { \
+            WATCHDOG_LOG_WRITE((level), __VA_ARGS__, 0); \
+        } \
+    } while (0)
+#define WATCHDOG_LOG_ARGC(...) ((int)(sizeof((const int64_t[]){ __VA_ARGS__ }) / sizeof(int64_t)) - 1)
+#define WATCHDOG_LOG_WRITE(level, format, ...) \
+    ((void)sizeof(char[WATCHDOG_LOG_ARGC(__VA_ARGS__) <= WATCHDOG_LOG_MAX_ARGS ? 1 : -1]), \
+     watchdog_log_write((level), (format), (const int64_t[]){ __VA_ARGS__ }, WATCHDOG_LOG_ARGC(__VA_ARGS__)))
+
+#define WATCHDOG_LOG_DEBUG(...) WATCHDOG_LOG(WATCHDOG_LEVEL_DEBUG, __VA_ARGS__)
+#define WATCHDOG_LOG_INFO(...)  WATCHDOG_LOG(WATCHDOG_LEVEL_INFO, __VA_ARGS__)
+#define WATCHDOG_LOG_WARN(...)  WATCHDOG_LOG(WATCHDOG_LEVEL_WARN, __VA_ARGS__)
+#define WATCHDOG_LOG_ERROR(...) WATCHDOG_LOG(WATCHDOG_LEVEL_ERROR, __VA_ARGS__)
+#define WATCHDOG_LOG_FATAL(...) WATCHDOG_LOG(WATCHDOG_LEVEL_FATAL, __VA_ARGS__)
+
+/*
+ * Instrumentation. Feed counters live in per-CPU slots, one cache line
+ * each, so concurrent feeders don't bounce a shared line; histograms are
+ * only written by the processing pass. WATCHDOG_STATS=0 compiles it all
+ * out, timestamp reads included.
+ */
+#ifndef WATCHDOG_STATS
+#define WATCHDOG_STATS 1
+#endif
+#ifndef WATCHDOG_STATS_CPUS
+#define WATCHDOG_STATS_CPUS 16         // Feed counter slots, indexed by CPU
+#endif
+
+#if WATCHDOG_STATS
+#define WATCHDOG_STATS_NOW() watchdog_get_ns()
+#define WATCHDOG_STATS_RECORD(histogram, ns) watchdog_stats_record((histogram), (ns))
+#else
+#define WATCHDOG_STATS_NOW() ((uint64_t)0)
+#define WATCHDOG_STATS_RECORD(histogram, ns) ((void)(ns))
+#endif
+
+struct watchdog_stats_cpu {
+    uint64_t feeds;
+    uint64_t feed_requeues;
+    uint64_t pad[6];               // Pad to a cache line
+};
+
+struct watchdog_stats {
+    struct watchdog_stats_cpu cpus[WATCHDOG_STATS_CPUS];
+    uint64_t wakeups;
+    z_wdt_histogram callback_duration;
+    z_wdt_histogram lock_wait;
+    z_wdt_histogram lock_hold;
+};
+
+/* A channel is active while its generation counter is odd */
+#define WATCHDOG_GEN_ACTIVE(gen) (((gen) & 1u) != 0)
+
+/*
+ * Channel table layout. Slots live in fixed-size chunks that never move,
+ * so the lock-free feed path can index them while the table grows.
+ * Each chunk is split structure-of-arrays style: the deadlines are packed
+ * into their own int64 array and active slots are tracked in a bitmap, so
+ * expiry scans never touch the callback data in struct watchdog_channel.
+ * Define WATCHDOG_STATIC_CHANNELS to use static storage for exactly
+ * WATCHDOG_MAX_CHANNELS slots and never call malloc.
+ */
+#ifndef WATCHDOG_CHUNK_BITS
+#define WATCHDOG_CHUNK_BITS 8          // 256 slots per chunk
+#endif
+#if WATCHDOG_CHUNK_BITS < 6
+#error "WATCHDOG_CHUNK_BITS must be at least 6 (one bitmap word per chunk)"
+#endif
+#define WATCHDOG_CHUNK_SIZE (1u << WATCHDOG_CHUNK_BITS)
+#define WATCHDOG_CHUNK_MASK (WATCHDOG_CHUNK_SIZE - 1)
+#define WATCHDOG_CHUNK_COUNT(n) (((n) + WATCHDOG_CHUNK_SIZE - 1) / WATCHDOG_CHUNK_SIZE)
+#define WATCHDOG_BITMAP_WORDS(n) (((n) + 63) / 64)
+
+/*
+ * Shards: independent channel tables, each with its own lock and deadline
+ * queue. Static builds default to a single shard, since every shard
+ * carries its own fixed table.
+ */
+#ifndef WATCHDOG_SHARD_BITS
+#ifdef WATCHDOG_STATIC_CHANNELS
+#define WATCHDOG_SHARD_BITS 0
+#else
+#define WATCHDOG_SHARD_BITS 4          // Up to 16 shards
+#endif
+#endif
+#if WATCHDOG_SHARD_BITS > 6
+#error "WATCHDOG_SHARD_BITS must be at most 6 (one shard mask word)"
+#endif
+#define WATCHDOG_MAX_SHARDS (1u << WATCHDOG_SHARD_BITS)
+
+/*
+ * Adaptive timeouts track each channel's feed interval with the estimator
+ * TCP uses for its retransmission timeout (RFC 6298): a mean with gain 1/8
+ * and a mean deviation with gain 1/4, kept in ticks scaled by 8 and 4 so
+ * integer updates lose no precision. The timeout is the mean plus four
+ * deviations, bounded by the channel's min_period and reload_period.
+ */
+#ifndef WATCHDOG_ADAPTIVE_WARMUP
+#define WATCHDOG_ADAPTIVE_WARMUP 8     // Intervals seen before the timeout drops below reload_period
+#endif
+
+/*
+ * Progress channels: feeds only bump a counter and the processing pass
+ * checks once per period that the channel's total moved. Counters sit in
+ * per-CPU rows with one column per progress channel, so threads on
+ * different CPUs feeding one channel never write the same cache line.
+ * The rows are part of the context; nothing is allocated per channel.
+ */
+#ifndef WATCHDOG_PROGRESS_CHANNELS
+#ifdef WATCHDOG_STATIC_CHANNELS
+#define WATCHDOG_PROGRESS_CHANNELS 8
+#else
+#define WATCHDOG_PROGRESS_CHANNELS 64  // Progress channels per context
+#endif
+#endif
+#ifndef WATCHDOG_PROGRESS_CPUS
+#ifdef WATCHDOG_STATIC_CHANNELS
+#define WATCHDOG_PROGRESS_CPUS 4
+#else
+#define WATCHDOG_PROGRESS_CPUS 16      // Counter rows, indexed by CPU
+#endif
+#endif
+#if WATCHDOG_PROGRESS_CHANNELS > 64 || WATCHDOG_PROGRESS_CHANNELS % 8 != 0
+#error "WATCHDOG_PROGRESS_CHANNELS must be a multiple of 8 up to 64 (whole cache lines, one mask word)"
+#endif
+
+struct watchdog_progress {
+    uint64_t counts[WATCHDOG_PROGRESS_CPUS][WATCHDOG_PROGRESS_CHANNELS];  // Feeds per CPU (atomic)
+    uint64_t seen[WATCHDOG_PROGRESS_CHANNELS];  // Column totals at the last check (shard mutex)
+    uint64_t used;                 // Columns in use (atomic)
+};
+
+/*
+ * Escalating channels fire a stage every half period from half a period
+ * before their deadline (50%, 100%, 150% and 200% of the period after the
+ * last feed). The scheduler key sits at the next stage; stages before the
+ * last are collected into a per-pass batch and run after unlocking.
+ */
+#define WATCHDOG_STAGE_WARN    0
+#define WATCHDOG_STAGE_DUMP    1
+#define WATCHDOG_STAGE_RESTART 2
+#define WATCHDOG_STAGE_RESET   3       // The timeout, dispatched like any other
+#ifndef WATCHDOG_STAGE_BATCH
+#define WATCHDOG_STAGE_BATCH 16        // Stages a shard dispatches per pass, the rest wait a tick
+#endif
+
+struct watchdog_stage_event {
+    watchdog_callback_t callback;  // Stage action (NULL for the default)
+    void *user_data;
+    int channel_id;
+    int stage;
+};
+
+/* Channel handles: slot index in the low bits, then the shard, then the generation tag */
+#define WATCHDOG_SLOT_BITS  20
+#define WATCHDOG_INDEX_BITS (WATCHDOG_SLOT_BITS - WATCHDOG_SHARD_BITS)
+#define WATCHDOG_INDEX_MASK ((1u << WATCHDOG_INDEX_BITS) - 1)
+#define WATCHDOG_SHARD_MASK (WATCHDOG_MAX_SHARDS - 1)
+#define WATCHDOG_TAG_BITS   11
+#define WATCHDOG_TAG_MASK   ((1u << WATCHDOG_TAG_BITS) - 1)
+#define WATCHDOG_TABLE_LIMIT (1u << WATCHDOG_INDEX_BITS)
+
+#if WATCHDOG_MAX_CHANNELS < 1 || WATCHDOG_MAX_CHANNELS > WATCHDOG_TABLE_LIMIT
+#error "WATCHDOG_MAX_CHANNELS must be between 1 and WATCHDOG_TABLE_LIMIT"
+#endif
+
+/* Internal data structures (per-channel state off the scan path) */
+struct watchdog_channel {
+    uint32_t reload_period;        // Period in milliseconds
+    uint32_t generation;           // Bumped on add/delete/timeout; odd while active
+    uint32_t slack;                // Milliseconds the timeout may be deferred to share a wakeup
+    uint32_t min_period;           // Adaptive: lower bound of the timeout in ms (0 = fixed reload_period)
+    uint32_t samples;              // Adaptive: feed intervals seen, saturating at the warm-up (atomic)
+    int64_t last_feed;             // Adaptive: time of the latest feed (atomic)
+    int64_t interval_mean;         // Adaptive: feed interval mean in ticks, times 8 (atomic)
+    int64_t interval_dev;          // Adaptive: feed interval mean deviation in ticks, times 4 (atomic)
+#if WATCHDOG_STATS
+    uint64_t feeds;                // Feeds since the channel was added (atomic)
+    int64_t min_margin;            // Least ticks left before the deadline at a feed (atomic)
+#endif
+    int64_t sched_key;             // Timeout the scheduler is armed with (<= the deadline)
+    const z_wdt_escalation *escalation;  // Stage actions (NULL if the channel doesn't escalate)
+    int64_t stage_deadline;        // Escalation: deadline the fired stages count from (mutex held)
+    int stage;                     // Escalation: next stage to fire (mutex held)
+    void *user_data;               // User data for callback
+    watchdog_callback_t callback;  // Callback function
+    int sched_pos;                 // Position in the scheduler (-1 if not queued)
+    int next_free;                 // Next slot in the free list (-1 at the tail)
+    int group;                     // Member: slot of its group in the same shard (-1 if none)
+    int group_first;               // Group: first member (-1 if empty)
+    int group_prev;                // Previous member of the same group (-1 at the head)
+    int group_next;                // Next member of the same group (-1 at the tail)
+    int progress;                  // Progress counter column (-1 for deadline channels)
+    bool is_group;                 // Aggregate channel, times out when any member does
+    bool suspended;                // Parked by z_wdt_channel_suspend() (mutex held)
+#if WATCHDOG_SCHEDULER == WATCHDOG_SCHED_WHEEL
+    int sched_prev;                // Previous channel in the wheel slot list
+    int sched_next;                // Next channel in the wheel slot list
+#endif
+};
+
+/* Indexed binary min-heap keyed on sched_key */
+struct watchdog_heap_node {
+    int64_t key;                   // Copy of the channel's sched_key
+    int channel_id;                // Channel owning this node
+};
+
+struct watchdog_heap {
+    struct watchdog_heap_node *nodes;
+    int size;                      // Number of queued channels
+    int capacity;                  // Allocated nodes
+#ifdef WATCHDOG_STATIC_CHANNELS
+    struct watchdog_heap_node static_nodes[WATCHDOG_MAX_CHANNELS];
+#endif
+};
+
+/* Chunked channel table with a FIFO free list */
+struct watchdog_table {
+    struct watchdog_channel **chunks;  // Chunk directory, sized for max_channels
+    int64_t **deadlines;           // Absolute timeouts per chunk (atomic, written by feeders)
+    uint64_t *active;              // One bit per slot, set while the slot is in use
+    uint32_t max_channels;         // Hard limit on slots
+    uint32_t capacity;             // Slots allocated so far
+    int free_head;                 // Oldest free slot (-1 if none)
+    int free_tail;                 // Most recently freed slot
+#ifdef WATCHDOG_STATIC_CHANNELS
+    struct watchdog_channel static_channels[WATCHDOG_MAX_CHANNELS];
+    struct watchdog_channel *static_chunks[WATCHDOG_CHUNK_COUNT(WATCHDOG_MAX_CHANNELS)];
+    int64_t static_deadlines[WATCHDOG_MAX_CHANNELS];
+    int64_t *static_deadline_chunks[WATCHDOG_CHUNK_COUNT(WATCHDOG_MAX_CHANNELS)];
+    uint64_t static_active[WATCHDOG_BITMAP_WORDS(WATCHDOG_MAX_CHANNELS)];
+#endif
+};
+
+/* Hierarchical timing wheel; slot lists are linked through the channels */
+struct watchdog_wheel {
+    int slots[WATCHDOG_WHEEL_LEVELS][WATCHDOG_WHEEL_SIZE];  // List heads (-1 if empty)
+    uint64_t occupied[WATCHDOG_WHEEL_LEVELS];               // Non-empty slot bitmap
+    int64_t now_tick;              // First wheel tick not yet processed
+};
+
+/*
+ * Deadline scan kernel: compares count (<= 64) packed deadlines against
+ * now, sets bit i of *expired for each deadline <= now and returns the
+ * smallest deadline (INT64_MAX if none)
+ */
+typedef int64_t (*watchdog_scan_fn)(const int64_t *deadlines, uint32_t count, int64_t now,
+                                    uint64_t *expired);
+
+/* One deadline domain: channel table, scheduler and expiry state under one lock */
+struct watchdog_shard {
+    struct watchdog_table table;   // Channel slots
+#if WATCHDOG_SCHEDULER == WATCHDOG_SCHED_ARRAY
+    watchdog_scan_fn scan;         // Deadline scan kernel picked at init
+    uint64_t *escalating;          // Escalating slots, scheduled on sched_key instead of the deadline
+#ifdef WATCHDOG_STATIC_CHANNELS
+    uint64_t static_escalating[WATCHDOG_BITMAP_WORDS(WATCHDOG_MAX_CHANNELS)];
+#endif
+#elif WATCHDOG_SCHEDULER == WATCHDOG_SCHED_HEAP
+    struct watchdog_heap heap;     // Deadline queue
+#elif WATCHDOG_SCHEDULER == WATCHDOG_SCHED_WHEEL
+    struct watchdog_wheel wheel;   // Deadline queue
+#endif
+    void *mutex;                   // Guards everything above
+    uint32_t index;                // Shard number encoded in handles
+    int expired_head;              // Timed-out slots awaiting dispatch (linked via next_free)
+    int expired_tail;
+    int64_t current_ticks;         // Latest ticks seen under the mutex
+    int64_t next_timeout_ticks;    // Earliest queued timeout (atomic, read by the timer arming)
+    bool hw_pet_due;               // The hardware watchdog channel came due (mutex held)
+    struct watchdog_stage_event *staged;  // Escalation stages of the running pass (mutex held)
+    uint32_t staged_count;
+    bool critical;                 // Holds the critical class, expired by the critical timer
+    struct watchdog_progress *progress;  // The context's progress counters
+    const int64_t *resumed_at;     // The context's last resume
+    uint32_t pinned_slots;         // Leading slots of Z_WDT_DEFINE_CHANNEL() channels, never freed (atomic)
+#if WATCHDOG_STATS
+    z_wdt_histogram detection_latency;  // Lateness of the channels timed out here
+#endif
+};
+
+/*
+ * Flight recorder (z_wdt_recorder.c). Events go to per-CPU rings, each
+ * with its own head on a separate cache line, written with relaxed loads
+ * and stores only: a thread preempted between taking a record and filling
+ * it may lose its event to another thread on that CPU, but never waits.
+ * The region has a fixed layout, so a file from a crashed run can be read
+ * back by any build with the same settings, which the header records.
+ */
+#ifndef WATCHDOG_RECORDER_BITS
+#ifdef WATCHDOG_STATIC_CHANNELS
+#define WATCHDOG_RECORDER_BITS 6
+#else
+#define WATCHDOG_RECORDER_BITS 10      // 1024 events per ring
+#endif
+#endif
+#ifndef WATCHDOG_RECORDER_CPUS
+#ifdef WATCHDOG_STATIC_CHANNELS
+#define WATCHDOG_RECORDER_CPUS 1
+#else
+#define WATCHDOG_RECORDER_CPUS 16      // Rings, indexed by CPU
+#endif
+#endif
+#ifndef WATCHDOG_RECORDER_SNAPSHOT
+#ifdef WATCHDOG_STATIC_CHANNELS
+#define WATCHDOG_RECORDER_SNAPSHOT 16
+#else
+#define WATCHDOG_RECORDER_SNAPSHOT 256 // Channels kept by a table snapshot
+#endif
+#endif
+#define WATCHDOG_RECORDER_SIZE (1u << WATCHDOG_RECORDER_BITS)
+#define WATCHDOG_RECORDER_MASK (WATCHDOG_RECORDER_SIZE - 1)
+#define WATCHDOG_RECORDER_MAGIC   0x5A575246u  // "ZWRF"
+#define WATCHDOG_RECORDER_VERSION 1
+
+struct watchdog_recorder_record {
+    int64_t ticks;
+    uint64_t info;                 // Type in the top 4 bits, thread in the next 28, channel ID below (0 = unused)
+};
+
+struct watchdog_recorder_ring {
+    uint64_t head;                 // Events written to this ring (atomic)
+    uint64_t pad[7];               // Records start on a cache line
+    struct watchdog_recorder_record records[WATCHDOG_RECORDER_SIZE];
+};
+
+struct watchdog_recorder_region {
+    uint32_t magic;                // WATCHDOG_RECORDER_MAGIC once initialized
+    uint32_t version;
+    uint32_t ring_bits;            // Settings of the writing build
+    uint32_t cpus;
+    uint32_t snapshot_capacity;
+    uint32_t tick_hz;
+    uint32_t snapshot_count;       // Channels in the latest snapshot
+    uint32_t snapshot_busy;        // A snapshot is being taken (atomic)
+    int64_t snapshot_ticks;        // When the latest snapshot was taken (0 if none)
+    uint64_t pad[3];               // Rings start on a cache line
+    struct watchdog_recorder_ring rings[WATCHDOG_RECORDER_CPUS];
+    z_wdt_channel_snapshot snapshot[WATCHDOG_RECORDER_SNAPSHOT];
+};
+
+/* Handle of a region: a context's own, or one opened to read it back */
+struct watchdog_recorder {
+    struct watchdog_recorder_region *region;  // NULL while there is no recorder
+    size_t size;                   // Mapped bytes
+    bool mapped;                   // File-backed rather than allocated
+    bool allocated;                // Handed out by z_wdt_recorder_open()
+};
+
+/*
+ * Contexts created by z_wdt_create() in static builds come from a fixed
+ * pool, next to the default context used by z_wdt_init()
+ */
+#ifndef WATCHDOG_MAX_CONTEXTS
+#define WATCHDOG_MAX_CONTEXTS 4
+#endif
+
+struct watchdog_context {
+    struct watchdog_shard shards[WATCHDOG_MAX_SHARDS];
+    uint32_t shard_count;          // Shards in use
+    z_wdt_shard_policy shard_policy;
+    void *timer;                   // Platform timer thread processing this context
+    void *critical_timer;          // Real-time timer thread for the critical shard (NULL if none)
+    struct watchdog_shard *critical;  // Last shard, holding the critical class (NULL if none)
+    void *timer_mutex;             // Serializes arming the platform timer
+    int64_t timer_resolution;      // Armed deadlines are rounded up to this many ticks
+    z_wdt_executor_t executor;     // User callback executor (NULL if none)
+    void *executor_context;
+    void *dispatch_pool;           // Platform worker pool running the callbacks (NULL if none)
+    int64_t next_timeout_ticks;    // Armed wakeup, INT64_MAX if none (read by z_wdt_next_deadline())
+    uint32_t default_slack;        // Slack of channels added without one (ms)
+    bool external;                 // No timer thread; the application drives z_wdt_ctx_process()
+    int hw_channel;                // Synthetic channel petting the hardware watchdog
+    bool hw_enabled;               // This context owns the hardware watchdog
+    bool hw_tripped;               // A channel timed out; petting has stopped for good
+    bool allocated;                // Handed out by z_wdt_create()
+    bool initialized;              // Initialization flag
+    bool timer_running;            // Timer running flag
+    struct watchdog_progress progress;  // Counters of the progress channels
+    int64_t resumed_at;            // Last resume, a feed of every channel (atomic, INT64_MIN if none)
+    struct watchdog_recorder recorder;  // Flight recorder (region NULL if off)
+#if WATCHDOG_STATS
+    struct watchdog_stats stats;   // Instrumentation counters
+#endif
+};
+
+/* Slot lookup for callers that know the slot is allocated (mutex held) */
+#define WATCHDOG_SLOT(table, index) \
+    (&(table)->chunks[(uint32_t)(index) >> WATCHDOG_CHUNK_BITS][(uint32_t)(index) & WATCHDOG_CHUNK_MASK])
+#define WATCHDOG_CHANNEL(ctx, index) WATCHDOG_SLOT(&(ctx)->table, index)
+#define WATCHDOG_DEADLINE(table, index) \
+    (&(table)->deadlines[(uint32_t)(index) >> WATCHDOG_CHUNK_BITS][(uint32_t)(index) & WATCHDOG_CHUNK_MASK])
+#define WATCHDOG_TIMEOUT(ctx, index) WATCHDOG_DEADLINE(&(ctx)->table, index)
+
+// Slot lookup from any thread; NULL if the index was never allocated
+static inline struct watchdog_channel *watchdog_table_lookup(const struct watchdog_table *table,
+                                                             uint32_t index) {
+    if (index >= table->max_channels) {
+        return NULL;
+    }
+    struct watchdog_channel *chunk = WATCHDOG_LOAD_ACQUIRE(&table->chunks[index >> WATCHDOG_CHUNK_BITS]);
+    return chunk ? &chunk[index & WATCHDOG_CHUNK_MASK] : NULL;
+}
+
+// Public handle for a shard's slot in the given (active) generation
+static inline int watchdog_make_handle(uint32_t shard, uint32_t index, uint32_t generation) {
+    return (int)((((generation >> 1) & WATCHDOG_TAG_MASK) << WATCHDOG_SLOT_BITS) |
+                 (shard << WATCHDOG_INDEX_BITS) | index);
+}
+
+// Shard number of a handle (check it against the shard count)
+static inline uint32_t watchdog_handle_shard(int channel_id) {
+    return ((uint32_t)channel_id >> WATCHDOG_INDEX_BITS) & WATCHDOG_SHARD_MASK;
+}
+
+// Whether a handle's tag matches a slot generation
+static inline bool watchdog_handle_matches(int channel_id, uint32_t generation) {
+    return WATCHDOG_GEN_ACTIVE(generation) &&
+           (((uint32_t)channel_id >> WATCHDOG_SLOT_BITS) & WATCHDOG_TAG_MASK) ==
+           ((generation >> 1) & WATCHDOG_TAG_MASK);
+}
+
+/* Channel table management (z_wdt_table.c, mutex held) */
+int watchdog_table_init(struct watchdog_table *table, uint32_t max_channels, uint32_t initial_channels);
+void watchdog_table_cleanup(struct watchdog_table *table);
+int watchdog_table_grow(struct watchdog_table *table);
+int watchdog_table_alloc(struct watchdog_table *table);
+void watchdog_table_free(struct watchdog_table *table, int index);
+void watchdog_table_retire(struct watchdog_table *table, int index);
+
+/* Called for each expired channel; the channel is already dequeued */
+typedef void (*watchdog_expire_fn)(struct watchdog_shard *shard, int channel_id);
+
+/*
+ * Deadline scheduler interface (implemented by the selected backend).
+ * All functions are called with the shard's mutex held. Channels are
+ * queued on sched_key, a lower bound of the real timeout: feeds only move
+ * the deadline later without touching the scheduler, and the expire
+ * callback re-queues channels that turn out to have been fed meanwhile.
+ */
+void watchdog_sched_reset(struct watchdog_shard *shard);
+int watchdog_sched_reserve(struct watchdog_shard *shard, uint32_t capacity);
+void watchdog_sched_release(struct watchdog_shard *shard);
+void watchdog_sched_insert(struct watchdog_shard *shard, int channel_id);
+void watchdog_sched_remove(struct watchdog_shard *shard, int channel_id);
+void watchdog_sched_update(struct watchdog_shard *shard, int channel_id);
+int64_t watchdog_sched_next(struct watchdog_shard *shard);
+void watchdog_sched_expire(struct watchdog_shard *shard, int64_t now, watchdog_expire_fn fn);
+
+/* Indexed heap primitives (z_wdt_sched_heap.c) */
+void watchdog_heap_init(struct watchdog_heap *heap);
+int watchdog_heap_reserve(struct watchdog_heap *heap, uint32_t capacity);
+void watchdog_heap_release(struct watchdog_heap *heap);
+void watchdog_heap_push(struct watchdog_heap *heap, struct watchdog_table *table, int channel_id);
+void watchdog_heap_erase(struct watchdog_heap *heap, struct watchdog_table *table, int channel_id);
+void watchdog_heap_rekey(struct watchdog_heap *heap, struct watchdog_table *table, int channel_id);
+int watchdog_heap_pop(struct watchdog_heap *heap, struct watchdog_table *table);
+
+/* Asynchronous log ring (z_wdt_log.c) */
+void watchdog_log_write(int level, const char *format, const int64_t *args, int argc);
+void watchdog_log_async(bool async);
+
+/* Instrumentation histograms (z_wdt_stats.c) */
+void watchdog_stats_record(z_wdt_histogram *histogram, uint64_t ns);
+void watchdog_stats_merge(z_wdt_histogram *into, const z_wdt_histogram *histogram);
+
+/* Flight recorder setup and table snapshots (z_wdt_recorder.c) */
+int watchdog_recorder_init(struct watchdog_recorder *recorder, const char *path);
+void watchdog_recorder_release(struct watchdog_recorder *recorder);
+int watchdog_recorder_snapshot(struct watchdog_context *ctx);
+void watchdog_recorder_flush(struct watchdog_recorder *recorder);
+
+/* Deadline scan kernels for the running CPU (z_wdt_scan.c): the widest, or each in turn */
+watchdog_scan_fn watchdog_scan_select(const char **name);
+watchdog_scan_fn watchdog_scan_kernel(uint32_t index, const char **name);
+
+/*
+ * Shared-memory supervision region (z_wdt_shm.c), laid out like a table
+ * chunk: packed deadlines for the scan kernels, padded to whole blocks of
+ * 64 with INT64_MAX, then the slot data feeds never write. Deadlines are
+ * watchdog_get_ns() values, the clock every process shares. All processes
+ * must use the same build, which attach checks through the header.
+ */
+#define WATCHDOG_SHM_MAGIC   0x5A574453u  // "ZWDS"
+#define WATCHDOG_SHM_VERSION 1
+#ifndef WATCHDOG_SHM_LIVENESS_MS
+#define WATCHDOG_SHM_LIVENESS_MS 100   // Interval of the supervisor's owner liveness checks
+#endif
+
+struct watchdog_shm_slot {
+    uint32_t generation;           // Bumped on add/delete/timeout; odd while claimed (atomic)
+    int32_t pid;                   // Owning process
+    uint64_t period_ns;            // Reload period
+    char label[Z_WDT_SHM_NAME_MAX];
+};
+
+struct watchdog_shm_region {
+    uint32_t magic;                // WATCHDOG_SHM_MAGIC once initialized (release)
+    uint32_t version;
+    uint32_t slots;
+    uint32_t slot_size;            // sizeof(struct watchdog_shm_slot) of the creating build
+    int32_t supervisor_pid;
+    uint32_t wake;                 // Bumped by each add; the supervisor sleeps on it (atomic)
+    uint64_t pad[5];               // Deadlines start on a cache line
+    int64_t deadlines[];           // Absolute timeouts in ns (atomic, INT64_MAX when free)
+};
+
+// Move a slot's deadline later to timeout for the owner of the given slot
+// generation (z_wdt_shm.c); -1 once the supervisor or a delete retired it
+int watchdog_shm_feed_slot(z_wdt_shm_t *shm, uint32_t index, uint32_t generation, int64_t timeout);
+
+/* Platform abstraction functions (must be implemented by platform layer) */
+extern int64_t watchdog_get_ticks(void);
+extern uint64_t watchdog_get_ns(void);
+extern void *watchdog_timer_create(z_wdt_ctx_t *ctx, int priority, bool external);
+extern void *watchdog_timer_create_critical(z_wdt_ctx_t *ctx, int priority, uint64_t cpus);
+extern void watchdog_timer_destroy(void *timer);
+extern void watchdog_timer_start(void *timer, int64_t timeout_ticks);
+extern void watchdog_timer_stop(void *timer);
+extern int watchdog_timer_fd(void *timer);
+extern void watchdog_log(const char *level, const char *format, ...);
+extern void watchdog_log_wake(void);
+extern int watchdog_log_start(void);
+extern void watchdog_log_stop(void);
+extern int watchdog_os_init(void);
+extern void watchdog_os_cleanup(void);
+extern void *watchdog_mutex_create(void);
+extern void watchdog_mutex_destroy(void *mutex);
+extern void watchdog_mutex_lock(void *mutex);
+extern void watchdog_mutex_unlock(void *mutex);
+extern uint32_t watchdog_shard_hint(z_wdt_shard_policy policy);
+extern void *watchdog_dispatch_create(uint32_t workers);
+extern void watchdog_dispatch_submit(void *pool, watchdog_callback_t callback, int channel_id, void *user_data);
+extern void watchdog_dispatch_destroy(void *pool);
+extern int watchdog_hw_open(uint32_t *timeout_ms);
+extern void watchdog_hw_pet(void);
+extern void watchdog_hw_close(void);
+extern void *watchdog_shm_map(const char *name, size_t *size, bool create);
+extern void watchdog_shm_unmap(void *region, size_t size);
+extern void watchdog_shm_unlink(const char *name);
+extern void watchdog_shm_wait(uint32_t *word, uint32_t value, uint64_t timeout_ns);
+extern void watchdog_shm_wake(uint32_t *word);
+extern int32_t watchdog_process_id(void);
+extern bool watchdog_process_alive(int32_t pid);
+extern void watchdog_system_reset(void);
+extern uint32_t watchdog_thread_id(void);
+extern void *watchdog_recorder_map(const char *path, size_t *size, bool create);
+extern void watchdog_recorder_unmap(void *region, size_t size);
+extern void watchdog_recorder_sync(void *region, size_t size);
+
+// Append an event to the given CPU's ring of a context's recorder, if it
+// has one: a few relaxed stores to that ring's lines, no fence and no lock
+static inline void watchdog_recorder_event_on(const struct watchdog_recorder *recorder, uint32_t cpu,
+                                              z_wdt_event_type type, int channel_id, int64_t ticks) {
+    struct watchdog_recorder_region *region = recorder->region;
+    if (region == NULL) {
+        return;
+    }
+
+    struct watchdog_recorder_ring *ring = &region->rings[cpu % WATCHDOG_RECORDER_CPUS];
+    uint64_t pos = WATCHDOG_LOAD(&ring->head);
+    WATCHDOG_STORE(&ring->head, pos + 1);
+
+    struct watchdog_recorder_record *record = &ring->records[pos & WATCHDOG_RECORDER_MASK];
+    WATCHDOG_STORE(&record->ticks, ticks);
+    WATCHDOG_STORE(&record->info, (uint64_t)type << 60 | (uint64_t)(watchdog_thread_id() & 0x0FFFFFFFu) << 32 |
+                                  (uint32_t)channel_id);
+}
+
+// Append an event to the calling CPU's ring, for callers off the feed path
+static inline void watchdog_recorder_event(const struct watchdog_recorder *recorder, z_wdt_event_type type,
+                                           int channel_id, int64_t ticks) {
+    if (recorder->region != NULL) {
+        watchdog_recorder_event_on(recorder, watchdog_shard_hint(Z_WDT_SHARD_BY_CPU), type, channel_id, ticks);
+    }
+}
+
+// CPU hint of a feed, looked up once for both the recorder ring and the
+// stats slot; skipped when neither is in use
+static inline uint32_t watchdog_feed_cpu(const struct watchdog_context *ctx) {
+    return WATCHDOG_STATS || ctx->recorder.region != NULL ? watchdog_shard_hint(Z_WDT_SHARD_BY_CPU) : 0;
+}
+
+// Re-arm a channel after watchdog_feed_deadline() returned 1 (z_wdt.c);
+// takes the shard mutex
+extern void watchdog_feed_rearm(struct watchdog_context *ctx, int channel_id);
+
+// Convert milliseconds to ticks, rounding up so a timeout never fires early
+static inline int64_t watchdog_ms_to_ticks(uint32_t ms) {
+    return ((int64_t)ms * WATCHDOG_TICK_HZ + 999) / 1000;
+}
+
+// Ticks from a feed to the timeout: the reload period, or for an adaptive
+// channel past its warm-up the feed interval mean plus four mean
+// deviations, bounded by [min_period, reload_period]
+static inline int64_t watchdog_channel_period(const struct watchdog_channel *channel) {
+    int64_t period = watchdog_ms_to_ticks(channel->reload_period);
+    if (channel->min_period == 0 || WATCHDOG_LOAD(&channel->samples) < WATCHDOG_ADAPTIVE_WARMUP) {
+        return period;
+    }
+
+    int64_t adaptive = WATCHDOG_LOAD(&channel->interval_mean) / 8 + WATCHDOG_LOAD(&channel->interval_dev);
+    int64_t floor = watchdog_ms_to_ticks(channel->min_period);
+    return adaptive < floor ? floor : adaptive < period ? adaptive : period;
+}
+
+// Timeout one period after current_ticks. With slack it is deferred to the
+// roundest tick in [timeout, timeout + slack] (the boundary below the
+// highest bit that differs), so nearby timeouts of channels with similar
+// slack land on the same tick and share a wakeup. Monotonic in
+// current_ticks for a fixed period, so plain feeds only move deadlines later.
+static inline int64_t watchdog_channel_timeout(const struct watchdog_channel *channel, int64_t current_ticks) {
+    int64_t timeout = current_ticks + watchdog_channel_period(channel);
+    if (channel->slack == 0) {
+        return timeout;
+    }
+
+    uint64_t limit = (uint64_t)(timeout + watchdog_ms_to_ticks(channel->slack));
+    uint64_t mask = ~(uint64_t)0 >> WATCHDOG_CLZ64((uint64_t)timeout ^ limit) >> 1;
+    return (int64_t)(limit & ~mask);
+}
+
+// Ticks ahead of its deadline that a channel is first due in the scheduler:
+// half a period for an escalating channel, whose warning comes then
+static inline int64_t watchdog_channel_lead(const struct watchdog_channel *channel) {
+    return channel->escalation != NULL ? watchdog_channel_period(channel) / 2 : 0;
+}
+
+#if WATCHDOG_STATS
+// Count a feed in the feeding CPU's slot and track how close the channel
+// came to its deadline (previous deadline minus the feed time). The
+// channel's own counters take a relaxed load and store, no locked RMW, and
+// the margin is only written on a new minimum, so a channel fed from one
+// thread keeps its line local. Feeders racing on one channel may lose a
+// count; progress channels, fed from many threads, count per CPU instead.
+static inline void watchdog_stats_feed(struct watchdog_context *ctx, struct watchdog_channel *channel,
+                                       uint32_t cpu, int64_t margin, bool requeue) {
+    struct watchdog_stats_cpu *slot = &ctx->stats.cpus[cpu % WATCHDOG_STATS_CPUS];
+    WATCHDOG_FETCH_ADD(&slot->feeds, 1);
+    if (requeue) {
+        WATCHDOG_FETCH_ADD(&slot->feed_requeues, 1);
+    }
+
+    WATCHDOG_STORE(&channel->feeds, WATCHDOG_LOAD(&channel->feeds) + 1);
+    if (margin < WATCHDOG_LOAD(&channel->min_margin)) {
+        WATCHDOG_STORE(&channel->min_margin, margin);
+    }
+}
+#endif
+
+// Deadline half of a feed, shared by z_wdt.c and the inline
+// z_wdt::Channel::feed() of z_wdt.hpp: move the slot's timeout and report
+// whether the scheduler must be re-armed. newest is set for the newest feed
+// of an adaptive channel. Returns -1 if the handle went stale meanwhile, 0
+// when done, 1 when the caller must call watchdog_feed_rearm().
+static inline int watchdog_feed_deadline(struct watchdog_context *ctx, struct watchdog_shard *shard,
+                                         struct watchdog_channel *channel, int index, uint32_t generation,
+                                         int64_t current_ticks, bool newest) {
+    int64_t *deadline = WATCHDOG_TIMEOUT(shard, index);
+    int64_t timeout = watchdog_channel_timeout(channel, current_ticks);
+
+    // Only ever move the timeout later; a concurrent feeder or a delete
+    // (which parks it at INT64_MAX) may already have stored a larger value.
+    // The newest feed of an adaptive channel may also pull it in when the
+    // feed rate went up; an older feed racing it can at worst leave the
+    // timeout early by the gap between the two.
+    //
+    // The generation is checked after each load of the deadline and before
+    // the CAS that expects it. Writers retire the generation before they
+    // store to the slot (release), so a value read while it still matched
+    // belongs to this channel, and a stale handle never overwrites the
+    // deadline of the slot's next owner. Only a delete and re-add landing
+    // between the last check and the CAS, whose new deadline equals the
+    // value read, to the tick, could still slip through.
+    int64_t previous = WATCHDOG_LOAD_ACQUIRE(deadline);
+    do {
+        if (WATCHDOG_LOAD_ACQUIRE(&channel->generation) != generation) {
+            return -1;
+        }
+    } while ((timeout > previous || (newest && timeout < previous && previous != INT64_MAX)) &&
+             !WATCHDOG_CAS(deadline, &previous, timeout));
+
+    if (WATCHDOG_LOAD_ACQUIRE(&channel->generation) != generation) {
+        return -1;
+    }
+    uint32_t cpu = watchdog_feed_cpu(ctx);
+    watchdog_recorder_event_on(&ctx->recorder, cpu, Z_WDT_EVENT_FEED,
+                               watchdog_make_handle(shard->index, (uint32_t)index, generation), current_ticks);
+
+    // A suspended channel is parked at INT64_MAX and ignores feeds
+    if (previous == INT64_MAX) {
+        return 0;
+    }
+
+    // The armed scheduler key is normally earlier, so the timer thread just
+    // re-queues the channel when it gets there. Only a timeout moving ahead
+    // of the armed key needs the scheduler (and possibly the timer) updated.
+    bool requeue = timeout - watchdog_channel_lead(channel) < WATCHDOG_LOAD(&channel->sched_key);
+#if WATCHDOG_STATS
+    watchdog_stats_feed(ctx, channel, cpu, previous - current_ticks, requeue);
+#endif
+    return requeue ? 1 : 0;
+}
+
+#endif // Z_WDT_INTERNAL_H
@@ -0,0 +1,205 @@
+/*
+ * Embedded Watchdog Framework - Asynchronous Logging
+ * Log calls push binary records (level, format pointer, integer arguments)
+ * onto a lock-free MPSC ring. z_wdt_log_drain() formats them and hands the
+ * text to the platform sink, normally from the platform's log thread.
+ * Until the watchdog is initialized, and for FATAL messages, records are
+ * drained on the calling thread so nothing is lost.
+ */
+
+#include "z_wdt_internal.h"
+
+#define LOG_RING_SIZE (1u << WATCHDOG_LOG_RING_BITS)
+#define LOG_RING_MASK (LOG_RING_SIZE - 1)
+#define LOG_LINE_SIZE 256
+
+/*
+ * Ring slot. turn is 2 * round while the slot is free for that round's
+ * producer and 2 * round + 1 once the record is published; the consumer
+ * moves it to the next round. All-zero is the initial empty state.
+ */
+struct log_record {
+    uint64_t turn;
+    int level;
+    int argc;
+    const char *format;
+    int64_t args[WATCHDOG_LOG_MAX_ARGS];
+};
+
+static struct log_record g_log_ring[LOG_RING_SIZE];
+static uint64_t g_log_head;            // Next position to claim (producers)
+static uint64_t g_log_tail;            // Next position to read (drainer only)
+static uint32_t g_log_dropped;         // Records lost to a full ring
+static bool g_log_pending;             // Drainer already woken
+static bool g_log_draining;            // Someone is draining
+static bool g_log_async;               // Platform log thread is running
+
+static const char *const g_level_names[] = { "DEBUG", "INFO", "WARN", "ERROR", "FATAL" };
+
+// Append a string to the line buffer, truncating at the end
+static size_t log_put(char *line, size_t len, const char *text, size_t count) {
+    while (count-- > 0 && *text != '\0' && len < LOG_LINE_SIZE - 1) {
+        line[len++] = *text++;
+    }
+    return len;
+}
+
+// Append an integer in the given base
+static size_t log_put_number(char *line, size_t len, uint64_t value, bool negative, unsigned base) {
+    char digits[24];
+    int count = 0;
+
+    do {
+        digits[count++] = "0123456789abcdef"[value % base];
+        value /= base;
+    } while (value != 0);
+    if (negative) {
+        digits[count++] = '-';
+    }
+
+    while (count > 0 && len < LOG_LINE_SIZE - 1) {
+        line[len++] = digits[--count];
+    }
+    return len;
+}
+
+// Minimal printf: %d %i %u %x %s %% with optional l/ll/z length modifiers
+static void log_format(char *line, const char *format, const int64_t *args, int argc) {
+    size_t len = 0;
+    int arg = 0;
+
+    for (const char *p = format; *p != '\0' && len < LOG_LINE_SIZE - 1; p++) {
+        if (*p != '%') {
+            line[len++] = *p;
+            continue;
+        }
+
+        const char *spec = p++;
+        while (*p == 'l' || *p == 'z') {
+            p++;
+        }
+        if (*p == '%') {
+            line[len++] = '%';
+            continue;
+        }
+
+        int64_t value = arg < argc ? args[arg] : 0;
+        switch (*p) {
+        case 'd':
+        case 'i':
+            len = log_put_number(line, len, value < 0 ? 0 - (uint64_t)value : (uint64_t)value, value < 0, 10);
+            break;
+        case 'u':
+            len = log_put_number(line, len, (uint64_t)value, false, 10);
+            break;
+        case 'x':
+            len = log_put_number(line, len, (uint64_t)value, false, 16);
+            break;
+        case 's':
+            len = log_put(line, len, value ? (const char *)(intptr_t)value : "(null)", (size_t)-1);
+            break;
+        default:
+            // Unknown conversion: print it verbatim
+            len = log_put(line, len, spec, (size_t)(p - spec + (*p != '\0')));
+            if (*p == '\0') {
+                p--;
+            }
+            continue;
+        }
+        arg++;
+    }
+
+    line[len] = '\0';
+}
+
+// Whether the record at the drain position is published
+static bool log_ready(void) {
+    uint64_t tail = WATCHDOG_LOAD(&g_log_tail);
+    const struct log_record *record = &g_log_ring[tail & LOG_RING_MASK];
+    return WATCHDOG_LOAD_ACQUIRE(&record->turn) == ((tail >> WATCHDOG_LOG_RING_BITS) << 1) + 1;
+}
+
+// Queue a log record; safe from any thread, never blocks
+void watchdog_log_write(int level, const char *format, const int64_t *args, int argc) {
+    uint64_t pos = WATCHDOG_LOAD(&g_log_head);
+    struct log_record *record;
+    uint64_t turn;
+
+    for (;;) {
+        record = &g_log_ring[pos & LOG_RING_MASK];
+        turn = (pos >> WATCHDOG_LOG_RING_BITS) << 1;
+
+        uint64_t current = WATCHDOG_LOAD_ACQUIRE(&record->turn);
+        if (current == turn) {
+            if (WATCHDOG_CAS(&g_log_head, &pos, pos + 1)) {
+                break;
+            }
+        } else if ((int64_t)(current - turn) < 0) {
+            // The drainer hasn't freed this slot from the previous round
+            WATCHDOG_FETCH_ADD(&g_log_dropped, 1u);
+            return;
+        } else {
+            pos = WATCHDOG_LOAD(&g_log_head);
+        }
+    }
+
+    if (argc > WATCHDOG_LOG_MAX_ARGS) {
+        argc = WATCHDOG_LOG_MAX_ARGS;
+    }
+    record->level = level;
+    record->argc = argc;
+    record->format = format;
+    for (int i = 0; i < argc; i++) {
+        record->args[i] = args[i];
+    }
+    WATCHDOG_STORE_RELEASE(&record->turn, turn + 1);
+
+    if (!WATCHDOG_LOAD(&g_log_async) || level >= WATCHDOG_LEVEL_FATAL) {
+        z_wdt_log_drain();
+    } else if (!WATCHDOG_EXCHANGE(&g_log_pending, true)) {
+        watchdog_log_wake();
+    }
+}
+
+// Switch between the platform log thread and draining on the caller
+void watchdog_log_async(bool async) {
+    WATCHDOG_STORE(&g_log_async, async);
+    if (!async) {
+        z_wdt_log_drain();
+    }
+}
+
+// Format and emit every published record (called by the platform log thread)
+void z_wdt_log_drain(void) {
+    char line[LOG_LINE_SIZE];
+
+    (void)WATCHDOG_EXCHANGE(&g_log_pending, false);
+
+    do {
+        bool expected = false;
+        if (!WATCHDOG_CAS(&g_log_draining, &expected, true)) {
+            return;
+        }
+
+        uint32_t dropped = WATCHDOG_EXCHANGE(&g_log_dropped, 0u);
+        if (dropped != 0) {
+            watchdog_log("WARN", "Dropped %u log records", dropped);
+        }
+
+        while (log_ready()) {
+            struct log_record *record = &g_log_ring[g_log_tail & LOG_RING_MASK];
+            struct log_record copy = *record;
+
+            // Free the slot before the slow formatting and output
+            WATCHDOG_STORE_RELEASE(&record->turn, copy.turn + 1);
+            WATCHDOG_STORE(&g_log_tail, g_log_tail + 1);
+
+            log_format(line, copy.format, copy.args, copy.argc);
+            watchdog_log(g_level_names[copy.level], "%s", line);
+        }
+
+        WATCHDOG_STORE_RELEASE(&g_log_draining, false);
+
+        // A record published after the last check found the flag taken
+    } while (log_ready());
+}
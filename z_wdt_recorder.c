@@ -0,0 +1,304 @@
+/*
+ * Embedded Watchdog Framework - Flight Recorder
+ * Channel events (add, feed, delete, timeout) land in per-CPU rings of a
+ * fixed-size region with their tick and thread, and every timeout also
+ * copies the channel table into the region before any callback runs.
+ * The region is either allocated or a file mapped shared, which the
+ * timeout path flushes, so a hang that ends in a reset leaves the last
+ * events and the table on disk for z_wdt_recorder_open().
+ *
+ * Writers never take a lock; readers of a live recorder may see a record
+ * being overwritten. Records are complete once their writers are gone.
+ */
+
+#include "z_wdt_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef WATCHDOG_RECORDER_MAX
+#define WATCHDOG_RECORDER_MAX 1        // Regions and opened handles in static builds
+#endif
+
+#ifdef WATCHDOG_STATIC_CHANNELS
+static struct watchdog_recorder_region g_static_regions[WATCHDOG_RECORDER_MAX];
+static bool g_static_regions_used[WATCHDOG_RECORDER_MAX];
+static struct watchdog_recorder g_static_handles[WATCHDOG_RECORDER_MAX];
+#endif
+
+static struct watchdog_recorder_region *recorder_alloc(void) {
+#ifdef WATCHDOG_STATIC_CHANNELS
+    for (uint32_t i = 0; i < WATCHDOG_RECORDER_MAX; i++) {
+        if (!g_static_regions_used[i]) {
+            g_static_regions_used[i] = true;
+            return &g_static_regions[i];
+        }
+    }
+    return NULL;
+#else
+    return malloc(sizeof(struct watchdog_recorder_region));
+#endif
+}
+
+static void recorder_free(struct watchdog_recorder_region *region) {
+#ifdef WATCHDOG_STATIC_CHANNELS
+    g_static_regions_used[region - g_static_regions] = false;
+#else
+    free(region);
+#endif
+}
+
+// Whether a region was written by a build with this layout
+static bool recorder_valid(const struct watchdog_recorder_region *region, size_t size) {
+    return size >= sizeof(*region) && region->magic == WATCHDOG_RECORDER_MAGIC &&
+           region->version == WATCHDOG_RECORDER_VERSION && region->ring_bits == WATCHDOG_RECORDER_BITS &&
+           region->cpus == WATCHDOG_RECORDER_CPUS && region->snapshot_capacity == WATCHDOG_RECORDER_SNAPSHOT;
+}
+
+// Give a context its recorder, backed by the file at path or by memory
+int watchdog_recorder_init(struct watchdog_recorder *recorder, const char *path) {
+    struct watchdog_recorder_region *region;
+    size_t size = sizeof(*region);
+
+    if (path != NULL) {
+        region = watchdog_recorder_map(path, &size, true);
+        if (region == NULL) {
+            WATCHDOG_LOG_ERROR("Failed to map the flight recorder file");
+            return -1;
+        }
+    } else {
+        region = recorder_alloc();
+        if (region == NULL) {
+            WATCHDOG_LOG_ERROR("No memory for the flight recorder");
+            return -1;
+        }
+    }
+
+    // Whatever an earlier run left behind is overwritten
+    memset(region, 0, sizeof(*region));
+    region->version = WATCHDOG_RECORDER_VERSION;
+    region->ring_bits = WATCHDOG_RECORDER_BITS;
+    region->cpus = WATCHDOG_RECORDER_CPUS;
+    region->snapshot_capacity = WATCHDOG_RECORDER_SNAPSHOT;
+    region->tick_hz = WATCHDOG_TICK_HZ;
+    WATCHDOG_STORE_RELEASE(&region->magic, WATCHDOG_RECORDER_MAGIC);
+
+    recorder->region = region;
+    recorder->size = size;
+    recorder->mapped = path != NULL;
+    return 0;
+}
+
+// Drop a context's recorder; a file keeps its contents
+void watchdog_recorder_release(struct watchdog_recorder *recorder) {
+    if (recorder->region == NULL) {
+        return;
+    }
+
+    if (recorder->mapped) {
+        watchdog_recorder_sync(recorder->region, recorder->size);
+        watchdog_recorder_unmap(recorder->region, recorder->size);
+    } else {
+        recorder_free(recorder->region);
+    }
+    recorder->region = NULL;
+    recorder->size = 0;
+    recorder->mapped = false;
+}
+
+// Write a file-backed recorder through to its file
+void watchdog_recorder_flush(struct watchdog_recorder *recorder) {
+    if (recorder->region != NULL && recorder->mapped) {
+        watchdog_recorder_sync(recorder->region, recorder->size);
+    }
+}
+
+// Copy the active channels of every shard into the region, lock-free like
+// a feed, up to WATCHDOG_RECORDER_SNAPSHOT of them. Returns the number
+// copied, or -1 while another thread is taking a snapshot.
+int watchdog_recorder_snapshot(struct watchdog_context *ctx) {
+    struct watchdog_recorder_region *region = ctx->recorder.region;
+    uint32_t idle = 0;
+    if (region == NULL || !WATCHDOG_CAS(&region->snapshot_busy, &idle, 1)) {
+        return -1;
+    }
+
+    uint32_t count = 0;
+    uint32_t shard_count = WATCHDOG_LOAD(&ctx->shard_count);
+    for (uint32_t i = 0; i < shard_count && count < WATCHDOG_RECORDER_SNAPSHOT; i++) {
+        struct watchdog_shard *shard = &ctx->shards[i];
+        struct watchdog_table *table = &shard->table;
+        uint32_t words = WATCHDOG_BITMAP_WORDS(WATCHDOG_LOAD(&table->capacity));
+
+        for (uint32_t word = 0; word < words && count < WATCHDOG_RECORDER_SNAPSHOT; word++) {
+            for (uint64_t bits = WATCHDOG_LOAD(&table->active[word]); bits != 0; bits &= bits - 1) {
+                uint32_t index = word * 64 + (uint32_t)WATCHDOG_CTZ64(bits);
+                struct watchdog_channel *channel = watchdog_table_lookup(table, index);
+                uint32_t generation = channel != NULL ? WATCHDOG_LOAD_ACQUIRE(&channel->generation) : 0;
+                if (!WATCHDOG_GEN_ACTIVE(generation)) {
+                    continue;
+                }
+
+                z_wdt_channel_snapshot *entry = &region->snapshot[count];
+                entry->channel_id = watchdog_make_handle(shard->index, index, generation);
+                entry->reload_period = channel->reload_period;
+                entry->deadline = WATCHDOG_LOAD(WATCHDOG_DEADLINE(table, index));
+
+                // Keep the entry only if the slot wasn't reused while reading
+                if (WATCHDOG_LOAD_ACQUIRE(&channel->generation) == generation &&
+                    ++count == WATCHDOG_RECORDER_SNAPSHOT) {
+                    break;
+                }
+            }
+        }
+    }
+
+    WATCHDOG_STORE(&region->snapshot_count, count);
+    WATCHDOG_STORE(&region->snapshot_ticks, watchdog_get_ticks());
+    WATCHDOG_STORE_RELEASE(&region->snapshot_busy, 0);
+    return (int)count;
+}
+
+// Map the recorder file of this or an earlier run for reading
+z_wdt_recorder_t *z_wdt_recorder_open(const char *path) {
+    if (path == NULL) {
+        WATCHDOG_LOG_ERROR("Invalid flight recorder path");
+        return NULL;
+    }
+
+    struct watchdog_recorder *recorder = NULL;
+#ifdef WATCHDOG_STATIC_CHANNELS
+    for (uint32_t i = 0; i < WATCHDOG_RECORDER_MAX && recorder == NULL; i++) {
+        if (!g_static_handles[i].allocated) {
+            recorder = &g_static_handles[i];
+        }
+    }
+#else
+    recorder = malloc(sizeof(*recorder));
+#endif
+    if (recorder == NULL) {
+        WATCHDOG_LOG_ERROR("No free flight recorder handle");
+        return NULL;
+    }
+
+    size_t size = 0;
+    struct watchdog_recorder_region *region = watchdog_recorder_map(path, &size, false);
+    if (region == NULL || !recorder_valid(region, size)) {
+        WATCHDOG_LOG_ERROR("No flight recorder with this build's layout to open");
+        if (region != NULL) {
+            watchdog_recorder_unmap(region, size);
+        }
+#ifndef WATCHDOG_STATIC_CHANNELS
+        free(recorder);
+#endif
+        return NULL;
+    }
+
+    recorder->region = region;
+    recorder->size = size;
+    recorder->mapped = true;
+    recorder->allocated = true;
+    return recorder;
+}
+
+// Unmap a recorder from z_wdt_recorder_open(); a context's own is left alone
+void z_wdt_recorder_close(z_wdt_recorder_t *recorder) {
+    if (recorder == NULL || !recorder->allocated) {
+        return;
+    }
+
+    watchdog_recorder_unmap(recorder->region, recorder->size);
+    recorder->region = NULL;
+    recorder->allocated = false;
+#ifndef WATCHDOG_STATIC_CHANNELS
+    free(recorder);
+#endif
+}
+
+// Position of a ring's newest used record before *next, skipping records
+// that were taken but never filled; false once the ring is exhausted
+static bool recorder_newest(const struct watchdog_recorder_ring *ring, uint64_t *next, uint64_t first) {
+    while (*next > first) {
+        if (WATCHDOG_LOAD(&ring->records[(*next - 1) & WATCHDOG_RECORDER_MASK].info) != 0) {
+            return true;
+        }
+        (*next)--;
+    }
+    return false;
+}
+
+// Copy out up to max of the most recent events, oldest first, merging the
+// rings by tick. Returns the number copied.
+int z_wdt_recorder_events(z_wdt_recorder_t *recorder, z_wdt_event *events, size_t max) {
+    if (recorder == NULL || recorder->region == NULL || (events == NULL && max > 0)) {
+        return -1;
+    }
+
+    // Walk every ring back from its head, taking the latest record of any
+    // ring each time, and fill the output from its end
+    struct watchdog_recorder_region *region = recorder->region;
+    uint64_t next[WATCHDOG_RECORDER_CPUS];
+    uint64_t first[WATCHDOG_RECORDER_CPUS];
+    for (uint32_t cpu = 0; cpu < WATCHDOG_RECORDER_CPUS; cpu++) {
+        next[cpu] = WATCHDOG_LOAD(&region->rings[cpu].head);
+        first[cpu] = next[cpu] > WATCHDOG_RECORDER_SIZE ? next[cpu] - WATCHDOG_RECORDER_SIZE : 0;
+    }
+
+    size_t count = 0;
+    while (count < max) {
+        const struct watchdog_recorder_record *latest = NULL;
+        uint32_t latest_cpu = 0;
+        for (uint32_t cpu = 0; cpu < WATCHDOG_RECORDER_CPUS; cpu++) {
+            const struct watchdog_recorder_ring *ring = &region->rings[cpu];
+            if (!recorder_newest(ring, &next[cpu], first[cpu])) {
+                continue;
+            }
+            const struct watchdog_recorder_record *record = &ring->records[(next[cpu] - 1) & WATCHDOG_RECORDER_MASK];
+            if (latest == NULL || WATCHDOG_LOAD(&record->ticks) > WATCHDOG_LOAD(&latest->ticks)) {
+                latest = record;
+                latest_cpu = cpu;
+            }
+        }
+        if (latest == NULL) {
+            break;
+        }
+
+        uint64_t info = WATCHDOG_LOAD(&latest->info);
+        z_wdt_event *event = &events[max - 1 - count++];
+        event->ticks = WATCHDOG_LOAD(&latest->ticks);
+        event->channel_id = (int)(uint32_t)info;
+        event->thread = (uint32_t)(info >> 32) & 0x0FFFFFFFu;
+        event->cpu = latest_cpu;
+        event->type = (z_wdt_event_type)(info >> 60);
+        next[latest_cpu]--;
+    }
+
+    if (count > 0) {
+        memmove(events, events + (max - count), count * sizeof(*events));
+    }
+    return (int)count;
+}
+
+// Copy out the latest table snapshot (up to max channels) and when it was
+// taken; 0 channels and *ticks 0 if there was none
+int z_wdt_recorder_channels(z_wdt_recorder_t *recorder, z_wdt_channel_snapshot *channels, size_t max,
+                            int64_t *ticks) {
+    if (recorder == NULL || recorder->region == NULL || (channels == NULL && max > 0)) {
+        return -1;
+    }
+
+    struct watchdog_recorder_region *region = recorder->region;
+    uint32_t count = WATCHDOG_LOAD(&region->snapshot_count);
+    if (count > WATCHDOG_RECORDER_SNAPSHOT) {
+        count = WATCHDOG_RECORDER_SNAPSHOT;
+    }
+    if (count > max) {
+        count = (uint32_t)max;
+    }
+    if (count > 0) {
+        memcpy(channels, region->snapshot, count * sizeof(*channels));
+    }
+    if (ticks != NULL) {
+        *ticks = WATCHDOG_LOAD(&region->snapshot_ticks);
+    }
+    return (int)count;
+}
@@ -0,0 +1,191 @@
+/*
+ * Embedded Watchdog Framework - Deadline Scan Kernels
+ * Compare a block of up to 64 packed deadlines against the current time,
+ * producing the expired mask and the minimum deadline in one pass.
+ * Free slots hold INT64_MAX, so the kernels need no active bitmap.
+ *
+ * x86 kernels are built with per-function target attributes and picked
+ * at runtime, so one library runs on any x86-64 CPU. AArch64 always has
+ * NEON. Define WATCHDOG_SCAN_SCALAR to build the portable loop only.
+ *
+ * Vector loads race with lock-free feeders. Each aligned 64-bit lane is
+ * read whole. A feed that moves a deadline later can make a channel look
+ * expired early; watchdog_channel_expired() re-reads the deadline and
+ * re-queues it. An adaptive feed can also pull a deadline earlier, which
+ * the scan may miss: that case is caught by the feeder itself, which
+ * re-queues the channel through watchdog_feed_rearm().
+ */
+
+#include "z_wdt_internal.h"
+
+#if !defined(WATCHDOG_SCAN_SCALAR) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SCAN_X86 1
+#include <immintrin.h>
+#elif !defined(WATCHDOG_SCAN_SCALAR) && defined(__aarch64__)
+#define SCAN_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Portable kernel, also used for the tail of the vector kernels
+static int64_t scan_scalar(const int64_t *deadlines, uint32_t count, int64_t now, uint64_t *expired) {
+    int64_t next = INT64_MAX;
+    uint64_t mask = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        int64_t deadline = WATCHDOG_LOAD(&deadlines[i]);
+        if (deadline < next) {
+            next = deadline;
+        }
+        mask |= (uint64_t)(deadline <= now) << i;
+    }
+
+    *expired = mask;
+    return next;
+}
+
+#if defined(SCAN_X86) || defined(SCAN_NEON)
+
+// Finish a vector kernel: fold in the slots past the last full vector
+static int64_t scan_tail(const int64_t *deadlines, uint32_t done, uint32_t count, int64_t now,
+                         uint64_t mask, int64_t next, uint64_t *expired) {
+    if (done < count) {
+        uint64_t tail_mask;
+        int64_t tail = scan_scalar(&deadlines[done], count - done, now, &tail_mask);
+        mask |= tail_mask << done;
+        if (tail < next) {
+            next = tail;
+        }
+    }
+
+    *expired = mask;
+    return next;
+}
+
+#endif
+
+#ifdef SCAN_X86
+
+// Two deadlines per compare (pcmpgtq is SSE4.2)
+__attribute__((target("sse4.2")))
+static int64_t scan_sse42(const int64_t *deadlines, uint32_t count, int64_t now, uint64_t *expired) {
+    const __m128i now_v = _mm_set1_epi64x(now);
+    __m128i min_v = _mm_set1_epi64x(INT64_MAX);
+    uint64_t mask = 0;
+    uint32_t i = 0;
+
+    for (; i + 2 <= count; i += 2) {
+        __m128i v = _mm_loadu_si128((const __m128i *)&deadlines[i]);
+        __m128i later = _mm_cmpgt_epi64(v, now_v);
+        mask |= (uint64_t)(~_mm_movemask_pd(_mm_castsi128_pd(later)) & 0x3) << i;
+        min_v = _mm_blendv_epi8(min_v, v, _mm_cmpgt_epi64(min_v, v));
+    }
+
+    int64_t lanes[2];
+    _mm_storeu_si128((__m128i *)lanes, min_v);
+    int64_t next = lanes[0] < lanes[1] ? lanes[0] : lanes[1];
+
+    return scan_tail(deadlines, i, count, now, mask, next, expired);
+}
+
+// Eight deadlines per iteration as two four-lane compares
+__attribute__((target("avx2")))
+static int64_t scan_avx2(const int64_t *deadlines, uint32_t count, int64_t now, uint64_t *expired) {
+    const __m256i now_v = _mm256_set1_epi64x(now);
+    __m256i min_a = _mm256_set1_epi64x(INT64_MAX);
+    __m256i min_b = min_a;
+    uint64_t mask = 0;
+    uint32_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)&deadlines[i]);
+        __m256i b = _mm256_loadu_si256((const __m256i *)&deadlines[i + 4]);
+        int later = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(a, now_v))) |
+                    (_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(b, now_v))) << 4);
+        mask |= (uint64_t)(~later & 0xFF) << i;
+        min_a = _mm256_blendv_epi8(min_a, a, _mm256_cmpgt_epi64(min_a, a));
+        min_b = _mm256_blendv_epi8(min_b, b, _mm256_cmpgt_epi64(min_b, b));
+    }
+
+    min_a = _mm256_blendv_epi8(min_a, min_b, _mm256_cmpgt_epi64(min_a, min_b));
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, min_a);
+    int64_t next = lanes[0];
+    for (int lane = 1; lane < 4; lane++) {
+        if (lanes[lane] < next) {
+            next = lanes[lane];
+        }
+    }
+
+    return scan_tail(deadlines, i, count, now, mask, next, expired);
+}
+
+#endif // SCAN_X86
+
+#ifdef SCAN_NEON
+
+// Four deadlines per iteration as two two-lane compares
+static int64_t scan_neon(const int64_t *deadlines, uint32_t count, int64_t now, uint64_t *expired) {
+    const int64x2_t now_v = vdupq_n_s64(now);
+    int64x2_t min_a = vdupq_n_s64(INT64_MAX);
+    int64x2_t min_b = min_a;
+    uint64_t mask = 0;
+    uint32_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        int64x2_t a = vld1q_s64(&deadlines[i]);
+        int64x2_t b = vld1q_s64(&deadlines[i + 2]);
+        uint64x2_t due_a = vcleq_s64(a, now_v);
+        uint64x2_t due_b = vcleq_s64(b, now_v);
+        uint64_t due = (vgetq_lane_u64(due_a, 0) & 1) | (vgetq_lane_u64(due_a, 1) & 2) |
+                       (vgetq_lane_u64(due_b, 0) & 4) | (vgetq_lane_u64(due_b, 1) & 8);
+        mask |= due << i;
+        min_a = vbslq_s64(vcltq_s64(a, min_a), a, min_a);
+        min_b = vbslq_s64(vcltq_s64(b, min_b), b, min_b);
+    }
+
+    min_a = vbslq_s64(vcltq_s64(min_b, min_a), min_b, min_a);
+    int64_t next = vgetq_lane_s64(min_a, 0);
+    if (vgetq_lane_s64(min_a, 1) < next) {
+        next = vgetq_lane_s64(min_a, 1);
+    }
+
+    return scan_tail(deadlines, i, count, now, mask, next, expired);
+}
+
+#endif // SCAN_NEON
+
+// The index-th kernel the running CPU supports, widest first and the
+// scalar loop last; NULL past the end
+watchdog_scan_fn watchdog_scan_kernel(uint32_t index, const char **name) {
+#if defined(SCAN_X86)
+    __builtin_cpu_init();
+    bool avx2 = __builtin_cpu_supports("avx2");
+    bool sse42 = __builtin_cpu_supports("sse4.2");
+#endif
+    const struct {
+        const char *name;
+        watchdog_scan_fn scan;
+        bool supported;
+    } kernels[] = {
+#if defined(SCAN_X86)
+        { "avx2", scan_avx2, avx2 },
+        { "sse4.2", scan_sse42, sse42 },
+#elif defined(SCAN_NEON)
+        { "neon", scan_neon, true },
+#endif
+        { "scalar", scan_scalar, true },
+    };
+
+    for (uint32_t i = 0; i < sizeof(kernels) / sizeof(kernels[0]); i++) {
+        if (kernels[i].supported && index-- == 0) {
+            *name = kernels[i].name;
+            return kernels[i].scan;
+        }
+    }
+    return NULL;
+}
+
+// Pick the widest kernel the running CPU supports
+watchdog_scan_fn watchdog_scan_select(const char **name) {
+    return watchdog_scan_kernel(0, name);
+}
@@ -0,0 +1,135 @@
+/*
+ * Embedded Watchdog Framework - Array Scheduler Backend
+ * Linear scans over the channel table; smallest footprint, O(n) per query.
+ * The scans read the live timeouts, so feeds are always seen exactly, and
+ * run the SIMD kernels from z_wdt_scan.c over each 64-slot block of packed
+ * deadlines, skipping empty blocks via the active bitmap. Escalating
+ * channels are due before their deadline, so a second bitmap marks them
+ * and blocks holding any are scanned slot by slot on their sched_key.
+ */
+
+#include "z_wdt_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if WATCHDOG_SCHEDULER == WATCHDOG_SCHED_ARRAY
+
+void watchdog_sched_reset(struct watchdog_shard *shard) {
+    const char *kernel;
+    shard->scan = watchdog_scan_select(&kernel);
+#ifdef WATCHDOG_STATIC_CHANNELS
+    shard->escalating = shard->static_escalating;
+    memset(shard->static_escalating, 0, sizeof(shard->static_escalating));
+#endif
+    WATCHDOG_LOG_INFO("Array scheduler using %s deadline scan", (intptr_t)kernel);
+}
+
+// Size the escalating bitmap for capacity slots (called before the table grows)
+int watchdog_sched_reserve(struct watchdog_shard *shard, uint32_t capacity) {
+#ifdef WATCHDOG_STATIC_CHANNELS
+    (void)shard;
+    (void)capacity;
+#else
+    uint32_t words = WATCHDOG_BITMAP_WORDS(capacity);
+    uint32_t old_words = shard->escalating != NULL ? WATCHDOG_BITMAP_WORDS(shard->table.capacity) : 0;
+    uint64_t *escalating = realloc(shard->escalating, words * sizeof(*escalating));
+    if (escalating == NULL) {
+        return -1;
+    }
+    memset(escalating + old_words, 0, (words - old_words) * sizeof(*escalating));
+    shard->escalating = escalating;
+#endif
+    return 0;
+}
+
+void watchdog_sched_release(struct watchdog_shard *shard) {
+#ifndef WATCHDOG_STATIC_CHANNELS
+    free(shard->escalating);
+#endif
+    shard->escalating = NULL;
+}
+
+// Active slots are the queue: the table bitmap tracks membership and
+// every active slot is armed at its live deadline, unless it escalates
+void watchdog_sched_insert(struct watchdog_shard *shard, int channel_id) {
+    watchdog_sched_update(shard, channel_id);
+}
+
+void watchdog_sched_remove(struct watchdog_shard *shard, int channel_id) {
+    shard->escalating[(uint32_t)channel_id / 64] &= ~((uint64_t)1 << ((uint32_t)channel_id % 64));
+}
+
+void watchdog_sched_update(struct watchdog_shard *shard, int channel_id) {
+    if (WATCHDOG_CHANNEL(shard, channel_id)->escalation != NULL) {
+        shard->escalating[(uint32_t)channel_id / 64] |= (uint64_t)1 << ((uint32_t)channel_id % 64);
+    }
+}
+
+// Deadlines in the table's 64-slot block starting at word * 64
+static uint32_t array_block_size(const struct watchdog_table *table, uint32_t word) {
+    uint32_t count = table->capacity - word * 64;
+    return count < 64 ? count : 64;
+}
+
+int64_t watchdog_sched_next(struct watchdog_shard *shard) {
+    const struct watchdog_table *table = &shard->table;
+    int64_t next_timeout = INT64_MAX;
+    uint64_t expired;
+
+    for (uint32_t word = 0; word < WATCHDOG_BITMAP_WORDS(table->capacity); word++) {
+        if (table->active[word] == 0) {
+            continue;
+        }
+
+        // 64 slots never straddle a chunk, so the deadlines are contiguous
+        uint64_t escalating = shard->escalating[word];
+        if (escalating == 0) {
+            int64_t timeout = shard->scan(WATCHDOG_DEADLINE(table, word * 64), array_block_size(table, word),
+                                          INT64_MIN, &expired);
+            next_timeout = timeout < next_timeout ? timeout : next_timeout;
+            continue;
+        }
+
+        for (uint32_t i = 0; i < array_block_size(table, word); i++) {
+            uint32_t slot = word * 64 + i;
+            int64_t timeout = (escalating >> i & 1) ? WATCHDOG_SLOT(table, slot)->sched_key :
+                                                      WATCHDOG_LOAD(WATCHDOG_DEADLINE(table, slot));
+            next_timeout = timeout < next_timeout ? timeout : next_timeout;
+        }
+    }
+
+    return next_timeout;
+}
+
+void watchdog_sched_expire(struct watchdog_shard *shard, int64_t now, watchdog_expire_fn fn) {
+    const struct watchdog_table *table = &shard->table;
+    uint64_t expired;
+
+    for (uint32_t word = 0; word < WATCHDOG_BITMAP_WORDS(table->capacity); word++) {
+        if (table->active[word] == 0) {
+            continue;
+        }
+
+        // Free slots hold INT64_MAX and never show up in the mask. A group
+        // timeout in fn() retires its members, which may sit at later bits
+        // of this mask; fn() still sees them, but watchdog_channel_expired()
+        // re-reads their (now INT64_MAX) deadline and only re-queues them.
+        uint64_t escalating = shard->escalating[word];
+        shard->scan(WATCHDOG_DEADLINE(table, word * 64), array_block_size(table, word), now, &expired);
+        for (expired &= ~escalating; expired != 0; expired &= expired - 1) {
+            fn(shard, (int)(word * 64 + (uint32_t)WATCHDOG_CTZ64(expired)));
+        }
+
+        // Escalating slots are dequeued before fn(), which re-queues them
+        // at their next stage unless they timed out
+        for (; escalating != 0; escalating &= escalating - 1) {
+            int slot = (int)(word * 64 + (uint32_t)WATCHDOG_CTZ64(escalating));
+            if (WATCHDOG_SLOT(table, slot)->sched_key <= now) {
+                watchdog_sched_remove(shard, slot);
+                fn(shard, slot);
+            }
+        }
+    }
+}
+
+#endif // WATCHDOG_SCHEDULER == WATCHDOG_SCHED_ARRAY
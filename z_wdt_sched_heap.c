@@ -0,0 +1,191 @@
+/*
+ * Embedded Watchdog Framework - Min-Heap Scheduler Backend
+ * Indexed binary heap keyed on sched_key: add/delete/re-queue are
+ * O(log n), peeking the next expiry is O(1)
+ */
+
+#include "z_wdt_internal.h"
+#include <stdlib.h>
+
+/* Heap index helpers */
+#define HEAP_PARENT(i) (((i) - 1) / 2)
+#define HEAP_LEFT(i)   (2 * (i) + 1)
+
+// Place a node at position pos and record the position in its channel
+static void heap_set(struct watchdog_heap *heap, struct watchdog_table *table,
+                     int pos, struct watchdog_heap_node node) {
+    heap->nodes[pos] = node;
+    WATCHDOG_SLOT(table, node.channel_id)->sched_pos = pos;
+}
+
+// Move the node at pos towards the root until the heap property holds
+static void heap_sift_up(struct watchdog_heap *heap, struct watchdog_table *table, int pos) {
+    struct watchdog_heap_node node = heap->nodes[pos];
+
+    while (pos > 0) {
+        int parent = HEAP_PARENT(pos);
+        if (heap->nodes[parent].key <= node.key) {
+            break;
+        }
+        heap_set(heap, table, pos, heap->nodes[parent]);
+        pos = parent;
+    }
+
+    heap_set(heap, table, pos, node);
+}
+
+// Move the node at pos towards the leaves until the heap property holds
+static void heap_sift_down(struct watchdog_heap *heap, struct watchdog_table *table, int pos) {
+    struct watchdog_heap_node node = heap->nodes[pos];
+
+    for (;;) {
+        int child = HEAP_LEFT(pos);
+        if (child >= heap->size) {
+            break;
+        }
+        if (child + 1 < heap->size && heap->nodes[child + 1].key < heap->nodes[child].key) {
+            child++;
+        }
+        if (node.key <= heap->nodes[child].key) {
+            break;
+        }
+        heap_set(heap, table, pos, heap->nodes[child]);
+        pos = child;
+    }
+
+    heap_set(heap, table, pos, node);
+}
+
+// Initialize an empty heap without storage
+void watchdog_heap_init(struct watchdog_heap *heap) {
+    heap->nodes = NULL;
+    heap->size = 0;
+    heap->capacity = 0;
+}
+
+// Make room for at least capacity nodes
+int watchdog_heap_reserve(struct watchdog_heap *heap, uint32_t capacity) {
+    if (capacity <= (uint32_t)heap->capacity) {
+        return 0;
+    }
+
+    struct watchdog_heap_node *nodes = realloc(heap->nodes, capacity * sizeof(*nodes));
+    if (nodes == NULL) {
+        return -1;
+    }
+    heap->nodes = nodes;
+    heap->capacity = (int)capacity;
+    return 0;
+}
+
+// Free the heap storage
+void watchdog_heap_release(struct watchdog_heap *heap) {
+    free(heap->nodes);
+    watchdog_heap_init(heap);
+}
+
+// Insert a channel keyed on its sched_key
+void watchdog_heap_push(struct watchdog_heap *heap, struct watchdog_table *table, int channel_id) {
+    struct watchdog_heap_node node;
+    node.key = WATCHDOG_SLOT(table, channel_id)->sched_key;
+    node.channel_id = channel_id;
+
+    heap->nodes[heap->size] = node;
+    heap_sift_up(heap, table, heap->size++);
+}
+
+// Remove a channel from anywhere in the heap
+void watchdog_heap_erase(struct watchdog_heap *heap, struct watchdog_table *table, int channel_id) {
+    int pos = WATCHDOG_SLOT(table, channel_id)->sched_pos;
+    if (pos < 0) {
+        return;
+    }
+
+    WATCHDOG_SLOT(table, channel_id)->sched_pos = -1;
+    if (--heap->size == pos) {
+        return;
+    }
+
+    // Fill the hole with the last node and restore order in either direction
+    heap_set(heap, table, pos, heap->nodes[heap->size]);
+    if (pos > 0 && heap->nodes[pos].key < heap->nodes[HEAP_PARENT(pos)].key) {
+        heap_sift_up(heap, table, pos);
+    } else {
+        heap_sift_down(heap, table, pos);
+    }
+}
+
+// Re-key a queued channel after its sched_key moved (decrease or increase-key)
+void watchdog_heap_rekey(struct watchdog_heap *heap, struct watchdog_table *table, int channel_id) {
+    int pos = WATCHDOG_SLOT(table, channel_id)->sched_pos;
+    if (pos < 0) {
+        watchdog_heap_push(heap, table, channel_id);
+        return;
+    }
+
+    int64_t old_key = heap->nodes[pos].key;
+    heap->nodes[pos].key = WATCHDOG_SLOT(table, channel_id)->sched_key;
+
+    if (heap->nodes[pos].key < old_key) {
+        heap_sift_up(heap, table, pos);
+    } else {
+        heap_sift_down(heap, table, pos);
+    }
+}
+
+// Remove and return the channel with the earliest timeout (-1 if empty)
+int watchdog_heap_pop(struct watchdog_heap *heap, struct watchdog_table *table) {
+    if (heap->size == 0) {
+        return -1;
+    }
+
+    int channel_id = heap->nodes[0].channel_id;
+    watchdog_heap_erase(heap, table, channel_id);
+    return channel_id;
+}
+
+#if WATCHDOG_SCHEDULER == WATCHDOG_SCHED_HEAP
+
+void watchdog_sched_reset(struct watchdog_shard *shard) {
+    watchdog_heap_init(&shard->heap);
+#ifdef WATCHDOG_STATIC_CHANNELS
+    shard->heap.nodes = shard->heap.static_nodes;
+    shard->heap.capacity = WATCHDOG_MAX_CHANNELS;
+#endif
+}
+
+int watchdog_sched_reserve(struct watchdog_shard *shard, uint32_t capacity) {
+    return watchdog_heap_reserve(&shard->heap, capacity);
+}
+
+void watchdog_sched_release(struct watchdog_shard *shard) {
+#ifdef WATCHDOG_STATIC_CHANNELS
+    shard->heap.size = 0;
+#else
+    watchdog_heap_release(&shard->heap);
+#endif
+}
+
+void watchdog_sched_insert(struct watchdog_shard *shard, int channel_id) {
+    watchdog_heap_push(&shard->heap, &shard->table, channel_id);
+}
+
+void watchdog_sched_remove(struct watchdog_shard *shard, int channel_id) {
+    watchdog_heap_erase(&shard->heap, &shard->table, channel_id);
+}
+
+void watchdog_sched_update(struct watchdog_shard *shard, int channel_id) {
+    watchdog_heap_rekey(&shard->heap, &shard->table, channel_id);
+}
+
+int64_t watchdog_sched_next(struct watchdog_shard *shard) {
+    return shard->heap.size > 0 ? shard->heap.nodes[0].key : INT64_MAX;
+}
+
+void watchdog_sched_expire(struct watchdog_shard *shard, int64_t now, watchdog_expire_fn fn) {
+    while (shard->heap.size > 0 && shard->heap.nodes[0].key <= now) {
+        fn(shard, watchdog_heap_pop(&shard->heap, &shard->table));
+    }
+}
+
+#endif // WATCHDOG_SCHEDULER == WATCHDOG_SCHED_HEAP
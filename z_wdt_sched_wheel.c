@@ -0,0 +1,219 @@
+/*
+ * Embedded Watchdog Framework - Hierarchical Timing Wheel Scheduler Backend
+ * O(1) add/delete/re-queue; z_wdt_process() expires a whole slot per wheel tick.
+ * Level 0 has one slot per WATCHDOG_WHEEL_RESOLUTION ticks, every higher
+ * level is 64 times coarser and cascades into the level below when reached.
+ */
+
+#include "z_wdt_internal.h"
+
+#if WATCHDOG_SCHEDULER == WATCHDOG_SCHED_WHEEL
+
+#define WHEEL_MASK  ((uint64_t)WATCHDOG_WHEEL_SIZE - 1)
+#define WHEEL_SPAN  ((int64_t)1 << (WATCHDOG_WHEEL_BITS * WATCHDOG_WHEEL_LEVELS))
+
+// Wheel tick at which a timeout may fire (rounded up, never early)
+static int64_t wheel_tick_of(int64_t timeout_ticks) {
+    return (timeout_ticks + WATCHDOG_WHEEL_RESOLUTION - 1) / WATCHDOG_WHEEL_RESOLUTION;
+}
+
+static bool wheel_empty(const struct watchdog_wheel *wheel) {
+    for (int level = 0; level < WATCHDOG_WHEEL_LEVELS; level++) {
+        if (wheel->occupied[level]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Link a channel into the slot covering wheel tick `tick`
+static void wheel_link(struct watchdog_shard *shard, int channel_id, int64_t tick) {
+    struct watchdog_wheel *wheel = &shard->wheel;
+    struct watchdog_channel *channel = WATCHDOG_CHANNEL(shard, channel_id);
+
+    // Past-due ticks go into the next slot to be processed, far ones are
+    // clamped to the wheel span and re-linked when they reach level 0
+    if (tick < wheel->now_tick) {
+        tick = wheel->now_tick;
+    } else if (tick - wheel->now_tick >= WHEEL_SPAN) {
+        tick = wheel->now_tick + WHEEL_SPAN - 1;
+    }
+
+    uint64_t delta = (uint64_t)(tick - wheel->now_tick);
+    int level = 0;
+    while (level < WATCHDOG_WHEEL_LEVELS - 1 &&
+           (delta >> (WATCHDOG_WHEEL_BITS * (level + 1))) != 0) {
+        level++;
+    }
+    int slot = (int)(((uint64_t)tick >> (WATCHDOG_WHEEL_BITS * level)) & WHEEL_MASK);
+
+    int head = wheel->slots[level][slot];
+    channel->sched_pos = level * WATCHDOG_WHEEL_SIZE + slot;
+    channel->sched_prev = -1;
+    channel->sched_next = head;
+    if (head >= 0) {
+        WATCHDOG_CHANNEL(shard, head)->sched_prev = channel_id;
+    }
+    wheel->slots[level][slot] = channel_id;
+    wheel->occupied[level] |= (uint64_t)1 << slot;
+}
+
+// Unlink a channel from whatever slot it is in
+static void wheel_unlink(struct watchdog_shard *shard, int channel_id) {
+    struct watchdog_wheel *wheel = &shard->wheel;
+    struct watchdog_channel *channel = WATCHDOG_CHANNEL(shard, channel_id);
+
+    if (channel->sched_pos < 0) {
+        return;
+    }
+
+    int level = channel->sched_pos / WATCHDOG_WHEEL_SIZE;
+    int slot = channel->sched_pos % WATCHDOG_WHEEL_SIZE;
+
+    if (channel->sched_prev >= 0) {
+        WATCHDOG_CHANNEL(shard, channel->sched_prev)->sched_next = channel->sched_next;
+    } else {
+        wheel->slots[level][slot] = channel->sched_next;
+        if (channel->sched_next < 0) {
+            wheel->occupied[level] &= ~((uint64_t)1 << slot);
+        }
+    }
+    if (channel->sched_next >= 0) {
+        WATCHDOG_CHANNEL(shard, channel->sched_next)->sched_prev = channel->sched_prev;
+    }
+
+    channel->sched_pos = -1;
+}
+
+// Detach a whole slot list and return its head
+static int wheel_take_slot(struct watchdog_wheel *wheel, int level, int slot) {
+    int head = wheel->slots[level][slot];
+    wheel->slots[level][slot] = -1;
+    wheel->occupied[level] &= ~((uint64_t)1 << slot);
+    return head;
+}
+
+// Earliest wheel tick at which a slot expires or cascades (INT64_MAX if empty)
+static int64_t wheel_next_event(const struct watchdog_wheel *wheel) {
+    int64_t next = INT64_MAX;
+
+    for (int level = 0; level < WATCHDOG_WHEEL_LEVELS; level++) {
+        uint64_t occupied = wheel->occupied[level];
+        if (!occupied) {
+            continue;
+        }
+
+        // First slot boundary of this level at or after now_tick
+        int shift = WATCHDOG_WHEEL_BITS * level;
+        int64_t base = (wheel->now_tick + ((int64_t)1 << shift) - 1) >> shift;
+        int rotate = (int)((uint64_t)base & WHEEL_MASK);
+        uint64_t rotated = rotate ? (occupied >> rotate) | (occupied << (WATCHDOG_WHEEL_SIZE - rotate))
+                                  : occupied;
+        int64_t tick = (base + WATCHDOG_CTZ64(rotated)) << shift;
+
+        if (tick < next) {
+            next = tick;
+        }
+    }
+
+    return next;
+}
+
+void watchdog_sched_reset(struct watchdog_shard *shard) {
+    struct watchdog_wheel *wheel = &shard->wheel;
+
+    for (int level = 0; level < WATCHDOG_WHEEL_LEVELS; level++) {
+        for (int slot = 0; slot < WATCHDOG_WHEEL_SIZE; slot++) {
+            wheel->slots[level][slot] = -1;
+        }
+        wheel->occupied[level] = 0;
+    }
+    wheel->now_tick = shard->current_ticks / WATCHDOG_WHEEL_RESOLUTION;
+}
+
+int watchdog_sched_reserve(struct watchdog_shard *shard, uint32_t capacity) {
+    (void)shard;
+    (void)capacity;
+    return 0;
+}
+
+void watchdog_sched_release(struct watchdog_shard *shard) {
+    watchdog_sched_reset(shard);
+}
+
+void watchdog_sched_insert(struct watchdog_shard *shard, int channel_id) {
+    // An idle wheel may lag far behind; catch up so the slot math stays short
+    if (wheel_empty(&shard->wheel)) {
+        int64_t now_tick = shard->current_ticks / WATCHDOG_WHEEL_RESOLUTION;
+        if (now_tick > shard->wheel.now_tick) {
+            shard->wheel.now_tick = now_tick;
+        }
+    }
+
+    wheel_link(shard, channel_id, wheel_tick_of(WATCHDOG_CHANNEL(shard, channel_id)->sched_key));
+}
+
+void watchdog_sched_remove(struct watchdog_shard *shard, int channel_id) {
+    wheel_unlink(shard, channel_id);
+}
+
+void watchdog_sched_update(struct watchdog_shard *shard, int channel_id) {
+    wheel_unlink(shard, channel_id);
+    watchdog_sched_insert(shard, channel_id);
+}
+
+int64_t watchdog_sched_next(struct watchdog_shard *shard) {
+    int64_t tick = wheel_next_event(&shard->wheel);
+    return tick == INT64_MAX ? INT64_MAX : tick * WATCHDOG_WHEEL_RESOLUTION;
+}
+
+void watchdog_sched_expire(struct watchdog_shard *shard, int64_t now, watchdog_expire_fn fn) {
+    struct watchdog_wheel *wheel = &shard->wheel;
+    int64_t target = now / WATCHDOG_WHEEL_RESOLUTION;
+
+    for (;;) {
+        // Jump straight to the next tick with work; nothing happens in between
+        int64_t tick = wheel_next_event(wheel);
+        if (tick > target) {
+            if (target + 1 > wheel->now_tick) {
+                wheel->now_tick = target + 1;
+            }
+            break;
+        }
+        wheel->now_tick = tick;
+
+        // At a level boundary, redistribute the higher level slot into lower ones
+        for (int level = 1; level < WATCHDOG_WHEEL_LEVELS; level++) {
+            int shift = WATCHDOG_WHEEL_BITS * level;
+            if ((uint64_t)tick & (((uint64_t)1 << shift) - 1)) {
+                break;
+            }
+            int slot = (int)(((uint64_t)tick >> shift) & WHEEL_MASK);
+            int id = wheel_take_slot(wheel, level, slot);
+            while (id >= 0) {
+                int next = WATCHDOG_CHANNEL(shard, id)->sched_next;
+                wheel_link(shard, id, wheel_tick_of(WATCHDOG_CHANNEL(shard, id)->sched_key));
+                id = next;
+            }
+        }
+
+        // Expire the whole level 0 slot in one pass
+        int id = wheel_take_slot(wheel, 0, (int)((uint64_t)tick & WHEEL_MASK));
+        wheel->now_tick = tick + 1;
+        while (id >= 0) {
+            struct watchdog_channel *channel = WATCHDOG_CHANNEL(shard, id);
+            int next = channel->sched_next;
+
+            channel->sched_pos = -1;
+            if (channel->sched_key <= now) {
+                fn(shard, id);
+            } else {
+                // Clamped beyond the wheel span; put it back at its real tick
+                wheel_link(shard, id, wheel_tick_of(channel->sched_key));
+            }
+            id = next;
+        }
+    }
+}
+
+#endif // WATCHDOG_SCHEDULER == WATCHDOG_SCHED_WHEEL
@@ -0,0 +1,394 @@
+/*
+ * Embedded Watchdog Framework - Shared-Memory Supervision
+ * Worker processes claim slots in a named shared region and feed them
+ * with one compare-and-swap on their own deadline, no syscall and no lock.
+ * A single supervisor process scans the packed deadlines with the array
+ * backend's kernels, checks that slot owners are still alive and runs the
+ * callbacks, so N processes need one deadline loop instead of N timer
+ * threads.
+ *
+ * Slot life cycle, all lock-free: a claim moves the generation from even
+ * to odd, fills in the slot and publishes the first deadline with a
+ * release store; until then the deadline is INT64_MAX and the supervisor
+ * skips the slot. Delete and retirement move the generation back to even
+ * and then park the deadline at INT64_MAX, which feeds (only ever moving a
+ * deadline later) cannot undo; a slot is reclaimed only once parked.
+ */
+
+#include "z_wdt_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef WATCHDOG_SHM_MAX_HANDLES
+#define WATCHDOG_SHM_MAX_HANDLES 4     // Handles in static builds
+#endif
+
+/* Process-local view of a region */
+struct watchdog_shm {
+    struct watchdog_shm_region *region;
+    size_t size;                       // Mapped bytes
+    char name[Z_WDT_SHM_NAME_MAX];     // Region name, unlinked by the supervisor on close
+    bool supervisor;                   // Created the region: processes it and runs the callbacks
+    z_wdt_shm_callback_t callback;
+    void *user_data;
+    watchdog_scan_fn scan;             // Deadline scan kernel picked at create
+    uint32_t wake_seen;                // Add counter at the start of the last pass
+    int64_t next_wakeup;               // Earliest deadline or liveness check after the last pass (ns)
+    int64_t liveness_due;              // Next check of the slot owners (ns)
+    bool allocated;                    // In use (static pool)
+};
+
+#ifdef WATCHDOG_STATIC_CHANNELS
+static struct watchdog_shm g_static_shms[WATCHDOG_SHM_MAX_HANDLES];
+#endif
+
+// Deadline lanes: the slot count rounded up to whole scan blocks
+static uint32_t shm_lanes(uint32_t slots) {
+    return WATCHDOG_BITMAP_WORDS(slots) * 64;
+}
+
+static size_t shm_size(uint32_t slots) {
+    return sizeof(struct watchdog_shm_region) + (size_t)shm_lanes(slots) * sizeof(int64_t) +
+           (size_t)slots * sizeof(struct watchdog_shm_slot);
+}
+
+static struct watchdog_shm_slot *shm_slot(struct watchdog_shm_region *region, uint32_t index) {
+    return &((struct watchdog_shm_slot *)&region->deadlines[shm_lanes(region->slots)])[index];
+}
+
+static int64_t shm_now(void) {
+    return (int64_t)watchdog_get_ns();
+}
+
+static struct watchdog_shm *shm_alloc(void) {
+#ifdef WATCHDOG_STATIC_CHANNELS
+    for (uint32_t i = 0; i < WATCHDOG_SHM_MAX_HANDLES; i++) {
+        if (!g_static_shms[i].allocated) {
+            memset(&g_static_shms[i], 0, sizeof(g_static_shms[i]));
+            g_static_shms[i].allocated = true;
+            return &g_static_shms[i];
+        }
+    }
+    return NULL;
+#else
+    struct watchdog_shm *shm = calloc(1, sizeof(*shm));
+    if (shm != NULL) {
+        shm->allocated = true;
+    }
+    return shm;
+#endif
+}
+
+static void shm_free(struct watchdog_shm *shm) {
+#ifdef WATCHDOG_STATIC_CHANNELS
+    shm->allocated = false;
+#else
+    free(shm);
+#endif
+}
+
+// Slot of a handle in its current generation, NULL if the handle is stale
+static struct watchdog_shm_slot *shm_resolve(struct watchdog_shm *shm, int channel_id, uint32_t *generation) {
+    if (shm == NULL || channel_id < 0 || watchdog_handle_shard(channel_id) != 0) {
+        return NULL;
+    }
+    uint32_t index = (uint32_t)channel_id & WATCHDOG_INDEX_MASK;
+    if (index >= shm->region->slots) {
+        return NULL;
+    }
+
+    struct watchdog_shm_slot *slot = shm_slot(shm->region, index);
+    *generation = WATCHDOG_LOAD_ACQUIRE(&slot->generation);
+    return watchdog_handle_matches(channel_id, *generation) ? slot : NULL;
+}
+
+// Create and initialize a region; the caller becomes its supervisor
+z_wdt_shm_t *z_wdt_shm_create(const char *name, uint32_t slots, z_wdt_shm_callback_t callback, void *user_data) {
+    if (name == NULL || strlen(name) >= Z_WDT_SHM_NAME_MAX || slots == 0 || slots > WATCHDOG_TABLE_LIMIT ||
+        callback == NULL) {
+        WATCHDOG_LOG_ERROR("Invalid shared-memory region parameters");
+        return NULL;
+    }
+
+    struct watchdog_shm *shm = shm_alloc();
+    if (shm == NULL) {
+        WATCHDOG_LOG_ERROR("No free shared-memory handle");
+        return NULL;
+    }
+    shm->size = shm_size(slots);
+    struct watchdog_shm_region *region = watchdog_shm_map(name, &shm->size, true);
+    if (region == NULL) {
+        WATCHDOG_LOG_ERROR("Failed to create a shared-memory region of %u slots", slots);
+        shm_free(shm);
+        return NULL;
+    }
+
+    region->slots = slots;
+    region->slot_size = sizeof(struct watchdog_shm_slot);
+    region->version = WATCHDOG_SHM_VERSION;
+    region->supervisor_pid = watchdog_process_id();
+    region->wake = 0;
+    for (uint32_t i = 0; i < shm_lanes(slots); i++) {
+        region->deadlines[i] = INT64_MAX;
+    }
+    memset(shm_slot(region, 0), 0, (size_t)slots * sizeof(struct watchdog_shm_slot));
+    WATCHDOG_STORE_RELEASE(&region->magic, WATCHDOG_SHM_MAGIC);
+
+    const char *scan_name;
+    strcpy(shm->name, name);
+    shm->region = region;
+    shm->supervisor = true;
+    shm->callback = callback;
+    shm->user_data = user_data;
+    shm->scan = watchdog_scan_select(&scan_name);
+    shm->next_wakeup = INT64_MAX;
+    shm->liveness_due = shm_now();
+
+    WATCHDOG_LOG_INFO("Shared-memory region created: %u slots, %s deadline scan", slots, (intptr_t)scan_name);
+    return shm;
+}
+
+// Map a region created by a supervisor, to add and feed slots
+z_wdt_shm_t *z_wdt_shm_attach(const char *name) {
+    if (name == NULL || strlen(name) >= Z_WDT_SHM_NAME_MAX) {
+        WATCHDOG_LOG_ERROR("Invalid shared-memory region name");
+        return NULL;
+    }
+
+    struct watchdog_shm *shm = shm_alloc();
+    if (shm == NULL) {
+        WATCHDOG_LOG_ERROR("No free shared-memory handle");
+        return NULL;
+    }
+    struct watchdog_shm_region *region = watchdog_shm_map(name, &shm->size, false);
+    if (region == NULL) {
+        WATCHDOG_LOG_ERROR("No shared-memory region to attach to");
+        shm_free(shm);
+        return NULL;
+    }
+
+    // Reject regions still being set up and those of another build
+    if (shm->size < sizeof(*region) || WATCHDOG_LOAD_ACQUIRE(&region->magic) != WATCHDOG_SHM_MAGIC ||
+        region->version != WATCHDOG_SHM_VERSION || region->slot_size != sizeof(struct watchdog_shm_slot) ||
+        shm->size < shm_size(region->slots)) {
+        WATCHDOG_LOG_ERROR("Shared-memory region has an incompatible layout");
+        watchdog_shm_unmap(region, shm->size);
+        shm_free(shm);
+        return NULL;
+    }
+
+    strcpy(shm->name, name);
+    shm->region = region;
+    return shm;
+}
+
+// Unmap a region; the supervisor also removes its name. Attached workers
+// keep their mapping, but nothing watches their slots any more.
+void z_wdt_shm_close(z_wdt_shm_t *shm) {
+    if (shm == NULL) {
+        return;
+    }
+
+    watchdog_shm_unmap(shm->region, shm->size);
+    if (shm->supervisor) {
+        watchdog_shm_unlink(shm->name);
+        WATCHDOG_LOG_INFO("Shared-memory region closed");
+    }
+    shm_free(shm);
+}
+
+// Claim a free slot for the calling process; its first period starts now
+int z_wdt_shm_add(z_wdt_shm_t *shm, uint32_t reload_period, const char *label) {
+    if (shm == NULL || reload_period == 0) {
+        WATCHDOG_LOG_ERROR("Invalid shared-memory channel parameters");
+        return -1;
+    }
+
+    struct watchdog_shm_region *region = shm->region;
+    for (uint32_t i = 0; i < region->slots; i++) {
+        struct watchdog_shm_slot *slot = shm_slot(region, i);
+        uint32_t generation = WATCHDOG_LOAD(&slot->generation);
+        if (WATCHDOG_GEN_ACTIVE(generation) || WATCHDOG_LOAD_ACQUIRE(&region->deadlines[i]) != INT64_MAX ||
+            !WATCHDOG_CAS(&slot->generation, &generation, generation + 1)) {
+            continue;
+        }
+
+        slot->pid = watchdog_process_id();
+        slot->period_ns = (uint64_t)reload_period * 1000000;
+        memset(slot->label, 0, sizeof(slot->label));
+        if (label != NULL) {
+            strncpy(slot->label, label, sizeof(slot->label) - 1);
+        }
+        WATCHDOG_STORE_RELEASE(&region->deadlines[i], shm_now() + (int64_t)slot->period_ns);
+
+        // The new deadline may come before the supervisor's wakeup
+        WATCHDOG_FETCH_ADD(&region->wake, 1);
+        watchdog_shm_wake(&region->wake);
+
+        int channel_id = watchdog_make_handle(0, i, generation + 1);
+        WATCHDOG_LOG_INFO("Shared-memory channel %d added: period %ums", channel_id, reload_period);
+        return channel_id;
+    }
+
+    WATCHDOG_LOG_ERROR("Shared-memory region full: %u slots", region->slots);
+    return -1;
+}
+
+// Release a slot of the calling process
+int z_wdt_shm_delete(z_wdt_shm_t *shm, int channel_id) {
+    uint32_t generation;
+    struct watchdog_shm_slot *slot = shm_resolve(shm, channel_id, &generation);
+    if (slot == NULL || !WATCHDOG_CAS(&slot->generation, &generation, generation + 1)) {
+        WATCHDOG_LOG_ERROR("Invalid shared-memory channel ID: %d", channel_id);
+        return -1;
+    }
+
+    uint32_t index = (uint32_t)channel_id & WATCHDOG_INDEX_MASK;
+    WATCHDOG_STORE_RELEASE(&shm->region->deadlines[index], INT64_MAX);
+    WATCHDOG_LOG_INFO("Shared-memory channel %d deleted", channel_id);
+    return 0;
+}
+
+// Move a slot's deadline one period past now; a stale handle returns -1
+int z_wdt_shm_feed(z_wdt_shm_t *shm, int channel_id) {
+    uint32_t generation;
+    struct watchdog_shm_slot *slot = shm_resolve(shm, channel_id, &generation);
+    if (slot == NULL) {
+        return -1;
+    }
+
+    return watchdog_shm_feed_slot(shm, (uint32_t)channel_id & WATCHDOG_INDEX_MASK, generation,
+                                  shm_now() + (int64_t)slot->period_ns);
+}
+
+// Only ever move the deadline later, so a retired slot stays parked. As in
+// watchdog_feed_deadline(), the generation is checked after each load of
+// the deadline and before the CAS expecting it: the supervisor and delete
+// retire it before parking the slot, so a worker whose slot was retired
+// and claimed by another process never moves that process's deadline and
+// hides its hang.
+int watchdog_shm_feed_slot(z_wdt_shm_t *shm, uint32_t index, uint32_t generation, int64_t timeout) {
+    struct watchdog_shm_slot *slot = shm_slot(shm->region, index);
+    int64_t *deadline = &shm->region->deadlines[index];
+    int64_t previous = WATCHDOG_LOAD_ACQUIRE(deadline);
+    do {
+        if (WATCHDOG_LOAD_ACQUIRE(&slot->generation) != generation) {
+            return -1;
+        }
+    } while (timeout > previous && !WATCHDOG_CAS(deadline, &previous, timeout));
+
+    return WATCHDOG_LOAD_ACQUIRE(&slot->generation) == generation ? 0 : -1;
+}
+
+// Take a slot from its owner and report it; false if a delete got there first
+static bool shm_retire(struct watchdog_shm *shm, uint32_t index, uint32_t generation, z_wdt_shm_reason reason) {
+    struct watchdog_shm_region *region = shm->region;
+    struct watchdog_shm_slot *slot = shm_slot(region, index);
+    if (!WATCHDOG_CAS(&slot->generation, &generation, generation + 1)) {
+        return false;
+    }
+
+    z_wdt_shm_event event = {
+        .channel_id = watchdog_make_handle(0, index, generation),
+        .pid = slot->pid,
+        .reload_period = (uint32_t)(slot->period_ns / 1000000),
+        .reason = reason,
+    };
+    memcpy(event.label, slot->label, sizeof(event.label));
+    event.label[sizeof(event.label) - 1] = '\0';
+    WATCHDOG_STORE_RELEASE(&region->deadlines[index], INT64_MAX);
+
+    if (reason == Z_WDT_SHM_EXITED) {
+        WATCHDOG_LOG_ERROR("Shared-memory channel %d: process %d exited", event.channel_id, event.pid);
+    } else {
+        WATCHDOG_LOG_ERROR("Shared-memory channel %d timeout! (process %d)", event.channel_id, event.pid);
+    }
+    shm->callback(&event, shm->user_data);
+    return true;
+}
+
+// Retire the claimed slots whose owner has exited
+static int shm_check_owners(struct watchdog_shm *shm) {
+    struct watchdog_shm_region *region = shm->region;
+    int retired = 0;
+
+    for (uint32_t i = 0; i < region->slots; i++) {
+        struct watchdog_shm_slot *slot = shm_slot(region, i);
+        uint32_t generation = WATCHDOG_LOAD_ACQUIRE(&slot->generation);
+        if (!WATCHDOG_GEN_ACTIVE(generation) || WATCHDOG_LOAD_ACQUIRE(&region->deadlines[i]) == INT64_MAX) {
+            continue;
+        }
+        if (!watchdog_process_alive(slot->pid) && shm_retire(shm, i, generation, Z_WDT_SHM_EXITED)) {
+            retired++;
+        }
+    }
+    return retired;
+}
+
+// Retire the slots of one scan block that missed their deadline and
+// return the block's earliest remaining deadline
+static int64_t shm_expire_block(struct watchdog_shm *shm, uint32_t base, int64_t now, int *retired) {
+    struct watchdog_shm_region *region = shm->region;
+    uint64_t expired;
+    int64_t next = shm->scan(&region->deadlines[base], 64, now, &expired);
+    if (expired == 0) {
+        return next;
+    }
+
+    while (expired != 0) {
+        uint32_t index = base + (uint32_t)WATCHDOG_CTZ64(expired);
+        expired &= expired - 1;
+
+        // A feed racing the scan only moves the deadline later
+        uint32_t generation = WATCHDOG_LOAD_ACQUIRE(&shm_slot(region, index)->generation);
+        if (WATCHDOG_GEN_ACTIVE(generation) && WATCHDOG_LOAD(&region->deadlines[index]) <= now &&
+            shm_retire(shm, index, generation, Z_WDT_SHM_TIMEOUT)) {
+            (*retired)++;
+        }
+    }
+    return shm->scan(&region->deadlines[base], 64, now, &expired);
+}
+
+// Supervisor pass: report exited owners (every WATCHDOG_SHM_LIVENESS_MS)
+// and missed deadlines. Returns the number of events, -1 for a worker.
+int z_wdt_shm_process(z_wdt_shm_t *shm) {
+    if (shm == NULL || !shm->supervisor) {
+        return -1;
+    }
+
+    // Adds after this point make the following z_wdt_shm_wait() return early
+    struct watchdog_shm_region *region = shm->region;
+    shm->wake_seen = WATCHDOG_LOAD_ACQUIRE(&region->wake);
+    int64_t now = shm_now();
+    int retired = 0;
+
+    // Owners first, so a crashed process is not reported as a timeout
+    if (now >= shm->liveness_due) {
+        retired += shm_check_owners(shm);
+        shm->liveness_due = now + (int64_t)WATCHDOG_SHM_LIVENESS_MS * 1000000;
+    }
+
+    int64_t next = INT64_MAX;
+    for (uint32_t base = 0; base < region->slots; base += 64) {
+        int64_t block_next = shm_expire_block(shm, base, now, &retired);
+        if (block_next < next) {
+            next = block_next;
+        }
+    }
+    shm->next_wakeup = next < shm->liveness_due ? next : shm->liveness_due;
+    return retired;
+}
+
+// Sleep until the next deadline or liveness check, or until a worker adds
+// a slot. Returns -1 for a worker.
+int z_wdt_shm_wait(z_wdt_shm_t *shm) {
+    if (shm == NULL || !shm->supervisor) {
+        return -1;
+    }
+
+    int64_t now = shm_now();
+    if (shm->next_wakeup > now) {
+        watchdog_shm_wait(&shm->region->wake, shm->wake_seen, (uint64_t)(shm->next_wakeup - now));
+    }
+    return 0;
+}
@@ -0,0 +1,107 @@
+/*
+ * Embedded Watchdog Framework - Instrumentation
+ * Log2 latency histograms and the Prometheus text export of a
+ * z_wdt_stats snapshot. Histograms are updated with relaxed atomics so a
+ * snapshot can be taken from any thread while the timer thread records.
+ */
+
+#include "z_wdt_internal.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+// Bucket of a sample: the bit length of its whole microseconds
+static unsigned stats_bucket(uint64_t ns) {
+    uint64_t us = ns / 1000;
+    return us == 0 ? 0 : 64u - (unsigned)WATCHDOG_CLZ64(us);
+}
+
+// Add one sample to a histogram
+void watchdog_stats_record(z_wdt_histogram *histogram, uint64_t ns) {
+    unsigned bucket = stats_bucket(ns);
+    if (bucket < Z_WDT_STATS_BUCKETS) {
+        WATCHDOG_FETCH_ADD(&histogram->buckets[bucket], 1);
+    }
+    WATCHDOG_FETCH_ADD(&histogram->sum_ns, ns);
+
+    uint64_t max = WATCHDOG_LOAD(&histogram->max_ns);
+    while (ns > max && !WATCHDOG_CAS(&histogram->max_ns, &max, ns)) {
+    }
+
+    // Counted last, so a snapshot never has more samples than bucket counts
+    WATCHDOG_FETCH_ADD(&histogram->count, 1);
+}
+
+// Accumulate a live histogram into a snapshot
+void watchdog_stats_merge(z_wdt_histogram *into, const z_wdt_histogram *histogram) {
+    into->count += WATCHDOG_LOAD(&histogram->count);
+    into->sum_ns += WATCHDOG_LOAD(&histogram->sum_ns);
+    uint64_t max = WATCHDOG_LOAD(&histogram->max_ns);
+    if (max > into->max_ns) {
+        into->max_ns = max;
+    }
+    for (unsigned i = 0; i < Z_WDT_STATS_BUCKETS; i++) {
+        into->buckets[i] += WATCHDOG_LOAD(&histogram->buckets[i]);
+    }
+}
+
+// Append to the export buffer, tracking the full length like snprintf()
+static void stats_append(char *buffer, size_t size, size_t *len, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(*len < size ? buffer + *len : NULL, *len < size ? size - *len : 0, format, args);
+    va_end(args);
+    if (written > 0) {
+        *len += (size_t)written;
+    }
+}
+
+static void stats_counter(char *buffer, size_t size, size_t *len, const char *name, const char *help,
+                          uint64_t value) {
+    stats_append(buffer, size, len, "# HELP %s %s\n# TYPE %s counter\n%s %llu\n",
+                 name, help, name, name, (unsigned long long)value);
+}
+
+// Histogram in seconds with cumulative power-of-two microsecond buckets
+static void stats_histogram(char *buffer, size_t size, size_t *len, const char *name, const char *help,
+                            const z_wdt_histogram *histogram) {
+    stats_append(buffer, size, len, "# HELP %s %s\n# TYPE %s histogram\n", name, help, name);
+
+    uint64_t cumulative = 0;
+    for (unsigned i = 0; i < Z_WDT_STATS_BUCKETS; i++) {
+        cumulative += histogram->buckets[i];
+        stats_append(buffer, size, len, "%s_bucket{le=\"%.6f\"} %llu\n",
+                     name, (double)((uint64_t)1 << i) / 1e6, (unsigned long long)cumulative);
+    }
+    stats_append(buffer, size, len, "%s_bucket{le=\"+Inf\"} %llu\n%s_sum %.9f\n%s_count %llu\n",
+                 name, (unsigned long long)histogram->count,
+                 name, (double)histogram->sum_ns / 1e9,
+                 name, (unsigned long long)histogram->count);
+}
+
+// Render a snapshot in the Prometheus text exposition format. Returns the
+// full length like snprintf(); the output is truncated when it is >= size.
+int z_wdt_stats_prometheus(const z_wdt_stats *stats, char *buffer, size_t size) {
+    if (stats == NULL || (buffer == NULL && size > 0)) {
+        return -1;
+    }
+
+    size_t len = 0;
+    if (size > 0) {
+        buffer[0] = '\0';
+    }
+    stats_counter(buffer, size, &len, "z_wdt_feeds_total", "Successful channel feeds.", stats->feeds);
+    stats_counter(buffer, size, &len, "z_wdt_feed_requeues_total",
+                  "Feeds that had to lock a shard to re-arm the scheduler.", stats->feed_requeues);
+    stats_counter(buffer, size, &len, "z_wdt_wakeups_total", "Timer processing passes.", stats->wakeups);
+    stats_counter(buffer, size, &len, "z_wdt_timeouts_total", "Channels that timed out.", stats->timeouts);
+    stats_histogram(buffer, size, &len, "z_wdt_detection_latency_seconds",
+                    "Delay between a missed deadline and its detection.", &stats->detection_latency);
+    stats_histogram(buffer, size, &len, "z_wdt_callback_duration_seconds",
+                    "Time spent in timeout callbacks on the processing thread.", &stats->callback_duration);
+    stats_histogram(buffer, size, &len, "z_wdt_lock_wait_seconds",
+                    "Time the processing pass waited for a shard mutex.", &stats->lock_wait);
+    stats_histogram(buffer, size, &len, "z_wdt_lock_hold_seconds",
+                    "Time the processing pass held a shard mutex.", &stats->lock_hold);
+
+    return len > INT32_MAX ? -1 : (int)len;
+}
@@ -0,0 +1,167 @@
+/*
+ * Embedded Watchdog Framework - Channel Table
+ * Chunked slot storage with an O(1) FIFO free list. Chunks are allocated
+ * on demand up to max_channels and stay in place until cleanup; with
+ * WATCHDOG_STATIC_CHANNELS all slots come from storage inside the table.
+ * Every chunk is a packed deadline array plus the matching channel array;
+ * the active bitmap covers the whole table and is sized once at init.
+ */
+
+#include "z_wdt_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Reset slots and append them to the free list
+static void table_add_slots(struct watchdog_table *table, uint32_t first, uint32_t count) {
+    for (uint32_t index = first; index < first + count; index++) {
+        struct watchdog_channel *channel = WATCHDOG_SLOT(table, index);
+
+        memset(channel, 0, sizeof(*channel));
+        *WATCHDOG_DEADLINE(table, index) = INT64_MAX;
+        channel->sched_key = INT64_MAX;
+        channel->sched_pos = -1;
+        channel->next_free = -1;
+        channel->group = -1;
+        channel->group_first = -1;
+        channel->group_prev = -1;
+        channel->group_next = -1;
+        channel->progress = -1;
+        watchdog_table_free(table, (int)index);
+    }
+}
+
+// Initialize the table with at least initial_channels slots
+int watchdog_table_init(struct watchdog_table *table, uint32_t max_channels, uint32_t initial_channels) {
+    table->free_head = -1;
+    table->free_tail = -1;
+    table->capacity = 0;
+
+#ifdef WATCHDOG_STATIC_CHANNELS
+    (void)max_channels;
+    (void)initial_channels;
+
+    table->max_channels = WATCHDOG_MAX_CHANNELS;
+    table->chunks = table->static_chunks;
+    table->deadlines = table->static_deadline_chunks;
+    table->active = table->static_active;
+    memset(table->static_active, 0, sizeof(table->static_active));
+    for (uint32_t chunk = 0; chunk < WATCHDOG_CHUNK_COUNT(WATCHDOG_MAX_CHANNELS); chunk++) {
+        table->static_chunks[chunk] = &table->static_channels[chunk * WATCHDOG_CHUNK_SIZE];
+        table->static_deadline_chunks[chunk] = &table->static_deadlines[chunk * WATCHDOG_CHUNK_SIZE];
+    }
+    table->capacity = WATCHDOG_MAX_CHANNELS;
+    table_add_slots(table, 0, WATCHDOG_MAX_CHANNELS);
+    return 0;
+#else
+    if (max_channels == 0 || max_channels > WATCHDOG_TABLE_LIMIT) {
+        return -1;
+    }
+
+    table->max_channels = max_channels;
+    table->chunks = calloc(WATCHDOG_CHUNK_COUNT(max_channels), sizeof(*table->chunks));
+    table->deadlines = calloc(WATCHDOG_CHUNK_COUNT(max_channels), sizeof(*table->deadlines));
+    table->active = calloc(WATCHDOG_BITMAP_WORDS(max_channels), sizeof(*table->active));
+    if (table->chunks == NULL || table->deadlines == NULL || table->active == NULL) {
+        watchdog_table_cleanup(table);
+        return -1;
+    }
+
+    while (table->capacity < initial_channels && table->capacity < max_channels) {
+        if (watchdog_table_grow(table) != 0) {
+            watchdog_table_cleanup(table);
+            return -1;
+        }
+    }
+    return 0;
+#endif
+}
+
+// Release all chunks
+void watchdog_table_cleanup(struct watchdog_table *table) {
+#ifndef WATCHDOG_STATIC_CHANNELS
+    for (uint32_t chunk = 0; chunk < WATCHDOG_CHUNK_COUNT(table->max_channels); chunk++) {
+        if (table->chunks != NULL) {
+            free(table->chunks[chunk]);
+        }
+        if (table->deadlines != NULL) {
+            free(table->deadlines[chunk]);
+        }
+    }
+    free(table->chunks);
+    free(table->deadlines);
+    free(table->active);
+#endif
+    table->chunks = NULL;
+    table->deadlines = NULL;
+    table->active = NULL;
+    table->capacity = 0;
+    table->free_head = -1;
+    table->free_tail = -1;
+}
+
+// Allocate the next chunk of slots (-1 if the table is at its limit)
+int watchdog_table_grow(struct watchdog_table *table) {
+#ifdef WATCHDOG_STATIC_CHANNELS
+    (void)table;
+    return -1;
+#else
+    if (table->capacity >= table->max_channels) {
+        return -1;
+    }
+
+    uint32_t count = table->max_channels - table->capacity;
+    if (count > WATCHDOG_CHUNK_SIZE) {
+        count = WATCHDOG_CHUNK_SIZE;
+    }
+
+    struct watchdog_channel *chunk = malloc(count * sizeof(*chunk));
+    int64_t *deadlines = malloc(count * sizeof(*deadlines));
+    if (chunk == NULL || deadlines == NULL) {
+        free(chunk);
+        free(deadlines);
+        return -1;
+    }
+
+    // Publishing the channel chunk also publishes its deadlines to feeders
+    uint32_t first = table->capacity;
+    table->deadlines[first >> WATCHDOG_CHUNK_BITS] = deadlines;
+    WATCHDOG_STORE_RELEASE(&table->chunks[first >> WATCHDOG_CHUNK_BITS], chunk);
+    table->capacity += count;
+    table_add_slots(table, first, count);
+    return 0;
+#endif
+}
+
+// Take the oldest free slot (-1 if none)
+int watchdog_table_alloc(struct watchdog_table *table) {
+    int index = table->free_head;
+    if (index < 0) {
+        return -1;
+    }
+
+    struct watchdog_channel *channel = WATCHDOG_SLOT(table, index);
+    table->free_head = channel->next_free;
+    if (table->free_head < 0) {
+        table->free_tail = -1;
+    }
+    channel->next_free = -1;
+    table->active[(uint32_t)index / 64] |= (uint64_t)1 << ((uint32_t)index % 64);
+    return index;
+}
+
+// Drop a slot from the active bitmap; it stays allocated until freed
+void watchdog_table_retire(struct watchdog_table *table, int index) {
+    table->active[(uint32_t)index / 64] &= ~((uint64_t)1 << ((uint32_t)index % 64));
+}
+
+// Return a slot to the back of the free list, so reuse is as late as possible
+void watchdog_table_free(struct watchdog_table *table, int index) {
+    watchdog_table_retire(table, index);
+    WATCHDOG_SLOT(table, index)->next_free = -1;
+    if (table->free_tail >= 0) {
+        WATCHDOG_SLOT(table, table->free_tail)->next_free = index;
+    } else {
+        table->free_head = index;
+    }
+    table->free_tail = index;
+}